@@ -0,0 +1,270 @@
+#include <app_configuration/app_configuration.h>
+#include <app_services/app_services.h>
+#include <internal_plugins/internal_plugins.h>
+#include <iostream>
+#include <optional>
+
+// Usage: LMN-3-BatchRenderer [options] <edit file>...
+//
+//   --output <dir>      Where the renders are written, defaults to the
+//                       current directory
+//   --flac              Writes FLAC files instead of WAV files
+//   --jobs <n>          How many edits are rendered at once, defaults to the
+//                       number of cores
+//   --reference <dir>   Compares each render with the file of the same name
+//                       in the directory and fails if they differ
+//   --sample-rate <hz>  The sample rate the edits are rendered at, defaults
+//                       to 44100
+//   --block-size <n>    The block size the edits are rendered with, defaults
+//                       to 512
+//
+// Renders the mixdown of each edit without the GUI, using the same internal
+// plugins, samples and config.yaml as the app. The sample rate and block size
+// don't depend on the machine's audio device, so renders can be compared
+// with references made elsewhere. Prints how many times faster than real
+// time each edit rendered. Exits with 0 if every edit rendered (and matched
+// its reference).
+namespace {
+// Renders that differ by less than this are treated as the same, since
+// plugins with smoothing or noise aren't bit exact between runs
+const float maxReferenceDifferenceDb = -90.0f;
+
+struct EditRender : public app_services::EditRenderJob::Listener {
+    juce::File editFile;
+    juce::File destFile;
+    std::unique_ptr<tracktion::Edit> edit;
+    std::unique_ptr<app_services::EditRenderJob> job;
+    double startTimeMs = 0.0;
+    double renderTimeMs = 0.0;
+    bool started = false;
+    bool finished = false;
+    bool succeeded = false;
+
+    void renderFinished(app_services::EditRenderJob::Result result) override {
+        renderTimeMs = juce::Time::getMillisecondCounterHiRes() - startTimeMs;
+        succeeded = result == app_services::EditRenderJob::Result::SUCCEEDED;
+        finished = true;
+    }
+};
+
+void printUsage() {
+    std::cerr << "Usage: LMN-3-BatchRenderer [--output <dir>] [--flac] "
+                 "[--jobs <n>] [--reference <dir>] [--sample-rate <hz>] "
+                 "[--block-size <n>] <edit file>..."
+              << std::endl;
+}
+
+juce::BigInteger getAllAudioTracks(tracktion::Edit &edit) {
+    // Track indexes are counted from all of the edit's tracks
+    juce::BigInteger tracksToDo;
+    auto tracks = tracktion::getAllTracks(edit);
+    for (auto track : tracktion::getAudioTracks(edit))
+        tracksToDo.setBit(tracks.indexOf(track));
+
+    return tracksToDo;
+}
+
+void startRender(tracktion::Engine &engine, EditRender &render,
+                 const app_services::EditRenderJob::Options &options) {
+    render.started = true;
+    render.edit = app_services::BinaryEditFile::loadEdit(engine,
+                                                         render.editFile);
+    render.job = std::make_unique<app_services::EditRenderJob>(
+        *render.edit, render.destFile, getAllAudioTracks(*render.edit),
+        options);
+    render.job->addListener(&render);
+    render.startTimeMs = juce::Time::getMillisecondCounterHiRes();
+    render.job->start();
+}
+
+// Returns the largest difference between the two files in decibels, or
+// nothing if they couldn't be compared
+std::optional<float> compareFiles(juce::AudioFormatManager &formatManager,
+                                  const juce::File &file,
+                                  const juce::File &referenceFile) {
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    std::unique_ptr<juce::AudioFormatReader> referenceReader(
+        formatManager.createReaderFor(referenceFile));
+    if (reader == nullptr || referenceReader == nullptr ||
+        reader->numChannels != referenceReader->numChannels ||
+        reader->lengthInSamples != referenceReader->lengthInSamples)
+        return std::nullopt;
+
+    const int blockSize = 8192;
+    const auto numChannels = int(reader->numChannels);
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::AudioBuffer<float> referenceBuffer(numChannels, blockSize);
+
+    float maxDifference = 0.0f;
+    for (juce::int64 position = 0; position < reader->lengthInSamples;
+         position += blockSize) {
+        auto numSamples = int(
+            juce::jmin(juce::int64(blockSize),
+                       reader->lengthInSamples - position));
+        reader->read(&buffer, 0, numSamples, position, true, true);
+        referenceReader->read(&referenceBuffer, 0, numSamples, position,
+                              true, true);
+
+        for (int channel = 0; channel < numChannels; channel++) {
+            buffer.addFrom(channel, 0, referenceBuffer, channel, 0, numSamples,
+                           -1.0f);
+            maxDifference = juce::jmax(
+                maxDifference, buffer.getMagnitude(channel, 0, numSamples));
+        }
+    }
+
+    return juce::Decibels::gainToDecibels(maxDifference);
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    juce::File outputDirectory = juce::File::getCurrentWorkingDirectory();
+    juce::File referenceDirectory;
+    juce::String extension = ".wav";
+    int numJobs = juce::SystemStats::getNumCpus();
+    app_services::EditRenderJob::Options renderOptions;
+    juce::Array<juce::File> editFiles;
+
+    for (int i = 1; i < argc; i++) {
+        const juce::String arg(argv[i]);
+        const auto hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue)
+            outputDirectory = juce::File::getCurrentWorkingDirectory()
+                                  .getChildFile(juce::String(argv[++i]));
+        else if (arg == "--reference" && hasValue)
+            referenceDirectory = juce::File::getCurrentWorkingDirectory()
+                                     .getChildFile(juce::String(argv[++i]));
+        else if (arg == "--jobs" && hasValue)
+            numJobs = juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--sample-rate" && hasValue)
+            renderOptions.sampleRate = juce::String(argv[++i]).getDoubleValue();
+        else if (arg == "--block-size" && hasValue)
+            renderOptions.blockSize = juce::String(argv[++i]).getIntValue();
+        else if (arg == "--flac")
+            extension = ".flac";
+        else if (arg.startsWith("--")) {
+            printUsage();
+            return 1;
+        } else
+            editFiles.add(
+                juce::File::getCurrentWorkingDirectory().getChildFile(arg));
+    }
+
+    if (editFiles.isEmpty() || renderOptions.sampleRate <= 0.0 ||
+        renderOptions.blockSize <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    // Edits are loaded and their render tasks created on the message thread
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    // Named after the app so it shares the app's engine settings
+    tracktion::Engine engine{"LMN-3"};
+
+    // The same set up as the app, so edits sound the same as they do there
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+    internal_plugins::ResampledSampleCache::getInstance()->setDirectory(
+        ConfigurationHelpers::getSampleCacheDirectory());
+    internal_plugins::DrumSamplerPlugin::setSampleStorageFormat(
+        internal_plugins::PackedSampleBuffer::getFormatForBitDepth(
+            AppConfig::getCurrent()->sampleBitDepth));
+    ConfigurationHelpers::initSamples(engine);
+
+    // Loads the plugins the app found last time, without scanning again
+    app_services::PluginScanCache pluginScanCache(
+        engine, ConfigurationHelpers::getPluginScanCacheFile(),
+        ConfigurationHelpers::getPluginSearchPath());
+
+    outputDirectory.createDirectory();
+    juce::OwnedArray<EditRender> renders;
+    juce::StringArray destNames;
+    for (const auto &editFile : editFiles) {
+        // The app's edits are all called "edit", so number repeated names
+        auto name = editFile.getFileNameWithoutExtension();
+        auto destName = name;
+        for (int n = 2; destNames.contains(destName); n++)
+            destName = name + " " + juce::String(n);
+        destNames.add(destName);
+
+        auto render = renders.add(new EditRender());
+        render->editFile = editFile;
+        render->destFile = outputDirectory.getChildFile(destName + extension);
+    }
+
+    auto isRunning = [](const EditRender *r) {
+        return r->started && !r->finished;
+    };
+
+    for (;;) {
+        int numRunning = 0;
+        bool allFinished = true;
+        for (auto render : renders) {
+            if (isRunning(render))
+                numRunning++;
+            allFinished = allFinished && render->finished;
+        }
+
+        if (allFinished)
+            break;
+
+        for (auto render : renders) {
+            if (numRunning >= numJobs)
+                break;
+
+            if (!render->started) {
+                startRender(engine, *render, renderOptions);
+                numRunning++;
+            }
+        }
+
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    }
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    bool allSucceeded = true;
+    for (auto render : renders) {
+        render->job->removeListener(render);
+        const auto editName = render->editFile.getFullPathName();
+        if (!render->succeeded) {
+            std::cout << editName << ": render failed" << std::endl;
+            allSucceeded = false;
+            continue;
+        }
+
+        const auto lengthSeconds = render->edit->getLength().inSeconds();
+        const auto realtimeFactor =
+            render->renderTimeMs > 0.0
+                ? lengthSeconds * 1000.0 / render->renderTimeMs
+                : 0.0;
+        std::cout << editName << ": " << juce::String(realtimeFactor, 2)
+                  << "x real time, " << juce::String(lengthSeconds, 1)
+                  << " s in " << juce::String(render->renderTimeMs / 1000.0, 1)
+                  << " s" << std::endl;
+
+        if (referenceDirectory == juce::File())
+            continue;
+
+        auto referenceFile =
+            referenceDirectory.getChildFile(render->destFile.getFileName());
+        auto difference =
+            compareFiles(formatManager, render->destFile, referenceFile);
+        if (!difference.has_value()) {
+            std::cout << "  doesn't match " << referenceFile.getFullPathName()
+                      << std::endl;
+            allSucceeded = false;
+        } else if (*difference > maxReferenceDifferenceDb) {
+            std::cout << "  differs from " << referenceFile.getFullPathName()
+                      << " by " << juce::String(*difference, 1) << " dB"
+                      << std::endl;
+            allSucceeded = false;
+        }
+    }
+
+    // The edits have to go before the engine
+    renders.clear();
+    return allSucceeded ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "Benchmarks.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<juce::int64> numAllocations{0};
+std::atomic<juce::int64> numAllocatedBytes{0};
+
+void *allocate(std::size_t size) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    numAllocatedBytes.fetch_add(juce::int64(size), std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+} // namespace
+
+// Replacing the global operators counts every allocation in the process,
+// including the engine's and the plugins'
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace Benchmarks {
+
+AllocationCount AllocationCount::now() {
+    return {numAllocations.load(), numAllocatedBytes.load()};
+}
+
+AllocationCount
+AllocationCount::operator-(const AllocationCount &other) const {
+    return {numAllocations - other.numAllocations, numBytes - other.numBytes};
+}
+
+juce::int64 getResidentMemoryBytes() {
+#if JUCE_LINUX
+    // The second field is the resident set size in pages
+    auto fields = juce::StringArray::fromTokens(
+        juce::File("/proc/self/statm").loadFileAsString(), false);
+    if (fields.size() > 1)
+        return fields[1].getLargeIntValue() * juce::int64(getpagesize());
+#endif
+    return 0;
+}
+
+void writeNoiseSample(const juce::File &file, double sampleRate,
+                      double lengthSeconds) {
+    const auto numSamples = int(sampleRate * lengthSeconds);
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    juce::Random random;
+    for (int channel = 0; channel < 2; channel++)
+        for (int i = 0; i < numSamples; i++)
+            buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    file.deleteFile();
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+        new juce::FileOutputStream(file), sampleRate, 2, 24, {}, 0));
+    writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+}
+
+juce::StringArray getPluginTypes(int trackIndex, int numEffects) {
+    const juce::StringArray instruments = {
+        tracktion::FourOscPlugin::xmlTypeName,
+        tracktion::SamplerPlugin::xmlTypeName,
+        internal_plugins::DrumSamplerPlugin::xmlTypeName};
+    const juce::StringArray effects = {
+        tracktion::ReverbPlugin::xmlTypeName,
+        tracktion::DelayPlugin::xmlTypeName,
+        tracktion::CompressorPlugin::xmlTypeName};
+
+    juce::StringArray types;
+    types.add(instruments[trackIndex % instruments.size()]);
+    for (int i = 0; i < juce::jmin(numEffects, effects.size()); i++)
+        types.add(effects[i]);
+
+    return types;
+}
+
+void loadSample(tracktion::Plugin &plugin, const juce::File &sampleFile) {
+    auto sampler = dynamic_cast<tracktion::SamplerPlugin *>(&plugin);
+    if (sampler == nullptr)
+        return;
+
+    // The drum sampler wants a sound per note, the sampler is happy with one
+    // sound across the keyboard, but giving both the same map keeps their
+    // costs comparable
+    for (int note = 36; note < 100; note++) {
+        sampler->addSound(sampleFile.getFullPathName(), "noise", 0.0, 0.0,
+                          0.0f);
+        sampler->setSoundParams(sampler->getNumSounds() - 1, note, note, note);
+        sampler->setSoundOpenEnded(sampler->getNumSounds() - 1, true);
+    }
+}
+
+void addDenseMidiClip(tracktion::AudioTrack &track, int numBars) {
+    const auto numBeats = numBars * 4;
+    auto clip = dynamic_cast<tracktion::MidiClip *>(track.insertNewClip(
+        tracktion::TrackItem::Type::midi, "benchmark",
+        tracktion::TimeRange(
+            tracktion::TimePosition(),
+            track.edit.tempoSequence.toTime(
+                tracktion::BeatPosition::fromBeats(numBeats))),
+        nullptr));
+
+    const int chord[] = {0, 4, 7, 11};
+    for (int step = 0; step < numBeats * 4; step++)
+        for (auto interval : chord)
+            clip->getSequence().addNote(
+                48 + (step % 12) + interval,
+                tracktion::BeatPosition::fromBeats(step * 0.25),
+                tracktion::BeatDuration::fromBeats(0.25), 100, 0, nullptr);
+}
+
+std::unique_ptr<tracktion::Edit>
+createSyntheticEdit(tracktion::Engine &engine, const Options &options,
+                    const juce::File &sampleFile) {
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+    edit->ensureNumberOfAudioTracks(options.numTracks);
+
+    auto tracks = tracktion::getAudioTracks(*edit);
+    for (int i = 0; i < tracks.size(); i++) {
+        // Effects go before the volume and level plugins every track has
+        auto &pluginList = tracks[i]->pluginList;
+        for (const auto &type : getPluginTypes(i, options.numEffects)) {
+            auto plugin = edit->getPluginCache().createNewPlugin(type, {});
+            loadSample(*plugin, sampleFile);
+            pluginList.insertPlugin(plugin, pluginList.size() - 2, nullptr);
+        }
+
+        addDenseMidiClip(*tracks[i], options.numBars);
+    }
+
+    // The samplers load their sounds asynchronously
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(1000);
+    return edit;
+}
+
+juce::var createBlockTimings(double seconds, int numBlocks, int blockSize,
+                             double sampleRate,
+                             const AllocationCount &allocations) {
+    const auto blockSeconds = blockSize / sampleRate;
+    const auto secondsPerBlock = seconds / juce::jmax(1, numBlocks);
+
+    auto result = std::make_unique<juce::DynamicObject>();
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("numBlocks", numBlocks);
+    result->setProperty("nsPerBlock", secondsPerBlock * 1.0e9);
+    result->setProperty("cpuPercent", 100.0 * secondsPerBlock / blockSeconds);
+    result->setProperty("allocations", allocations.numAllocations);
+    result->setProperty("allocatedBytes", allocations.numBytes);
+    return result.release();
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,61 @@
+#pragma once
+#include <app_services/app_services.h>
+#include <app_view_models/app_view_models.h>
+#include <internal_plugins/internal_plugins.h>
+
+namespace Benchmarks {
+
+struct Options {
+    juce::Array<int> blockSizes = {64, 128, 256, 512};
+    double sampleRate = 44100.0;
+    int numTracks = 8;
+    // Effects added after each track's instrument, up to 3
+    int numEffects = 3;
+    int numBars = 8;
+};
+
+// Each benchmark returns its results as a JSON object
+juce::var runEditGraphBenchmark(const Options &options);
+juce::var runPluginBenchmark(const Options &options);
+juce::var runDrumSamplerBenchmark(const Options &options);
+juce::var runTrackScrollBenchmark(const Options &options);
+
+// Counts the allocations made with operator new by any thread. Allocations
+// made directly with malloc aren't counted.
+struct AllocationCount {
+    juce::int64 numAllocations = 0;
+    juce::int64 numBytes = 0;
+
+    static AllocationCount now();
+    AllocationCount operator-(const AllocationCount &other) const;
+};
+
+// The process's resident memory, or 0 where it can't be read
+juce::int64 getResidentMemoryBytes();
+
+// Writes a stereo noise sample long enough to play for the given time
+void writeNoiseSample(const juce::File &file, double sampleRate,
+                      double lengthSeconds);
+
+// Returns an instrument followed by effects, cycling through the instruments
+// so the edit has some of each
+juce::StringArray getPluginTypes(int trackIndex, int numEffects);
+
+// Loads the sample into a sampler or drum sampler across its whole range,
+// other plugins are left alone
+void loadSample(tracktion::Plugin &plugin, const juce::File &sampleFile);
+
+// Adds a clip to the track that plays a four note chord on every 16th note
+void addDenseMidiClip(tracktion::AudioTrack &track, int numBars);
+
+// Builds an edit with a track for each instrument and effect combination
+std::unique_ptr<tracktion::Edit>
+createSyntheticEdit(tracktion::Engine &engine, const Options &options,
+                    const juce::File &sampleFile);
+
+// Records a measurement made over a number of blocks
+juce::var createBlockTimings(double seconds, int numBlocks, int blockSize,
+                             double sampleRate,
+                             const AllocationCount &allocations);
+
+} // namespace Benchmarks
@@ -0,0 +1,105 @@
+#include "Benchmarks.h"
+
+namespace Benchmarks {
+
+namespace {
+const int numPads = 64;
+const int firstNote = 30;
+const int numBlocks = 150;
+
+// Returns the average number of nanoseconds spent rendering one voice for
+// one block
+double renderPads(tracktion::Edit &edit, const juce::String &pluginType,
+                  const juce::File &sampleFile, int blockSize,
+                  double sampleRate) {
+    auto plugin = edit.getPluginCache().createNewPlugin(pluginType, {});
+    auto *sampler = dynamic_cast<tracktion::SamplerPlugin *>(plugin.get());
+    jassert(sampler != nullptr);
+
+    for (int i = 0; i < numPads; i++) {
+        sampler->addSound(sampleFile.getFullPathName(), "pad", 0.0, 0.0, 0.0f);
+        sampler->setSoundParams(i, firstNote + i, firstNote + i,
+                                firstNote + i);
+        sampler->setSoundOpenEnded(i, true);
+    }
+
+    // The sounds are loaded asynchronously
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(1000);
+
+    tracktion::PluginInitialisationInfo info;
+    info.sampleRate = sampleRate;
+    info.blockSizeSamples = blockSize;
+    plugin->initialise(info);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    tracktion::MidiMessageArray midi;
+    for (int i = 0; i < numPads; i++)
+        midi.addMidiMessage(juce::MidiMessage::noteOn(1, firstNote + i, 1.0f),
+                            0.0, tracktion::MidiMessageArray::notMPE);
+
+    juce::int64 ticks = 0;
+    for (int block = 0; block < numBlocks; block++) {
+        buffer.clear();
+        tracktion::PluginRenderContext context(
+            &buffer, juce::AudioChannelSet::stereo(), 0, blockSize, &midi,
+            0.0, {}, true, false, false, false);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        plugin->applyToBuffer(context);
+        ticks += juce::Time::getHighResolutionTicks() - start;
+
+        midi.clear();
+    }
+
+    plugin->deinitialise();
+
+    const auto seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+    return seconds * 1.0e9 / (double(numBlocks) * numPads);
+}
+} // namespace
+
+// Renders 64 pads playing at once through the DrumSamplerPlugin and through
+// tracktion's SamplerPlugin (which the drum sampler used to play its sounds
+// with) and reports the time spent per voice
+juce::var runDrumSamplerBenchmark(const Options &options) {
+    tracktion::Engine engine{"Benchmarks"};
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+
+    // Long enough that every pad plays for the whole benchmark
+    const auto maxBlockSize = juce::jmax(256, options.blockSizes.getLast());
+    juce::TemporaryFile sampleFile(".wav");
+    writeNoiseSample(sampleFile.getFile(), options.sampleRate,
+                     maxBlockSize * numBlocks * 2 / options.sampleRate);
+
+    const juce::StringArray types = {
+        tracktion::SamplerPlugin::xmlTypeName,
+        internal_plugins::DrumSamplerPlugin::xmlTypeName};
+
+    auto result = std::make_unique<juce::DynamicObject>();
+    result->setProperty("numPads", numPads);
+    for (const auto &type : types) {
+        juce::Array<juce::var> blockResults;
+        for (auto blockSize : options.blockSizes) {
+            const auto nsPerVoice =
+                renderPads(*edit, type, sampleFile.getFile(), blockSize,
+                           options.sampleRate);
+            const auto blockSeconds = blockSize / options.sampleRate;
+
+            auto blockResult = std::make_unique<juce::DynamicObject>();
+            blockResult->setProperty("blockSize", blockSize);
+            blockResult->setProperty("nsPerVoicePerBlock", nsPerVoice);
+            blockResult->setProperty("cpuPercentPerVoice",
+                                     100.0 * nsPerVoice * 1.0e-9 /
+                                         blockSeconds);
+            blockResults.add(blockResult.release());
+        }
+
+        result->setProperty(type, blockResults);
+    }
+
+    return result.release();
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,92 @@
+#include "Benchmarks.h"
+
+namespace Benchmarks {
+
+// Renders a synthetic edit offline at each block size, the same way the
+// EditRenderJob does, so the whole playback graph is measured without an
+// audio device's timing getting in the way
+juce::var runEditGraphBenchmark(const Options &options) {
+    tracktion::Engine engine{"Benchmarks"};
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+
+    juce::TemporaryFile sampleFile(".wav");
+    writeNoiseSample(sampleFile.getFile(), options.sampleRate, 2.0);
+
+    const auto memoryBefore = getResidentMemoryBytes();
+    auto edit = createSyntheticEdit(engine, options, sampleFile.getFile());
+    const auto editMemoryBytes = getResidentMemoryBytes() - memoryBefore;
+
+    juce::BigInteger tracksToDo;
+    auto tracks = tracktion::getAllTracks(*edit);
+    for (auto track : tracktion::getAudioTracks(*edit))
+        tracksToDo.setBit(tracks.indexOf(track));
+
+    juce::Array<juce::var> blockResults;
+    for (auto blockSize : options.blockSizes) {
+        juce::TemporaryFile destFile(".wav");
+        tracktion::Renderer::Parameters params(*edit);
+        params.destFile = destFile.getFile();
+        params.audioFormat =
+            engine.getAudioFileFormatManager().getWavFormat();
+        params.bitDepth = 24;
+        params.sampleRateForAudio = options.sampleRate;
+        params.blockSizeForAudio = blockSize;
+        params.time = tracktion::TimeRange(
+            tracktion::TimePosition::fromSeconds(0.0), edit->getLength());
+        params.tracksToDo = tracksToDo;
+        params.usePlugins = true;
+        params.useMasterPlugins = true;
+        params.realTimeRender = false;
+
+        // Creating the task builds the playback graph
+        const auto buildStart = juce::Time::getHighResolutionTicks();
+        auto task = std::make_unique<tracktion::Renderer::RenderTask>(
+            "Benchmark", params, nullptr, nullptr);
+        const auto buildSeconds = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - buildStart);
+
+        juce::ThreadPool pool(1);
+        const auto allocationsBefore = AllocationCount::now();
+        const auto start = juce::Time::getHighResolutionTicks();
+        pool.addJob(task.get(), false);
+        while (pool.contains(task.get()))
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start);
+        const auto allocations = AllocationCount::now() - allocationsBefore;
+
+        if (task->errorMessage.isNotEmpty()) {
+            juce::Logger::writeToLog("Benchmark render failed: " +
+                                     task->errorMessage);
+            continue;
+        }
+
+        const auto numSamples = edit->getLength().inSeconds() *
+                                options.sampleRate;
+        const auto numBlocks = int(std::ceil(numSamples / blockSize));
+        auto result = createBlockTimings(seconds, numBlocks, blockSize,
+                                         options.sampleRate, allocations);
+        auto object = result.getDynamicObject();
+        object->setProperty("graphBuildMs", buildSeconds * 1000.0);
+        object->setProperty("realtimeFactor",
+                            seconds > 0.0 ? edit->getLength().inSeconds() /
+                                                seconds
+                                          : 0.0);
+        blockResults.add(result);
+    }
+
+    auto result = std::make_unique<juce::DynamicObject>();
+    result->setProperty("numTracks", options.numTracks);
+    result->setProperty("numPlugins",
+                        options.numTracks *
+                            (1 + juce::jmin(options.numEffects, 3)));
+    result->setProperty("lengthSeconds", edit->getLength().inSeconds());
+    result->setProperty("editMemoryBytes", editMemoryBytes);
+    result->setProperty("residentMemoryBytes", getResidentMemoryBytes());
+    result->setProperty("blockSizes", blockResults);
+    return result.release();
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,129 @@
+#include "Benchmarks.h"
+#include <iostream>
+
+// Usage: LMN-3-Benchmarks [options]
+//
+//   --output <file>         Where the JSON results are written, defaults to
+//                           standard output
+//   --filter <name>         Only runs the benchmarks whose names contain it
+//   --tracks <n>            Tracks in the synthetic edit, defaults to 8
+//   --plugins <n>           Effects after each track's instrument, up to 3
+//   --block-sizes <sizes>   Comma separated block sizes, defaults to
+//                           64,128,256,512
+//
+// Builds synthetic edits and drives the engine offline at fixed block sizes,
+// then reports the time per block, the time each plugin takes, memory use
+// and the allocations made while rendering. Compare the JSON between builds
+// to catch performance regressions.
+namespace {
+struct Benchmark {
+    const char *name;
+    juce::var (*run)(const Benchmarks::Options &);
+};
+
+const Benchmark benchmarks[] = {
+    {"editGraph", Benchmarks::runEditGraphBenchmark},
+    {"plugins", Benchmarks::runPluginBenchmark},
+    {"drumSampler", Benchmarks::runDrumSamplerBenchmark},
+    {"trackScroll", Benchmarks::runTrackScrollBenchmark},
+};
+
+void printUsage() {
+    std::cerr << "Usage: LMN-3-Benchmarks [--output <file>] [--filter <name>] "
+                 "[--tracks <n>] [--plugins <n>] [--block-sizes <sizes>]"
+              << std::endl;
+}
+
+juce::var getSystemInfo() {
+    auto info = std::make_unique<juce::DynamicObject>();
+    info->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    info->setProperty("cpuModel", juce::SystemStats::getCpuModel());
+    info->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    info->setProperty("memoryMb",
+                      juce::SystemStats::getMemorySizeInMegabytes());
+    return info.release();
+}
+
+juce::var getOptions(const Benchmarks::Options &options) {
+    juce::Array<juce::var> blockSizes;
+    for (auto blockSize : options.blockSizes)
+        blockSizes.add(blockSize);
+
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty("sampleRate", options.sampleRate);
+    object->setProperty("numTracks", options.numTracks);
+    object->setProperty("numEffects", options.numEffects);
+    object->setProperty("numBars", options.numBars);
+    object->setProperty("blockSizes", blockSizes);
+    return object.release();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Benchmarks::Options options;
+    juce::File outputFile;
+    juce::String filter;
+
+    for (int i = 1; i < argc; i++) {
+        const juce::String arg(argv[i]);
+        const auto hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue)
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(
+                juce::String(argv[++i]));
+        else if (arg == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (arg == "--tracks" && hasValue)
+            options.numTracks =
+                juce::jmax(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--plugins" && hasValue)
+            options.numEffects =
+                juce::jlimit(0, 3, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--block-sizes" && hasValue) {
+            options.blockSizes.clear();
+            for (const auto &size :
+                 juce::StringArray::fromTokens(argv[++i], ",", {}))
+                if (size.getIntValue() > 0)
+                    options.blockSizes.add(size.getIntValue());
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (options.blockSizes.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+
+    // The plugins load their samples and the renders report back on the
+    // message thread
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto results = std::make_unique<juce::DynamicObject>();
+    for (const auto &benchmark : benchmarks) {
+        if (!juce::String(benchmark.name).containsIgnoreCase(filter))
+            continue;
+
+        std::cerr << "Running " << benchmark.name << std::endl;
+        results->setProperty(benchmark.name, benchmark.run(options));
+    }
+
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty("system", getSystemInfo());
+    report->setProperty("options", getOptions(options));
+    report->setProperty("benchmarks", results.release());
+    const auto json = juce::JSON::toString(juce::var(report.release()));
+
+    if (outputFile == juce::File()) {
+        std::cout << json << std::endl;
+        return 0;
+    }
+
+    if (!outputFile.replaceWithText(json)) {
+        std::cerr << "Unable to write " << outputFile.getFullPathName()
+                  << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
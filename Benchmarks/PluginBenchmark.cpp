@@ -0,0 +1,105 @@
+#include "Benchmarks.h"
+
+namespace Benchmarks {
+
+namespace {
+const int numBlocksPerRun = 500;
+
+// Fills the MIDI buffer with the notes a dense clip would send in one block:
+// a four note chord on every 16th note
+void addBlockNotes(tracktion::MidiMessageArray &midi, int block, int blockSize,
+                   double sampleRate) {
+    const auto samplesPerStep = sampleRate * 60.0 / 120.0 / 4.0;
+    const auto blockStart = double(block) * blockSize;
+    const auto firstStep = int(std::ceil(blockStart / samplesPerStep));
+    const int chord[] = {0, 4, 7, 11};
+
+    for (int step = firstStep; step * samplesPerStep < blockStart + blockSize;
+         step++) {
+        const auto time = (step * samplesPerStep - blockStart) / sampleRate;
+        for (auto interval : chord) {
+            const auto note = 48 + (step % 12) + interval;
+            midi.addMidiMessage(juce::MidiMessage::noteOff(1, note - 1), time,
+                                tracktion::MidiMessageArray::notMPE);
+            midi.addMidiMessage(juce::MidiMessage::noteOn(1, note, 0.8f), time,
+                                tracktion::MidiMessageArray::notMPE);
+        }
+    }
+}
+
+juce::var runPlugin(tracktion::Edit &edit, const juce::String &type,
+                    const juce::File &sampleFile, int blockSize,
+                    double sampleRate) {
+    auto plugin = edit.getPluginCache().createNewPlugin(type, {});
+    loadSample(*plugin, sampleFile);
+    // The samplers load their sounds asynchronously
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(500);
+
+    tracktion::PluginInitialisationInfo info;
+    info.sampleRate = sampleRate;
+    info.blockSizeSamples = blockSize;
+    plugin->initialise(info);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    tracktion::MidiMessageArray midi;
+    juce::int64 ticks = 0;
+    AllocationCount allocations;
+
+    for (int block = 0; block < numBlocksPerRun; block++) {
+        buffer.clear();
+        midi.clear();
+        addBlockNotes(midi, block, blockSize, sampleRate);
+        tracktion::PluginRenderContext context(
+            &buffer, juce::AudioChannelSet::stereo(), 0, blockSize, &midi,
+            0.0, {}, true, false, false, false);
+
+        const auto allocationsBefore = AllocationCount::now();
+        const auto start = juce::Time::getHighResolutionTicks();
+        plugin->applyToBuffer(context);
+        ticks += juce::Time::getHighResolutionTicks() - start;
+
+        const auto blockAllocations =
+            AllocationCount::now() - allocationsBefore;
+        allocations.numAllocations += blockAllocations.numAllocations;
+        allocations.numBytes += blockAllocations.numBytes;
+    }
+
+    plugin->deinitialise();
+    return createBlockTimings(juce::Time::highResolutionTicksToSeconds(ticks),
+                              numBlocksPerRun, blockSize, sampleRate,
+                              allocations);
+}
+} // namespace
+
+// Measures each plugin on its own, driven directly with dense MIDI, so the
+// edit benchmark's total can be broken down per plugin
+juce::var runPluginBenchmark(const Options &options) {
+    tracktion::Engine engine{"Benchmarks"};
+    engine.getPluginManager()
+        .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+
+    juce::TemporaryFile sampleFile(".wav");
+    writeNoiseSample(sampleFile.getFile(), options.sampleRate, 2.0);
+
+    // The instruments are at the start of each track's list, so the first
+    // three tracks cover every type
+    juce::StringArray types;
+    for (int i = 0; i < 3; i++)
+        types.addArray(getPluginTypes(i, 3));
+    types.removeDuplicates(false);
+
+    auto result = std::make_unique<juce::DynamicObject>();
+    for (const auto &type : types) {
+        juce::Array<juce::var> blockResults;
+        for (auto blockSize : options.blockSizes)
+            blockResults.add(runPlugin(*edit, type, sampleFile.getFile(),
+                                       blockSize, options.sampleRate));
+
+        result->setProperty(type, blockResults);
+    }
+
+    return result.release();
+}
+
+} // namespace Benchmarks
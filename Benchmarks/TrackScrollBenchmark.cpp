@@ -0,0 +1,78 @@
+#include "Benchmarks.h"
+
+namespace Benchmarks {
+
+namespace {
+const int numSweeps = 10;
+
+struct TrackViewModels {
+    explicit TrackViewModels(tracktion::AudioTrack::Ptr track)
+        : plugins(track), modifiers(track), sequencers(track) {}
+
+    app_view_models::TrackPluginsListViewModel plugins;
+    app_view_models::TrackModifiersListViewModel modifiers;
+    app_view_models::AvailableSequencersListViewModel sequencers;
+};
+
+// Returns the track selected at each step of sweeping up and down the
+// track list
+juce::Array<int> getScrollSteps(int numTracks) {
+    juce::Array<int> steps;
+    for (int sweep = 0; sweep < numSweeps; sweep++) {
+        for (int i = 0; i < numTracks; i++)
+            steps.add(sweep % 2 == 0 ? i : numTracks - 1 - i);
+    }
+
+    return steps;
+}
+
+// Returns the average number of microseconds per step
+template <typename GetViewModels>
+double scroll(const juce::Array<tracktion::AudioTrack *> &tracks,
+              GetViewModels getViewModels) {
+    const auto steps = getScrollSteps(tracks.size());
+    const auto start = juce::Time::getHighResolutionTicks();
+    for (auto trackIndex : steps)
+        getViewModels(tracks[trackIndex]);
+
+    const auto ticks = juce::Time::getHighResolutionTicks() - start;
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6 /
+           steps.size();
+}
+
+double scrollWithCache(const juce::Array<tracktion::AudioTrack *> &tracks,
+                       size_t capacity) {
+    app_services::LruCache<juce::uint64, TrackViewModels> cache(capacity);
+    return scroll(tracks, [&cache](tracktion::AudioTrack *track) {
+        const auto trackID = track->itemID.getRawID();
+        if (cache.find(trackID) == nullptr)
+            cache.insert(trackID, std::make_unique<TrackViewModels>(track));
+    });
+}
+} // namespace
+
+// Scrolls the selected track back and forth across 32 tracks and reports how
+// long each step takes to get the per-track tab view models for the newly
+// selected track, either by building them from scratch (which the edit tab
+// bar used to do on every selection) or by keeping them in an LRU cache like
+// the edit tab bar now does
+juce::var runTrackScrollBenchmark(const Options &) {
+    const int numTracks = 32;
+    tracktion::Engine engine{"Benchmarks"};
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+    edit->ensureNumberOfAudioTracks(numTracks);
+    const auto tracks = tracktion::getAudioTracks(*edit);
+
+    auto result = std::make_unique<juce::DynamicObject>();
+    result->setProperty("numTracks", numTracks);
+    result->setProperty("rebuiltUsPerStep",
+                        scroll(tracks, [](tracktion::AudioTrack *track) {
+                            TrackViewModels viewModels(track);
+                        }));
+    result->setProperty("cached16UsPerStep", scrollWithCache(tracks, 16));
+    result->setProperty("cached32UsPerStep",
+                        scrollWithCache(tracks, numTracks));
+    return result.release();
+}
+
+} // namespace Benchmarks
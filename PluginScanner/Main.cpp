@@ -0,0 +1,46 @@
+#include <iostream>
+#include <juce_audio_processors/juce_audio_processors.h>
+
+// Usage: LMN-3-PluginScanner <format name> <plugin file or identifier>
+//
+// Writes the description of each plugin found in the file to stdout as a
+// single line of XML, as soon as it has been found, and then a line saying
+// "finished" so the app can tell the scan didn't crash. Exits with 0 if any
+// plugins were found.
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: LMN-3-PluginScanner <format> <file>" << std::endl;
+        return 1;
+    }
+
+    // Some plugins expect a message manager to exist while they are loaded
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::AudioPluginFormatManager formatManager;
+    formatManager.addDefaultFormats();
+
+    const juce::String formatName(argv[1]);
+    const juce::String fileOrIdentifier(argv[2]);
+
+    for (auto *format : formatManager.getFormats()) {
+        if (format->getName() != formatName)
+            continue;
+
+        juce::OwnedArray<juce::PluginDescription> types;
+        format->findAllTypesForFile(types, fileOrIdentifier);
+
+        for (auto *type : types)
+            if (auto xml = type->createXml())
+                std::cout << xml->toString(juce::XmlElement::TextFormat()
+                                               .singleLine()
+                                               .withoutHeader())
+                          << std::endl;
+
+        // This has to match ChildProcessPluginScanner::finishedLine
+        std::cout << "finished" << std::endl;
+        return types.isEmpty() ? 2 : 0;
+    }
+
+    std::cerr << "Unknown plugin format " << formatName << std::endl;
+    return 1;
+}
@@ -11,7 +11,9 @@
 
 #include "AppLookAndFeel.h"
 
-class GuiAppApplication : public juce::JUCEApplication {
+class GuiAppApplication : public juce::JUCEApplication,
+                          private app_services::DirectoryWatcher::Listener,
+                          private AppConfig::Listener {
   public:
     GuiAppApplication()
         : splash(new juce::SplashScreen(
@@ -32,27 +34,66 @@ class GuiAppApplication : public juce::JUCEApplication {
     void initialise(const juce::String &commandLine) override {
         // This method is where you should put your application's initialisation
         // code..
-        juce::ignoreUnused(commandLine);
-
         // Create application wide file logger
         logger = std::unique_ptr<juce::FileLogger>(
             juce::FileLogger::createDefaultAppLogger(
                 getApplicationName(), "log.txt",
                 getApplicationName() + " Logs"));
-        juce::Logger::setCurrentLogger(logger.get());
 
+        // config.yaml is only parsed once, and again whenever it changes
+        auto appConfig = AppConfig::getCurrent();
+        if (appConfig->loggingEnabled)
+            juce::Logger::setCurrentLogger(logger.get());
+
+        if (auto engineBehaviour =
+                dynamic_cast<app_services::AppEngineBehaviour *>(
+                    &engine.getEngineBehaviour()))
+            engineBehaviour->setNumAudioThreads(appConfig->audioThreads);
+
+        startupProfiler.startPhase("Load plugin scan cache");
         // we need to add the app internal plugins to the cache:
         engine.getPluginManager()
             .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+        internal_plugins::ResampledSampleCache::getInstance()->setDirectory(
+            ConfigurationHelpers::getSampleCacheDirectory());
+
+        // Load the plugins found last time and look for changes in the
+        // background so the plugin browser never has to wait for a scan
+        pluginScanCache = std::make_unique<app_services::PluginScanCache>(
+            engine, ConfigurationHelpers::getPluginScanCacheFile(),
+            ConfigurationHelpers::getPluginSearchPath());
 
         auto userAppDataDirectory = juce::File::getSpecialLocation(
             juce::File::userApplicationDataDirectory);
+        internal_plugins::DrumSamplerPlugin::setSampleStorageFormat(
+            internal_plugins::PackedSampleBuffer::getFormatForBitDepth(
+                appConfig->sampleBitDepth));
+
+        startupProfiler.startPhase("Copy samples");
+        // Sampler plugins in the edit refer to the copied samples, so they
+        // are copied before the edit is loaded
+        ConfigurationHelpers::initSamples(engine);
+
+        startupProfiler.startPhase("Load edit");
         juce::File editFile =
             userAppDataDirectory.getChildFile(getApplicationName())
                 .getChildFile("edit");
+        auto journalDirectory = ConfigurationHelpers::getEditJournalDirectory();
+        int numRecoveredChanges = 0;
         if (editFile.existsAsFile()) {
-            edit = tracktion::loadEditFromFile(engine, editFile);
+            edit = app_services::BinaryEditFile::loadEdit(engine, editFile);
+
+            // Anything changed since the last save was journaled, so put those
+            // changes back in case the app didn't exit cleanly
+            numRecoveredChanges = app_services::EditJournal::replay(
+                edit->state, journalDirectory);
+            if (numRecoveredChanges > 0)
+                juce::Logger::writeToLog(
+                    "Recovered " + juce::String(numRecoveredChanges) +
+                    " unsaved changes from the edit journal");
         } else {
+            // Journals left behind can't belong to a brand new edit
+            journalDirectory.deleteRecursively();
             editFile.create();
             edit = tracktion::createEmptyEdit(engine, editFile);
             edit->ensureNumberOfAudioTracks(8);
@@ -61,8 +102,6 @@ class GuiAppApplication : public juce::JUCEApplication {
                 track->setColour(appLookAndFeel.getRandomColour());
         }
 
-        ConfigurationHelpers::initSamples(engine);
-
         // The master track does not have the default  plugins added to it by
         // default
         for (auto track : tracktion::getTopLevelTracks(*edit)) {
@@ -80,19 +119,109 @@ class GuiAppApplication : public juce::JUCEApplication {
         edit->clickTrackEnabled.setValue(true, nullptr);
         edit->setCountInMode(tracktion::Edit::CountIn::oneBar);
 
+        startupProfiler.startPhase("Create services");
+        // Saves are written in the background so stopping the transport
+        // doesn't hold up the UI
+        const auto editFormat =
+            appConfig->useBinaryEditFormat
+                ? app_services::EditSaver::Format::BINARY
+                : app_services::EditSaver::Format::XML;
+        editSaver = std::make_unique<app_services::EditSaver>(*edit, editFile,
+                                                              editFormat);
+        editJournal = std::make_unique<app_services::EditJournal>(
+            *edit, *editSaver, journalDirectory);
+        if (numRecoveredChanges > 0)
+            editJournal->compact();
+
         midiCommandManager =
             std::make_unique<app_services::MidiCommandManager>(engine);
 
+        // The warm pool size is given in megabytes
+        const auto warmPoolSize = juce::jmax(0, appConfig->pluginWarmPoolSize);
+        pluginWarmPool = std::make_unique<app_services::PluginWarmPool>(
+            *edit, size_t(warmPoolSize) * 1024 * 1024);
+
         if (auto uiBehavior =
                 dynamic_cast<ExtendedUIBehaviour *>(&engine.getUIBehaviour())) {
             uiBehavior->setEdit(edit.get());
             uiBehavior->setMidiCommandManager(midiCommandManager.get());
+            uiBehavior->setPluginWarmPool(pluginWarmPool.get());
+            uiBehavior->setEditSaver(editSaver.get());
+            uiBehavior->setDeferredTaskQueue(&deferredTaskQueue);
+            uiBehavior->onSampleLibraryIndexNeeded = [this]() {
+                // Starts indexing if that hasn't happened yet
+                deferredTaskQueue.runNow(
+                    ExtendedUIBehaviour::sampleLibraryTaskName);
+            };
         }
 
+        startupProfiler.startPhase("Initialise audio devices");
+        threadPlacement = std::make_unique<app_services::ThreadPlacement>(
+            engine.getDeviceManager().deviceManager);
+        applyThreadPlacement(*appConfig);
+        if (auto engineBehaviour =
+                dynamic_cast<app_services::AppEngineBehaviour *>(
+                    &engine.getEngineBehaviour()))
+            engineBehaviour->setThreadPlacement(threadPlacement.get());
         initialiseAudioDevices();
+        // Starts the graph's worker threads on the audio cores
+        app_services::AppEngineBehaviour::reallocateContext(*edit);
+        audioCallbackMonitor =
+            std::make_unique<app_services::AudioCallbackMonitor>(
+                engine.getDeviceManager().deviceManager);
+        if (auto uiBehavior =
+                dynamic_cast<ExtendedUIBehaviour *>(&engine.getUIBehaviour()))
+            uiBehavior->setAudioCallbackMonitor(audioCallbackMonitor.get());
+        updateBufferSizeGovernor(AppConfig::getCurrent()->adaptiveBufferSize);
+
+        // The first task runs once the window has had a chance to paint, so
+        // the splash screen can go. It is queued before the window is made so
+        // the tasks its views queue up don't hold it back.
+        deferredTaskQueue.addTask("Close splash screen", [this]() {
+            splash->deleteAfterDelay(juce::RelativeTime(), false);
+        });
+
+        startupProfiler.startPhase("Create main window");
         mainWindow = std::make_unique<MainWindow>(getApplicationName(), engine,
                                                   *edit, *midiCommandManager);
-        splash->deleteAfterDelay(juce::RelativeTime::seconds(4.25), false);
+        startupProfiler.mark("UI ready");
+
+        addDeferredStartupTasks();
+        if (commandLine.contains("--benchmark"))
+            deferredTaskQueue.addTask("Run benchmark",
+                                      [this]() { startBenchmark(); });
+
+        configWatcher = std::make_unique<app_services::DirectoryWatcher>(
+            ConfigurationHelpers::getConfigFile().getParentDirectory());
+        configWatcher->addListener(this);
+        AppConfig::addListener(this);
+    }
+
+    void addDeferredStartupTasks() {
+        deferredTaskQueue.addTask(ExtendedUIBehaviour::sampleLibraryTaskName,
+                                  [this]() { startIndexingSampleLibrary(); });
+
+        // The plugins found last time are already loaded, this only looks
+        // for changes
+        deferredTaskQueue.addTask("Start plugin scan",
+                                  [this]() { pluginScanCache->startScan(); });
+
+        deferredTaskQueue.onAllTasksFinished = [this]() {
+            startupProfiler.mark("Startup finished");
+            startupProfiler.writeToLog();
+        };
+    }
+
+    // Indexing reads the header of every sample, so the samples are scanned
+    // on a background thread. The index is usable straight away and fills in
+    // once the scan has finished.
+    void startIndexingSampleLibrary() {
+        sampleLibraryIndex = std::make_unique<app_services::SampleLibraryIndex>(
+            ConfigurationHelpers::getSamplesDirectory(),
+            ConfigurationHelpers::getTempSamplesDirectory(engine), true);
+        if (auto uiBehavior =
+                dynamic_cast<ExtendedUIBehaviour *>(&engine.getUIBehaviour()))
+            uiBehavior->setSampleLibraryIndex(sampleLibraryIndex.get());
     }
 
     void initialiseAudioDevices() {
@@ -103,10 +232,155 @@ class GuiAppApplication : public juce::JUCEApplication {
             juce::Logger::writeToLog(
                 "Attempt to initialise default devices failed!");
         }
+
+        applyBufferSize(AppConfig::getCurrent()->bufferSize);
+    }
+
+    void applyBufferSize(int bufferSize) {
+        auto &deviceManager = engine.getDeviceManager().deviceManager;
+        auto setup = deviceManager.getAudioDeviceSetup();
+        if (bufferSize <= 0 || setup.bufferSize == bufferSize)
+            return;
+
+        setup.bufferSize = bufferSize;
+        auto error = deviceManager.setAudioDeviceSetup(setup, true);
+        if (error.isNotEmpty())
+            juce::Logger::writeToLog("Unable to set buffer size to " +
+                                     juce::String(bufferSize) + ": " + error);
+    }
+
+    void applyThreadPlacement(const AppConfig &config) {
+        threadPlacement->setAudioCores(
+            app_services::ThreadPlacement::getCoreMask(config.audioCores));
+        threadPlacement->setGuiCores(
+            app_services::ThreadPlacement::getCoreMask(config.guiCores));
+        threadPlacement->setRealtimeAudio(config.realtimeAudio);
+    }
+
+    // Plays the edit with each number of audio threads, writes the results
+    // next to config.yaml and quits
+    void startBenchmark() {
+        // The buffer size has to stay put for the results to be comparable
+        bufferSizeGovernor = nullptr;
+
+        juce::Array<int> threadCounts;
+        for (int i = 1; i <= juce::SystemStats::getNumCpus(); i++)
+            threadCounts.add(i);
+
+        // Each result line records the placement from config.yaml, so runs
+        // with different audio-cores, gui-cores and realtime-audio settings
+        // can be compared
+        graphBenchmark = std::make_unique<app_services::GraphBenchmark>(
+            *edit, *audioCallbackMonitor, threadCounts, 10000,
+            threadPlacement.get());
+        graphBenchmark->onFinished = [this]() {
+            auto report = graphBenchmark->createReport();
+            juce::Logger::writeToLog(report);
+            ConfigurationHelpers::getConfigFile()
+                .getParentDirectory()
+                .getChildFile("benchmark.txt")
+                .replaceWithText(report);
+            quit();
+        };
+        graphBenchmark->start();
+    }
+
+    void updateBufferSizeGovernor(bool adaptiveBufferSize) {
+        if (!adaptiveBufferSize) {
+            bufferSizeGovernor = nullptr;
+        } else if (bufferSizeGovernor == nullptr) {
+            bufferSizeGovernor =
+                std::make_unique<app_services::BufferSizeGovernor>(
+                    *edit, engine.getDeviceManager().deviceManager,
+                    *audioCallbackMonitor);
+        }
+    }
+
+    void logChangeBusMetrics() {
+        auto *bus = app_view_models::ChangeBus::getInstanceWithoutCreating();
+        if (bus == nullptr)
+            return;
+
+        // How many view models each user action ends up updating
+        const auto metrics = bus->getMetrics();
+        juce::Logger::writeToLog(
+            "View model updates: " + juce::String(metrics.numMarks) +
+            " marks, " + juce::String(metrics.numPasses) + " passes, " +
+            juce::String(metrics.getAverageFanOut(), 1) +
+            " view models per pass on average, " +
+            juce::String(metrics.maxFanOut) + " at most");
+    }
+
+    void fileChanged(const juce::File &file,
+                     app_services::DirectoryWatcher::FileEvent) override {
+        if (file != ConfigurationHelpers::getConfigFile())
+            return;
+
+        // A config that can't be parsed leaves the current one in place
+        if (auto config = AppConfig::load(file)) {
+            juce::Logger::writeToLog("Reloaded " + file.getFullPathName());
+            AppConfig::setCurrent(config);
+        }
+    }
+
+    void appConfigChanged(const AppConfig &oldConfig,
+                          const AppConfig &newConfig) override {
+        if (newConfig.loggingEnabled != oldConfig.loggingEnabled)
+            juce::Logger::setCurrentLogger(
+                newConfig.loggingEnabled ? logger.get() : nullptr);
+
+        if (newConfig.bufferSize != oldConfig.bufferSize)
+            applyBufferSize(newConfig.bufferSize);
+
+        if (newConfig.adaptiveBufferSize != oldConfig.adaptiveBufferSize)
+            updateBufferSizeGovernor(newConfig.adaptiveBufferSize);
+
+        const auto placementChanged =
+            newConfig.audioCores != oldConfig.audioCores ||
+            newConfig.guiCores != oldConfig.guiCores ||
+            newConfig.realtimeAudio != oldConfig.realtimeAudio;
+        if (placementChanged)
+            applyThreadPlacement(newConfig);
+
+        if (newConfig.audioThreads != oldConfig.audioThreads ||
+            placementChanged) {
+            if (auto engineBehaviour =
+                    dynamic_cast<app_services::AppEngineBehaviour *>(
+                        &engine.getEngineBehaviour())) {
+                engineBehaviour->setNumAudioThreads(newConfig.audioThreads);
+                if (!engineBehaviour->reallocateContextWhenStopped(*edit))
+                    juce::Logger::writeToLog("The audio threads will change "
+                                             "once playback stops");
+            }
+        }
     }
 
     void shutdown() override {
         // Add your application's shutdown code here..
+        AppConfig::removeListener(this);
+        // The views hold on to the services below, so they go first
+        mainWindow = nullptr; // (deletes our window)
+        // Stops the sample library scan if it is still running
+        sampleLibraryIndex = nullptr;
+        configWatcher = nullptr;
+        graphBenchmark = nullptr;
+        bufferSizeGovernor = nullptr;
+        // The views, benchmark and governor listen to the monitor, so it goes
+        // once they have
+        audioCallbackMonitor = nullptr;
+        if (auto engineBehaviour =
+                dynamic_cast<app_services::AppEngineBehaviour *>(
+                    &engine.getEngineBehaviour()))
+            engineBehaviour->setThreadPlacement(nullptr);
+        threadPlacement = nullptr;
+        pluginScanCache = nullptr;
+        pluginWarmPool = nullptr;
+        // A clean exit leaves a full save behind rather than a journal
+        if (editJournal != nullptr)
+            editJournal->close();
+        editJournal = nullptr;
+        // Waits for any save that is still being written
+        editSaver = nullptr;
 
         bool success = edit->engine.getTemporaryFileManager()
                            .getTempDirectory()
@@ -117,8 +391,8 @@ class GuiAppApplication : public juce::JUCEApplication {
                                          .getTempDirectory()
                                          .getFullPathName());
         }
+        logChangeBusMetrics();
         juce::Logger::setCurrentLogger(nullptr);
-        mainWindow = nullptr; // (deletes our window)
     }
 
     void systemRequestedQuit() override {
@@ -147,12 +421,7 @@ class GuiAppApplication : public juce::JUCEApplication {
                       .findColour(ResizableWindow::backgroundColourId),
                   DocumentWindow::allButtons),
               engine(e), edit(ed), midiCommandManager(mcm) {
-            auto userAppDataDirectory = juce::File::getSpecialLocation(
-                juce::File::userApplicationDataDirectory);
-            auto configFile =
-                userAppDataDirectory.getChildFile(name).getChildFile(
-                    "config.yaml");
-            if (ConfigurationHelpers::getShowTitleBar(configFile))
+            if (AppConfig::getCurrent()->showTitleBar)
                 setUsingNativeTitleBar(true);
             else {
                 setUsingNativeTitleBar(false);
@@ -203,11 +472,29 @@ class GuiAppApplication : public juce::JUCEApplication {
 
   private:
     std::unique_ptr<juce::FileLogger> logger;
+    // Created first so it times as much of startup as possible
+    app_services::StartupProfiler startupProfiler;
+    app_services::DeferredTaskQueue deferredTaskQueue{&startupProfiler};
+    // Declared before the main window so it outlives any views listening to it
+    std::unique_ptr<app_services::SampleLibraryIndex> sampleLibraryIndex;
     std::unique_ptr<MainWindow> mainWindow;
-    tracktion::Engine engine{getApplicationName(),
-                             std::make_unique<ExtendedUIBehaviour>(), nullptr};
+    tracktion::Engine engine{
+        getApplicationName(), std::make_unique<ExtendedUIBehaviour>(),
+        std::make_unique<app_services::AppEngineBehaviour>()};
+    std::unique_ptr<app_services::PluginScanCache> pluginScanCache;
     std::unique_ptr<tracktion::Edit> edit;
+    std::unique_ptr<app_services::EditSaver> editSaver;
+    // Listens to the edit saver, so it is declared after it
+    std::unique_ptr<app_services::EditJournal> editJournal;
     std::unique_ptr<app_services::MidiCommandManager> midiCommandManager;
+    // Holds plugins created in the edit, so it is declared after it
+    std::unique_ptr<app_services::PluginWarmPool> pluginWarmPool;
+    std::unique_ptr<app_services::DirectoryWatcher> configWatcher;
+    std::unique_ptr<app_services::AudioCallbackMonitor> audioCallbackMonitor;
+    // Listens to the monitor, so it is declared after it
+    std::unique_ptr<app_services::BufferSizeGovernor> bufferSizeGovernor;
+    std::unique_ptr<app_services::GraphBenchmark> graphBenchmark;
+    std::unique_ptr<app_services::ThreadPlacement> threadPlacement;
     AppLookAndFeel appLookAndFeel;
     juce::SplashScreen *splash;
 };
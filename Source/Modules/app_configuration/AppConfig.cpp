@@ -0,0 +1,129 @@
+#include "AppConfig.h"
+#include <mutex>
+#include <yaml-cpp/yaml.h>
+
+std::shared_ptr<const AppConfig> AppConfig::currentConfig;
+
+namespace {
+std::shared_ptr<const AppConfig> fromNode(const YAML::Node &rootNode) {
+    auto appConfig = std::make_shared<AppConfig>();
+
+    YAML::Node config = rootNode["config"];
+    if (!config)
+        return appConfig;
+
+    if (config["show-title-bar"])
+        appConfig->showTitleBar = config["show-title-bar"].as<bool>();
+
+    if (auto sizeConfig = config["size"]) {
+        if (sizeConfig["width"])
+            appConfig->width = sizeConfig["width"].as<double>();
+        if (sizeConfig["height"])
+            appConfig->height = sizeConfig["height"].as<double>();
+    }
+
+    if (config["sample-bit-depth"])
+        appConfig->sampleBitDepth = config["sample-bit-depth"].as<int>();
+
+    if (config["plugin-warm-pool-size"])
+        appConfig->pluginWarmPoolSize =
+            config["plugin-warm-pool-size"].as<int>();
+
+    if (config["edit-format"])
+        appConfig->useBinaryEditFormat =
+            config["edit-format"].as<std::string>() == "binary";
+
+    if (auto coloursNode = config["colours"])
+        for (const auto &colour : coloursNode)
+            appConfig->colours[colour.first.as<std::string>()] =
+                juce::Colour::fromString(colour.second.as<std::string>());
+
+    if (config["buffer-size"])
+        appConfig->bufferSize = config["buffer-size"].as<int>();
+
+    if (config["adaptive-buffer-size"])
+        appConfig->adaptiveBufferSize =
+            config["adaptive-buffer-size"].as<bool>();
+
+    if (config["audio-threads"])
+        appConfig->audioThreads = config["audio-threads"].as<int>();
+
+    if (config["audio-cores"])
+        for (auto core : config["audio-cores"].as<std::vector<int>>())
+            appConfig->audioCores.add(core);
+
+    if (config["gui-cores"])
+        for (auto core : config["gui-cores"].as<std::vector<int>>())
+            appConfig->guiCores.add(core);
+
+    if (config["realtime-audio"])
+        appConfig->realtimeAudio = config["realtime-audio"].as<bool>();
+
+    if (config["meter-refresh-rate"])
+        appConfig->meterRefreshRate =
+            juce::jlimit(1, 120, config["meter-refresh-rate"].as<int>());
+
+    if (config["log-level"])
+        appConfig->loggingEnabled =
+            config["log-level"].as<std::string>() != "off";
+
+    return appConfig;
+}
+} // namespace
+
+std::shared_ptr<const AppConfig>
+AppConfig::load(const juce::File &configFile) {
+    if (!configFile.existsAsFile())
+        return std::make_shared<AppConfig>();
+
+    return parse(configFile.loadFileAsString());
+}
+
+std::shared_ptr<const AppConfig> AppConfig::parse(const juce::String &yaml) {
+    try {
+        return fromNode(YAML::Load(yaml.toStdString()));
+    } catch (const YAML::Exception &e) {
+        juce::Logger::writeToLog("Unable to parse config: " +
+                                 juce::String(e.what()));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<const AppConfig> AppConfig::getCurrent() {
+    if (auto config = std::atomic_load(&currentConfig))
+        return config;
+
+    // The first caller loads the config file, everyone after that shares it
+    static std::once_flag loadFlag;
+    std::call_once(loadFlag, []() {
+        auto config = load(ConfigurationHelpers::getConfigFile());
+        if (config == nullptr)
+            config = std::make_shared<const AppConfig>();
+
+        std::shared_ptr<const AppConfig> noConfig;
+        std::atomic_compare_exchange_strong(&currentConfig, &noConfig,
+                                            config);
+    });
+
+    return std::atomic_load(&currentConfig);
+}
+
+void AppConfig::setCurrent(std::shared_ptr<const AppConfig> config) {
+    if (config == nullptr)
+        return;
+
+    auto oldConfig = getCurrent();
+    std::atomic_store(&currentConfig, config);
+    getListeners().call([&oldConfig, &config](Listener &l) {
+        l.appConfigChanged(*oldConfig, *config);
+    });
+}
+
+void AppConfig::addListener(Listener *l) { getListeners().add(l); }
+
+void AppConfig::removeListener(Listener *l) { getListeners().remove(l); }
+
+juce::ListenerList<AppConfig::Listener> &AppConfig::getListeners() {
+    static juce::ListenerList<Listener> listeners;
+    return listeners;
+}
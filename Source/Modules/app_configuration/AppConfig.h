@@ -0,0 +1,59 @@
+#pragma once
+#include <juce_graphics/juce_graphics.h>
+#include <map>
+#include <memory>
+
+// The settings from config.yaml. The file is parsed once into an immutable
+// AppConfig which is then shared, rather than each setting reading the file
+// again. When the file changes a new AppConfig replaces the current one and
+// listeners are told, so settings that can be changed while the app is
+// running take effect straight away. The rest are only read at startup.
+class AppConfig {
+  public:
+    bool showTitleBar = true;
+    double width = 800;
+    double height = 480;
+    int sampleBitDepth = 32;
+    int pluginWarmPoolSize = 0;
+    bool useBinaryEditFormat = false;
+    std::map<juce::String, juce::Colour> colours;
+
+    // These can be changed while the app is running. A buffer size or number
+    // of audio threads of 0 leaves the default in place.
+    int bufferSize = 0;
+    // Lets the buffer size follow the load, starting from bufferSize
+    bool adaptiveBufferSize = false;
+    int audioThreads = 0;
+    // Cores the audio and GUI threads run on, empty for any core
+    juce::Array<int> audioCores;
+    juce::Array<int> guiCores;
+    bool realtimeAudio = true;
+    int meterRefreshRate = 120;
+    bool loggingEnabled = true;
+
+    // Returns nullptr if the file exists but couldn't be parsed
+    static std::shared_ptr<const AppConfig> load(const juce::File &configFile);
+    static std::shared_ptr<const AppConfig> parse(const juce::String &yaml);
+
+    // The current config is shared between threads, so it is swapped
+    // atomically. config.yaml is loaded the first time this is called.
+    static std::shared_ptr<const AppConfig> getCurrent();
+    static void setCurrent(std::shared_ptr<const AppConfig> config);
+
+    // Listeners are called on the thread that set the new config, which is
+    // the message thread in the app
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void appConfigChanged(const AppConfig &oldConfig,
+                                      const AppConfig &newConfig) {}
+    };
+
+    static void addListener(Listener *l);
+    static void removeListener(Listener *l);
+
+  private:
+    static std::shared_ptr<const AppConfig> currentConfig;
+    static juce::ListenerList<Listener> &getListeners();
+};
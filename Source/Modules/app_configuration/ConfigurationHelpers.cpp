@@ -1,5 +1,4 @@
 #include "ConfigurationHelpers.h"
-#include <yaml-cpp/yaml.h>
 
 bool ConfigurationHelpers::writeBinarySamplesToDirectory(
     const juce::File &destDir, juce::StringRef filename, const char *data,
@@ -111,68 +110,56 @@ void ConfigurationHelpers::initSamples(tracktion::Engine &engine) {
                     tempDrumKitsDir);
 }
 
-bool ConfigurationHelpers::getShowTitleBar(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config)
-            if (config["show-title-bar"])
-                return config["show-title-bar"].as<bool>();
-    }
-
-    // Default to showing the title bar
-    return true;
+juce::File ConfigurationHelpers::getSamplesDirectory() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(SAMPLES_DIRECTORY_NAME);
 }
 
-double ConfigurationHelpers::getWidth(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config) {
-            if (config["size"]) {
-                auto sizeConfig = config["size"];
-                if (sizeConfig["width"])
-                    return sizeConfig["width"].as<double>();
-            }
-        }
-    }
-
-    // Default to 800
-    return 800;
+juce::File ConfigurationHelpers::getDrumKitsDirectory() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(DRUM_KITS_DIRECTORY_NAME);
 }
 
-double ConfigurationHelpers::getHeight(juce::File &configFile) {
-    if (configFile.exists()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-        YAML::Node config = rootNode["config"];
-        if (config) {
-            if (config["size"]) {
-                auto sizeConfig = config["size"];
-                if (sizeConfig["height"])
-                    return sizeConfig["height"].as<double>();
-            }
-        }
-    }
+juce::File ConfigurationHelpers::getSampleCacheDirectory() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(SAMPLE_CACHE_DIRECTORY_NAME);
+}
 
-    // Default to 480
-    return 480;
+juce::File ConfigurationHelpers::getPluginScanCacheFile() {
+    auto userAppDataDirectory = juce::File::getSpecialLocation(
+        juce::File::userApplicationDataDirectory);
+    return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
+        .getChildFile(PLUGIN_SCAN_CACHE_FILE_NAME);
 }
 
-juce::File ConfigurationHelpers::getSamplesDirectory() {
+juce::File ConfigurationHelpers::getConfigFile() {
     auto userAppDataDirectory = juce::File::getSpecialLocation(
         juce::File::userApplicationDataDirectory);
     return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
-        .getChildFile(SAMPLES_DIRECTORY_NAME);
+        .getChildFile(CONFIG_FILE_NAME);
 }
 
-juce::File ConfigurationHelpers::getDrumKitsDirectory() {
+juce::File ConfigurationHelpers::getEditJournalDirectory() {
     auto userAppDataDirectory = juce::File::getSpecialLocation(
         juce::File::userApplicationDataDirectory);
     return userAppDataDirectory.getChildFile(ROOT_DIRECTORY_NAME)
-        .getChildFile(DRUM_KITS_DIRECTORY_NAME);
+        .getChildFile(EDIT_JOURNAL_DIRECTORY_NAME);
+}
+
+juce::FileSearchPath ConfigurationHelpers::getPluginSearchPath() {
+    auto vst3Directory = juce::File::getSpecialLocation(
+                             juce::File::SpecialLocationType::userHomeDirectory)
+                             .getChildFile(".vst3");
+    if (!vst3Directory.exists())
+        vst3Directory.createDirectory();
+
+    return juce::FileSearchPath(vst3Directory.getFullPathName());
 }
 
 juce::File
@@ -7,14 +7,23 @@ class ConfigurationHelpers {
     static inline const juce::String ROOT_DIRECTORY_NAME = "LMN-3";
     static inline const juce::String SAMPLES_DIRECTORY_NAME = "samples";
     static inline const juce::String DRUM_KITS_DIRECTORY_NAME = "drum_kits";
+    static inline const juce::String SAMPLE_CACHE_DIRECTORY_NAME =
+        "sample_cache";
+    static inline const juce::String PLUGIN_SCAN_CACHE_FILE_NAME =
+        "plugin_scan_cache.xml";
+    static inline const juce::String CONFIG_FILE_NAME = "config.yaml";
+    static inline const juce::String EDIT_JOURNAL_DIRECTORY_NAME =
+        "edit_journal";
     static juce::File getSamplesDirectory();
     static juce::File getDrumKitsDirectory();
+    static juce::File getSampleCacheDirectory();
+    static juce::File getPluginScanCacheFile();
+    static juce::File getConfigFile();
+    static juce::File getEditJournalDirectory();
+    static juce::FileSearchPath getPluginSearchPath();
     static juce::File getTempSamplesDirectory(tracktion::Engine &engine);
     static juce::File getTempDrumKitsDirectory(tracktion::Engine &engine);
     static void initSamples(tracktion::Engine &engine);
-    static bool getShowTitleBar(juce::File &configFile);
-    static double getWidth(juce::File &configFile);
-    static double getHeight(juce::File &configFile);
 
   private:
     static bool writeBinarySamplesToDirectory(const juce::File &destDir,
@@ -16,11 +16,13 @@
 
 namespace app_configuration {
     class ConfigurationHelpers;
+    class AppConfig;
 }
 
 #include <juce_core/juce_core.h>
 #include <tracktion_engine/tracktion_engine.h>
 
 #include "ConfigurationHelpers.h"
+#include "AppConfig.h"
 
 
@@ -0,0 +1,67 @@
+#include "AppEngineBehaviour.h"
+
+namespace app_services {
+
+void AppEngineBehaviour::setNumAudioThreads(int numThreads) {
+    numAudioThreads = juce::jmax(0, numThreads);
+}
+
+int AppEngineBehaviour::getNumberOfCPUsToUseForAudio() {
+    if (numAudioThreads > 0)
+        return juce::jmin(numAudioThreads.load(),
+                          juce::SystemStats::getNumCpus());
+
+    return tracktion::EngineBehaviour::getNumberOfCPUsToUseForAudio();
+}
+
+void AppEngineBehaviour::setThreadPlacement(ThreadPlacement *placement) {
+    threadPlacement = placement;
+}
+
+bool AppEngineBehaviour::reallocateContext(tracktion::Edit &edit) {
+    auto &transport = edit.getTransport();
+
+    // Freeing the context stops playback, so wait until the transport stops
+    if (transport.isPlaying() || transport.isRecording())
+        return false;
+
+    transport.freePlaybackContext();
+
+    auto behaviour =
+        dynamic_cast<AppEngineBehaviour *>(&edit.engine.getEngineBehaviour());
+    if (behaviour != nullptr && behaviour->threadPlacement != nullptr)
+        behaviour->threadPlacement->runWithAudioPlacement(
+            [&transport]() { transport.ensureContextAllocated(); });
+    else
+        transport.ensureContextAllocated();
+
+    return true;
+}
+
+bool AppEngineBehaviour::reallocateContextWhenStopped(tracktion::Edit &edit) {
+    if (reallocateContext(edit)) {
+        pendingEdit = nullptr;
+        stopTimer();
+        return true;
+    }
+
+    pendingEdit = &edit;
+    startTimer(stoppedCheckIntervalMs);
+    return false;
+}
+
+void AppEngineBehaviour::timerCallback() {
+    if (pendingEdit == nullptr) {
+        stopTimer();
+        return;
+    }
+
+    if (!reallocateContext(*pendingEdit))
+        return;
+
+    pendingEdit = nullptr;
+    stopTimer();
+    juce::Logger::writeToLog("The audio threads have been changed");
+}
+
+} // namespace app_services
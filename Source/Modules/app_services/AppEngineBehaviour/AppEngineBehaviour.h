@@ -0,0 +1,42 @@
+#pragma once
+
+namespace app_services {
+
+// Engine settings that can be changed while the app is running. tracktion
+// reads the number of audio threads when an edit's playback context is
+// created, so reallocateContext needs to be called for a change to the
+// number of threads to take effect. If a ThreadPlacement is set, the context
+// is allocated with it so the worker threads run on the audio cores. The
+// context can't be reallocated while the edit is playing, so a change made
+// during playback waits for the transport to stop.
+class AppEngineBehaviour : public tracktion::EngineBehaviour,
+                           private juce::Timer {
+  public:
+    AppEngineBehaviour() = default;
+
+    // 0 uses tracktion's default
+    void setNumAudioThreads(int numThreads);
+    int getNumAudioThreads() const { return numAudioThreads; }
+    int getNumberOfCPUsToUseForAudio() override;
+
+    void setThreadPlacement(ThreadPlacement *placement);
+
+    // Returns false if the edit is playing and the context was left alone
+    static bool reallocateContext(tracktion::Edit &edit);
+    // Reallocates the context now, or once the transport stops if the edit is
+    // playing. Returns false if it has to wait.
+    bool reallocateContextWhenStopped(tracktion::Edit &edit);
+
+  private:
+    static constexpr int stoppedCheckIntervalMs = 100;
+
+    std::atomic<int> numAudioThreads{0};
+    ThreadPlacement *threadPlacement = nullptr;
+    tracktion::Edit::WeakRef pendingEdit;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AppEngineBehaviour)
+};
+
+} // namespace app_services
@@ -0,0 +1,142 @@
+#include "AudioCallbackMonitor.h"
+
+namespace app_services {
+
+namespace {
+// Lock free max for the values the audio thread keeps the worst of
+void storeMax(std::atomic<double> &value, double newValue) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (newValue > current &&
+           !value.compare_exchange_weak(current, newValue,
+                                        std::memory_order_relaxed))
+        ;
+}
+
+void add(std::atomic<double> &value, double amount) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, current + amount,
+                                        std::memory_order_relaxed))
+        ;
+}
+} // namespace
+
+bool AudioCallbackMonitor::Stats::hadDropoutWithin(juce::uint32 nowMs,
+                                                   juce::uint32 ms) const {
+    return lastDropoutTimeMs != 0 && nowMs - lastDropoutTimeMs < ms;
+}
+
+AudioCallbackMonitor::AudioCallbackMonitor(juce::AudioDeviceManager &dm)
+    : deviceManager(dm) {
+    lastDeviceXruns = deviceManager.getXRunCount();
+    deviceManager.addAudioCallback(this);
+    startTimer(updateIntervalMs);
+}
+
+AudioCallbackMonitor::~AudioCallbackMonitor() {
+    stopTimer();
+    deviceManager.removeAudioCallback(this);
+}
+
+void AudioCallbackMonitor::recordCallback(double intervalMs, double deadlineMs,
+                                          double load) {
+    currentDeadlineMs.store(deadlineMs, std::memory_order_relaxed);
+    pendingCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+    if (deadlineMs > 0.0 && intervalMs > deadlineMs * 1.5)
+        pendingLateCallbacks.fetch_add(1, std::memory_order_relaxed);
+
+    add(pendingLoadTotal, load);
+    storeMax(pendingPeakLoad, load);
+    storeMax(pendingWorstIntervalMs, intervalMs);
+
+    auto bin = juce::jlimit(0, numHistogramBins - 1,
+                            int(load * numHistogramBins));
+    pendingHistogram[size_t(bin)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioCallbackMonitor::update() {
+    const auto numCallbacks = pendingCallbacks.exchange(0);
+    const auto newLateCallbacks = pendingLateCallbacks.exchange(0);
+    const auto loadTotal = pendingLoadTotal.exchange(0.0);
+
+    stats.deadlineMs = currentDeadlineMs.load();
+    stats.peakLoad = pendingPeakLoad.exchange(0.0);
+    stats.worstIntervalMs = pendingWorstIntervalMs.exchange(0.0);
+    stats.load = numCallbacks > 0 ? loadTotal / numCallbacks : 0.0;
+    stats.numCallbacks += numCallbacks;
+    stats.numLateCallbacks += newLateCallbacks;
+
+    for (size_t i = 0; i < pendingHistogram.size(); i++)
+        stats.loadHistogram[i] += pendingHistogram[i].exchange(0);
+
+    // The device's count starts again whenever the device is restarted
+    const auto deviceXruns = deviceManager.getXRunCount();
+    const auto newXruns = deviceXruns >= lastDeviceXruns
+                              ? deviceXruns - lastDeviceXruns
+                              : deviceXruns;
+    lastDeviceXruns = deviceXruns;
+    stats.numXruns += newXruns;
+
+    if (newLateCallbacks > 0 || newXruns > 0)
+        logDropout(newLateCallbacks, newXruns);
+
+    listeners.call([this](Listener &l) { l.audioCallbackStatsChanged(stats); });
+}
+
+void AudioCallbackMonitor::addListener(Listener *l) { listeners.add(l); }
+
+void AudioCallbackMonitor::removeListener(Listener *l) { listeners.remove(l); }
+
+void AudioCallbackMonitor::logDropout(int newLateCallbacks, int newXruns) {
+    stats.lastDropoutTimeMs = juce::jmax(
+        juce::uint32(1), juce::Time::getMillisecondCounter());
+
+    auto message =
+        juce::Time::getCurrentTime().toString(false, true, true, true) +
+        " audio dropout: " + juce::String(newLateCallbacks) +
+        " late callbacks, " + juce::String(newXruns) + " xruns, peak load " +
+        juce::String(juce::roundToInt(stats.peakLoad * 100.0)) +
+        "%, worst interval " + juce::String(stats.worstIntervalMs, 1) +
+        " ms of " + juce::String(stats.deadlineMs, 1) + " ms";
+
+    recentDropouts.add(message);
+    if (recentDropouts.size() > maxRecentDropouts)
+        recentDropouts.removeRange(0,
+                                   recentDropouts.size() - maxRecentDropouts);
+
+    juce::Logger::writeToLog(message);
+}
+
+void AudioCallbackMonitor::audioDeviceIOCallbackWithContext(
+    const float *const *, int, float *const *outputChannelData,
+    int numOutputChannels, int numSamples,
+    const juce::AudioIODeviceCallbackContext &) {
+    // Extra callbacks are mixed in to the output, so only silence is added
+    for (int i = 0; i < numOutputChannels; i++)
+        if (outputChannelData[i] != nullptr)
+            juce::FloatVectorOperations::clear(outputChannelData[i],
+                                               numSamples);
+
+    const auto nowMs = juce::Time::getMillisecondCounterHiRes();
+    const auto intervalMs =
+        lastCallbackTimeMs > 0.0 ? nowMs - lastCallbackTimeMs : 0.0;
+    lastCallbackTimeMs = nowMs;
+
+    double deadlineMs = 0.0;
+    if (auto device = deviceManager.getCurrentAudioDevice())
+        if (device->getCurrentSampleRate() > 0.0)
+            deadlineMs = 1000.0 * numSamples / device->getCurrentSampleRate();
+
+    recordCallback(intervalMs, deadlineMs, deviceManager.getCpuUsage());
+}
+
+void AudioCallbackMonitor::audioDeviceAboutToStart(juce::AudioIODevice *) {
+    // The first callback after a restart has no previous one to compare to
+    lastCallbackTimeMs = 0.0;
+}
+
+void AudioCallbackMonitor::audioDeviceStopped() {}
+
+void AudioCallbackMonitor::timerCallback() { update(); }
+
+} // namespace app_services
@@ -0,0 +1,99 @@
+#pragma once
+
+namespace app_services {
+
+// Watches the audio device's callbacks for dropouts. The monitor adds itself
+// as an extra callback on the device manager, so it runs straight after the
+// engine has processed each block. On the audio thread it only records the
+// time since the previous callback, the device manager's current load and a
+// load histogram, all in atomics so the audio thread never waits. A callback
+// that arrives more than half a block late means the previous block missed
+// its deadline.
+//
+// A few times a second the message thread collects what was recorded along
+// with the device's own xrun count. Listeners get the new stats, and any
+// dropouts are added to a rolling log that is also written to the app log,
+// so glitches can be matched up with what the player was doing.
+class AudioCallbackMonitor : private juce::AudioIODeviceCallback,
+                             private juce::Timer {
+  public:
+    static constexpr int numHistogramBins = 10;
+
+    struct Stats {
+        double deadlineMs = 0.0;
+        double load = 0.0;
+        double peakLoad = 0.0;
+        double worstIntervalMs = 0.0;
+        juce::int64 numCallbacks = 0;
+        int numLateCallbacks = 0;
+        int numXruns = 0;
+        // Callbacks by load, each bin covering a tenth of the block time
+        std::array<juce::int64, numHistogramBins> loadHistogram{};
+        juce::uint32 lastDropoutTimeMs = 0;
+
+        bool hadDropoutWithin(juce::uint32 nowMs, juce::uint32 ms) const;
+    };
+
+    explicit AudioCallbackMonitor(juce::AudioDeviceManager &dm);
+    ~AudioCallbackMonitor() override;
+
+    const Stats &getStats() const { return stats; }
+    juce::StringArray getRecentDropouts() const { return recentDropouts; }
+
+    // Called on the audio thread for each callback. Public so the monitor can
+    // be driven without an audio device.
+    void recordCallback(double intervalMs, double deadlineMs, double load);
+
+    // Collects what the audio thread recorded since the last update, called
+    // by the monitor's timer
+    void update();
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void audioCallbackStatsChanged(const Stats &stats) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    static constexpr int updateIntervalMs = 250;
+    static constexpr int maxRecentDropouts = 100;
+
+    juce::AudioDeviceManager &deviceManager;
+
+    // Written on the audio thread, collected on the message thread
+    std::atomic<int> pendingCallbacks{0};
+    std::atomic<int> pendingLateCallbacks{0};
+    std::atomic<double> pendingLoadTotal{0.0};
+    std::atomic<double> pendingPeakLoad{0.0};
+    std::atomic<double> pendingWorstIntervalMs{0.0};
+    std::atomic<double> currentDeadlineMs{0.0};
+    std::array<std::atomic<int>, numHistogramBins> pendingHistogram{};
+
+    // Only used on the audio thread
+    double lastCallbackTimeMs = 0.0;
+
+    int lastDeviceXruns = 0;
+    Stats stats;
+    juce::StringArray recentDropouts;
+    juce::ListenerList<Listener> listeners;
+
+    void logDropout(int newLateCallbacks, int newXruns);
+
+    void audioDeviceIOCallbackWithContext(
+        const float *const *inputChannelData, int numInputChannels,
+        float *const *outputChannelData, int numOutputChannels,
+        int numSamples,
+        const juce::AudioIODeviceCallbackContext &context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice *device) override;
+    void audioDeviceStopped() override;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioCallbackMonitor)
+};
+
+} // namespace app_services
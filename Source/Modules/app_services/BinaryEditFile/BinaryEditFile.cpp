@@ -0,0 +1,221 @@
+#include "BinaryEditFile.h"
+
+namespace app_services {
+
+namespace {
+const juce::Identifier lazySection("lazySection");
+}
+
+BinaryEditFile::BinaryEditFile(const juce::File &file) {
+    mappedFile = std::make_unique<juce::MemoryMappedFile>(
+        file, juce::MemoryMappedFile::readOnly);
+
+    const auto size = juce::int64(mappedFile->getSize());
+    if (mappedFile->getData() == nullptr || size < headerSize)
+        return;
+
+    juce::MemoryInputStream header(mappedFile->getData(), size_t(headerSize),
+                                   false);
+    const auto magic = header.readInt();
+    const auto version = header.readInt();
+    const auto indexOffset = header.readInt64();
+    if (magic != magicNumber || version > formatVersion ||
+        !juce::isPositiveAndBelow(indexOffset, size) ||
+        !readIndex(indexOffset)) {
+        juce::Logger::writeToLog("Invalid binary edit file " +
+                                 file.getFullPathName());
+        return;
+    }
+
+    skeleton = juce::ValueTree::readFromData(
+        static_cast<const char *>(mappedFile->getData()) + headerSize,
+        size_t(indexOffset - headerSize));
+}
+
+bool BinaryEditFile::isPlaceholder(const juce::ValueTree &tree) {
+    return tree.hasProperty(lazySection);
+}
+
+juce::ValueTree BinaryEditFile::materialise(juce::ValueTree placeholder) {
+    if (!isPlaceholder(placeholder))
+        return placeholder;
+
+    auto section = readSection(placeholder[lazySection]);
+    auto parent = placeholder.getParent();
+    if (!section.isValid() || !parent.isValid())
+        return placeholder;
+
+    const auto index = parent.indexOf(placeholder);
+    parent.removeChild(index, nullptr);
+    parent.addChild(section, index, nullptr);
+    return section;
+}
+
+juce::ValueTree BinaryEditFile::getState() {
+    materialiseAll(skeleton);
+    return skeleton;
+}
+
+bool BinaryEditFile::isBinaryEditFile(const juce::File &file) {
+    juce::FileInputStream stream(file);
+    return stream.openedOk() && stream.readInt() == magicNumber;
+}
+
+bool BinaryEditFile::write(const juce::ValueTree &state,
+                           juce::OutputStream &stream) {
+    auto skeletonState = state.createCopy();
+    juce::Array<juce::MemoryBlock> sectionData;
+    extractSections(skeletonState, sectionData);
+
+    juce::MemoryOutputStream body;
+    skeletonState.writeToStream(body);
+
+    juce::Array<Section> index;
+    for (const auto &data : sectionData) {
+        index.add({headerSize + juce::int64(body.getDataSize()),
+                   juce::int64(data.getSize())});
+        body.write(data.getData(), data.getSize());
+    }
+
+    stream.writeInt(magicNumber);
+    stream.writeInt(formatVersion);
+    stream.writeInt64(headerSize + juce::int64(body.getDataSize()));
+    stream.write(body.getData(), body.getDataSize());
+
+    stream.writeCompressedInt(index.size());
+    for (const auto &section : index) {
+        stream.writeInt64(section.offset);
+        stream.writeInt64(section.size);
+    }
+
+    return stream.getPosition() > headerSize;
+}
+
+juce::ValueTree BinaryEditFile::readEditState(const juce::File &file) {
+    if (isBinaryEditFile(file)) {
+        BinaryEditFile binaryFile(file);
+        return binaryFile.getState();
+    }
+
+    if (auto xml = juce::parseXML(file))
+        return juce::ValueTree::fromXml(*xml);
+
+    return {};
+}
+
+std::unique_ptr<tracktion::Edit>
+BinaryEditFile::loadEdit(tracktion::Engine &engine, const juce::File &file) {
+    if (!isBinaryEditFile(file))
+        return tracktion::loadEditFromFile(engine, file);
+
+    // Binary edits skip parsing XML, but the edit still needs its whole state
+    // to create its tracks and plugins
+    BinaryEditFile binaryFile(file);
+    auto state = binaryFile.getState();
+    if (!state.isValid()) {
+        juce::Logger::writeToLog("Unable to read binary edit " +
+                                 file.getFullPathName());
+        return tracktion::createEmptyEdit(engine, file);
+    }
+
+    tracktion::Edit::Options options = {
+        engine, state, tracktion::ProjectItemID::createNewID(0)};
+    options.editFileRetriever = [file] { return file; };
+    return tracktion::Edit::createEdit(options);
+}
+
+bool BinaryEditFile::convertToBinary(const juce::File &xmlFile,
+                                     const juce::File &binaryFile) {
+    auto state = readEditState(xmlFile);
+    if (!state.isValid())
+        return false;
+
+    binaryFile.deleteFile();
+    juce::FileOutputStream stream(binaryFile);
+    return stream.openedOk() && write(state, stream) &&
+           stream.getStatus().wasOk();
+}
+
+bool BinaryEditFile::convertToXml(const juce::File &binaryFile,
+                                  const juce::File &xmlFile) {
+    auto state = readEditState(binaryFile);
+    if (!state.isValid())
+        return false;
+
+    auto xml = state.createXml();
+    return xml != nullptr && xml->writeTo(xmlFile);
+}
+
+bool BinaryEditFile::readIndex(juce::int64 indexOffset) {
+    const auto size = juce::int64(mappedFile->getSize());
+    juce::MemoryInputStream stream(
+        static_cast<const char *>(mappedFile->getData()) + indexOffset,
+        size_t(size - indexOffset), false);
+
+    const auto numSections = stream.readCompressedInt();
+    if (numSections < 0)
+        return false;
+
+    for (int i = 0; i < numSections; i++) {
+        Section section;
+        section.offset = stream.readInt64();
+        section.size = stream.readInt64();
+        if (section.offset < headerSize || section.size <= 0 ||
+            section.offset + section.size > indexOffset)
+            return false;
+
+        sections.add(section);
+    }
+
+    return true;
+}
+
+juce::ValueTree BinaryEditFile::readSection(int index) const {
+    if (!juce::isPositiveAndBelow(index, sections.size()))
+        return {};
+
+    const auto &section = sections.getReference(index);
+    return juce::ValueTree::readFromData(
+        static_cast<const char *>(mappedFile->getData()) + section.offset,
+        size_t(section.size));
+}
+
+void BinaryEditFile::materialiseAll(juce::ValueTree &tree) {
+    for (int i = 0; i < tree.getNumChildren(); i++) {
+        auto child = tree.getChild(i);
+        if (isPlaceholder(child))
+            materialise(child);
+        else
+            materialiseAll(child);
+    }
+}
+
+bool BinaryEditFile::isSectionType(const juce::ValueTree &tree) {
+    return tree.hasType(tracktion::IDs::SEQUENCE) ||
+           tree.hasType(tracktion::IDs::PLUGIN);
+}
+
+void BinaryEditFile::extractSections(
+    juce::ValueTree &tree, juce::Array<juce::MemoryBlock> &sectionData) {
+    for (int i = 0; i < tree.getNumChildren(); i++) {
+        auto child = tree.getChild(i);
+        if (isSectionType(child)) {
+            juce::MemoryOutputStream data;
+            child.writeToStream(data);
+            if (data.getDataSize() >= minSectionSize) {
+                juce::ValueTree placeholder(child.getType());
+                placeholder.setProperty(lazySection, sectionData.size(),
+                                        nullptr);
+                sectionData.add(data.getMemoryBlock());
+
+                tree.removeChild(i, nullptr);
+                tree.addChild(placeholder, i, nullptr);
+                continue;
+            }
+        }
+
+        extractSections(child, sectionData);
+    }
+}
+
+} // namespace app_services
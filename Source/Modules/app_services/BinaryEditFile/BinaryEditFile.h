@@ -0,0 +1,77 @@
+#pragma once
+
+namespace app_services {
+
+// A compact binary container for an edit's state, used as a faster
+// alternative to the XML edit file. The state is stored as a binary ValueTree
+// stream with the heavy parts of the edit, MIDI sequences and plugins with
+// large state, split out into separate sections that are listed in an index
+// at the end of the file.
+//
+// Opening the file memory maps it and only reads the skeleton of the edit, in
+// which each section is left as an empty placeholder of the same type. A
+// section is only read from the mapped file when it is materialised.
+class BinaryEditFile {
+  public:
+    explicit BinaryEditFile(const juce::File &file);
+
+    bool openedOk() const { return skeleton.isValid(); }
+    int getNumSections() const { return sections.size(); }
+
+    // The edit's state with any sections that haven't been materialised yet
+    // left as placeholders
+    juce::ValueTree getSkeleton() const { return skeleton; }
+
+    static bool isPlaceholder(const juce::ValueTree &tree);
+
+    // Replaces a placeholder in the skeleton with its section and returns the
+    // materialised tree
+    juce::ValueTree materialise(juce::ValueTree placeholder);
+
+    // Materialises every remaining section and returns the complete state
+    juce::ValueTree getState();
+
+    static bool isBinaryEditFile(const juce::File &file);
+    static bool write(const juce::ValueTree &state, juce::OutputStream &stream);
+
+    // Reads an edit file in either format
+    static juce::ValueTree readEditState(const juce::File &file);
+    // Loads an edit file in either format. An edit that can't be read is
+    // replaced with an empty one.
+    static std::unique_ptr<tracktion::Edit>
+    loadEdit(tracktion::Engine &engine, const juce::File &file);
+
+    static bool convertToBinary(const juce::File &xmlFile,
+                                const juce::File &binaryFile);
+    static bool convertToXml(const juce::File &binaryFile,
+                             const juce::File &xmlFile);
+
+  private:
+    struct Section {
+        juce::int64 offset;
+        juce::int64 size;
+    };
+
+    static constexpr int magicNumber = 0x424e4d4c;
+    static constexpr int formatVersion = 1;
+    static constexpr int headerSize = 16;
+
+    // Smaller subtrees are cheaper to read along with the skeleton
+    static constexpr int minSectionSize = 1024;
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    juce::ValueTree skeleton;
+    juce::Array<Section> sections;
+
+    bool readIndex(juce::int64 indexOffset);
+    juce::ValueTree readSection(int index) const;
+    void materialiseAll(juce::ValueTree &tree);
+
+    static bool isSectionType(const juce::ValueTree &tree);
+    static void extractSections(juce::ValueTree &tree,
+                                juce::Array<juce::MemoryBlock> &sectionData);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BinaryEditFile)
+};
+
+} // namespace app_services
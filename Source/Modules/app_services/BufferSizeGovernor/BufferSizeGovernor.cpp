@@ -0,0 +1,177 @@
+#include "BufferSizeGovernor.h"
+
+namespace app_services {
+
+BufferSizeGovernor::Policy::Policy(const Settings &s) : settings(s) {}
+
+int BufferSizeGovernor::Policy::getNextBufferSize(
+    const AudioCallbackMonitor::Stats &stats, int currentSize,
+    const juce::Array<int> &availableSizes, bool liveMonitoring) {
+    const auto numDropouts = stats.numLateCallbacks + stats.numXruns;
+    const auto newDropouts = juce::jmax(0, numDropouts - lastNumDropouts);
+    const auto hadCallbacks = stats.numCallbacks > lastNumCallbacks;
+    lastNumDropouts = numDropouts;
+    lastNumCallbacks = stats.numCallbacks;
+
+    // Nothing to go on while the device isn't running
+    if (!hadCallbacks || availableSizes.isEmpty())
+        return currentSize;
+
+    if (newDropouts > 0 || stats.load >= settings.stepUpLoad) {
+        numLowLoadUpdates = 0;
+        if (newDropouts > 0)
+            numUpdatesSinceDropout = 0;
+
+        for (auto size : availableSizes)
+            if (size > currentSize)
+                return size;
+
+        return currentSize;
+    }
+
+    numUpdatesSinceDropout++;
+
+    const auto stepDownLoad =
+        liveMonitoring ? settings.liveStepDownLoad : settings.stepDownLoad;
+    const auto updatesAfterDropout = liveMonitoring
+                                         ? settings.liveUpdatesAfterDropout
+                                         : settings.updatesAfterDropout;
+    const auto updatesBeforeStepDown =
+        liveMonitoring ? settings.liveUpdatesBeforeStepDown
+                       : settings.updatesBeforeStepDown;
+
+    if (stats.peakLoad < stepDownLoad &&
+        numUpdatesSinceDropout >= updatesAfterDropout)
+        numLowLoadUpdates++;
+    else
+        numLowLoadUpdates = 0;
+
+    if (numLowLoadUpdates < updatesBeforeStepDown)
+        return currentSize;
+
+    numLowLoadUpdates = 0;
+    for (int i = availableSizes.size() - 1; i >= 0; i--)
+        if (availableSizes[i] < currentSize)
+            return availableSizes[i];
+
+    return currentSize;
+}
+
+void BufferSizeGovernor::Policy::reset() {
+    numLowLoadUpdates = 0;
+    numUpdatesSinceDropout = 0;
+}
+
+BufferSizeGovernor::BufferSizeGovernor(tracktion::Edit &e,
+                                       juce::AudioDeviceManager &dm,
+                                       AudioCallbackMonitor &m,
+                                       const Settings &settings)
+    : edit(e), deviceManager(dm), monitor(m), policy(settings) {
+    lastAppliedBufferSize = getCurrentBufferSize();
+    deviceManager.addChangeListener(this);
+    monitor.addListener(this);
+}
+
+BufferSizeGovernor::~BufferSizeGovernor() {
+    stopTimer();
+    monitor.removeListener(this);
+    deviceManager.removeChangeListener(this);
+}
+
+bool BufferSizeGovernor::isLiveMonitoring(tracktion::Edit &edit) {
+    for (auto instance : edit.getAllInputDevices()) {
+        if (instance->getInputDevice().getDeviceType() !=
+            tracktion::InputDevice::physicalMidiDevice)
+            continue;
+
+        for (auto track : tracktion::getAudioTracks(edit))
+            if (instance->isOnTargetTrack(*track, 0) &&
+                instance->isRecordingEnabled(*track))
+                return true;
+    }
+
+    return false;
+}
+
+int BufferSizeGovernor::getCurrentBufferSize() const {
+    if (auto device = deviceManager.getCurrentAudioDevice())
+        return device->getCurrentBufferSizeSamples();
+
+    return 0;
+}
+
+void BufferSizeGovernor::applyPendingBufferSize() {
+    stopTimer();
+    if (pendingBufferSize <= 0)
+        return;
+
+    auto setup = deviceManager.getAudioDeviceSetup();
+    setup.bufferSize = pendingBufferSize;
+    lastAppliedBufferSize = pendingBufferSize;
+    pendingBufferSize = 0;
+
+    auto error = deviceManager.setAudioDeviceSetup(setup, true);
+    if (error.isNotEmpty())
+        juce::Logger::writeToLog("Unable to set buffer size to " +
+                                 juce::String(setup.bufferSize) + ": " +
+                                 error);
+    else
+        juce::Logger::writeToLog("Buffer size changed to " +
+                                 juce::String(setup.bufferSize) +
+                                 " to suit the audio load");
+
+    // The device may have picked a different size
+    lastAppliedBufferSize = getCurrentBufferSize();
+    policy.reset();
+}
+
+void BufferSizeGovernor::audioCallbackStatsChanged(
+    const AudioCallbackMonitor::Stats &stats) {
+    const auto currentSize = getCurrentBufferSize();
+    juce::Array<int> availableSizes;
+    if (auto device = deviceManager.getCurrentAudioDevice())
+        availableSizes = device->getAvailableBufferSizes();
+
+    auto nextSize = policy.getNextBufferSize(
+        stats, currentSize, availableSizes, isLiveMonitoring(edit));
+    if (nextSize == currentSize)
+        return;
+
+    pendingBufferSize = nextSize;
+    if (!edit.getTransport().isPlaying()) {
+        applyPendingBufferSize();
+        return;
+    }
+
+    // Watch the playhead for the loop wrapping around
+    lastPosition = edit.getTransport().getPosition().inSeconds();
+    startTimerHz(50);
+}
+
+void BufferSizeGovernor::changeListenerCallback(juce::ChangeBroadcaster *) {
+    // A size the governor didn't pick was chosen by hand, so start from it
+    const auto currentSize = getCurrentBufferSize();
+    if (currentSize == lastAppliedBufferSize)
+        return;
+
+    lastAppliedBufferSize = currentSize;
+    pendingBufferSize = 0;
+    stopTimer();
+    policy.reset();
+}
+
+void BufferSizeGovernor::timerCallback() {
+    auto &transport = edit.getTransport();
+    if (!transport.isPlaying()) {
+        applyPendingBufferSize();
+        return;
+    }
+
+    const auto position = transport.getPosition().inSeconds();
+    const auto wrapped = transport.looping && position < lastPosition;
+    lastPosition = position;
+    if (wrapped)
+        applyPendingBufferSize();
+}
+
+} // namespace app_services
@@ -0,0 +1,93 @@
+#pragma once
+
+namespace app_services {
+
+// Steps the audio device's buffer size up and down to suit the current set,
+// so players get the lowest latency the set can sustain. The load and
+// dropouts come from an AudioCallbackMonitor. A dropout or a high average
+// load moves to the next larger buffer size straight away, while the next
+// smaller size is only tried once the peak load has stayed low for a while
+// and there haven't been any recent dropouts. The gap between the two loads
+// keeps the size from bouncing back and forth.
+//
+// While a MIDI input is armed the player hears the buffer size as latency,
+// so smaller buffers are tried sooner and at a higher load.
+//
+// Changing the buffer size restarts the device, so a new size is only
+// applied while the transport is stopped or as playback wraps around the
+// loop. A buffer size picked by hand becomes the new starting point.
+class BufferSizeGovernor : private AudioCallbackMonitor::Listener,
+                           private juce::ChangeListener,
+                           private juce::Timer {
+  public:
+    struct Settings {
+        // Average load at or above which the buffer size is increased
+        double stepUpLoad = 0.8;
+        // Peak load below which a smaller buffer size is tried
+        double stepDownLoad = 0.4;
+        double liveStepDownLoad = 0.55;
+        // Monitor updates the peak load must stay low for
+        int updatesBeforeStepDown = 40;
+        int liveUpdatesBeforeStepDown = 12;
+        // Monitor updates after a dropout before a smaller size is tried
+        int updatesAfterDropout = 120;
+        int liveUpdatesAfterDropout = 40;
+    };
+
+    // Decides on buffer sizes without touching a device, so it can be
+    // driven directly with stats
+    class Policy {
+      public:
+        explicit Policy(const Settings &s = Settings());
+
+        // Returns the buffer size to use given the latest stats. This is the
+        // current size unless it is time for a step.
+        int getNextBufferSize(const AudioCallbackMonitor::Stats &stats,
+                              int currentSize,
+                              const juce::Array<int> &availableSizes,
+                              bool liveMonitoring);
+
+        // Starts again after the buffer size has changed
+        void reset();
+
+      private:
+        Settings settings;
+        juce::int64 lastNumCallbacks = 0;
+        int lastNumDropouts = 0;
+        int numLowLoadUpdates = 0;
+        int numUpdatesSinceDropout = 0;
+    };
+
+    BufferSizeGovernor(tracktion::Edit &e, juce::AudioDeviceManager &dm,
+                       AudioCallbackMonitor &m,
+                       const Settings &settings = Settings());
+    ~BufferSizeGovernor() override;
+
+    // 0 if no change is waiting for a safe point
+    int getPendingBufferSize() const { return pendingBufferSize; }
+
+    // True if a physical MIDI input is armed on any track
+    static bool isLiveMonitoring(tracktion::Edit &edit);
+
+  private:
+    tracktion::Edit &edit;
+    juce::AudioDeviceManager &deviceManager;
+    AudioCallbackMonitor &monitor;
+    Policy policy;
+
+    int pendingBufferSize = 0;
+    int lastAppliedBufferSize = 0;
+    double lastPosition = 0.0;
+
+    int getCurrentBufferSize() const;
+    void applyPendingBufferSize();
+
+    void audioCallbackStatsChanged(
+        const AudioCallbackMonitor::Stats &stats) override;
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BufferSizeGovernor)
+};
+
+} // namespace app_services
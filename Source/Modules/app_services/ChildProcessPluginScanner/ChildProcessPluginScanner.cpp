@@ -0,0 +1,160 @@
+#include "ChildProcessPluginScanner.h"
+
+namespace app_services {
+
+ChildProcessPluginScanner::ChildProcessPluginScanner(const juce::File &exe,
+                                                     int numParallel,
+                                                     int timeout)
+    : executable(exe), numParallelScans(juce::jmax(1, numParallel)),
+      timeoutMs(timeout) {}
+
+juce::File ChildProcessPluginScanner::getDefaultExecutable() {
+    return juce::File::getSpecialLocation(
+               juce::File::SpecialLocationType::currentExecutableFile)
+        .getSiblingFile("LMN-3-PluginScanner");
+}
+
+bool ChildProcessPluginScanner::isAvailable() const {
+    return executable.existsAsFile();
+}
+
+void ChildProcessPluginScanner::scan(
+    const juce::String &formatName, const juce::StringArray &files,
+    const std::function<void(const Result &)> &onResult,
+    const std::function<bool()> &shouldStop) {
+    juce::CriticalSection resultsLock;
+    juce::OwnedArray<Result> results;
+    juce::WaitableEvent resultAdded;
+
+    juce::ThreadPool threadPool(numParallelScans);
+    for (const auto &file : files)
+        threadPool.addJob([&, file] {
+            if (shouldStop())
+                return;
+
+            auto result = scanFile(formatName, file);
+            const juce::ScopedLock sl(resultsLock);
+            results.add(result.release());
+            resultAdded.signal();
+        });
+
+    // Hand the results back as they come in rather than once they are all
+    // done. This also kills scans that have run for too long, or all of them
+    // once scanning is stopped, in which case the results are thrown away.
+    auto numRemaining = files.size();
+    while (numRemaining > 0) {
+        resultAdded.wait(100);
+
+        const auto stopping = shouldStop();
+        killScans(stopping);
+
+        juce::OwnedArray<Result> newResults;
+        {
+            const juce::ScopedLock sl(resultsLock);
+            newResults.swapWith(results);
+        }
+
+        if (!stopping)
+            for (auto *result : newResults)
+                onResult(*result);
+
+        numRemaining -= newResults.size();
+        if (stopping && threadPool.getNumJobs() == 0)
+            break;
+    }
+
+    threadPool.removeAllJobs(true, timeoutMs + 1000);
+}
+
+std::unique_ptr<ChildProcessPluginScanner::Result>
+ChildProcessPluginScanner::scanFile(const juce::String &formatName,
+                                    const juce::String &file) {
+    auto result = std::make_unique<Result>();
+    result->fileOrIdentifier = file;
+
+    ActiveScan activeScan;
+    {
+        const juce::ScopedLock sl(activeScansLock);
+        if (!activeScan.process.start(
+                juce::StringArray{executable.getFullPathName(), formatName,
+                                  file},
+                juce::ChildProcess::wantStdOut))
+            return result;
+
+        activeScan.startTime = juce::Time::getMillisecondCounter();
+        activeScans.add(&activeScan);
+    }
+
+    // Read the output while the scanner is running, otherwise a scanner that
+    // writes more than the pipe holds would block until it was killed. This
+    // returns once the scanner has exited or been killed.
+    juce::MemoryOutputStream output;
+    char buffer[4096];
+    for (;;) {
+        const auto numRead =
+            activeScan.process.readProcessOutput(buffer, sizeof(buffer));
+        if (numRead <= 0)
+            break;
+
+        output.write(buffer, size_t(numRead));
+    }
+
+    {
+        const juce::ScopedLock sl(activeScansLock);
+        activeScans.removeFirstMatchingValue(&activeScan);
+    }
+
+    // The scanner may have closed its output without exiting, and a killed
+    // scanner still has to be waited for so it doesn't linger as a zombie
+    const auto elapsed =
+        int(juce::Time::getMillisecondCounter() - activeScan.startTime);
+    if (!activeScan.killed &&
+        !activeScan.process.waitForProcessToFinish(
+            juce::jmax(0, timeoutMs - elapsed))) {
+        activeScan.process.kill();
+        activeScan.killed = true;
+        activeScan.timedOut = true;
+    }
+
+    if (activeScan.killed)
+        activeScan.process.waitForProcessToFinish(1000);
+
+    auto finished = false;
+    for (const auto &line : juce::StringArray::fromLines(output.toString())) {
+        if (line == finishedLine) {
+            finished = true;
+            continue;
+        }
+
+        auto xml = juce::parseXML(line);
+        if (xml == nullptr)
+            continue;
+
+        auto type = std::make_unique<juce::PluginDescription>();
+        if (type->loadFromXml(*xml))
+            result->types.add(type.release());
+    }
+
+    result->timedOut = activeScan.timedOut;
+    result->crashed = !finished && !result->timedOut;
+    return result;
+}
+
+void ChildProcessPluginScanner::killScans(bool killAll) {
+    const juce::ScopedLock sl(activeScansLock);
+    const auto now = juce::Time::getMillisecondCounter();
+    for (auto *activeScan : activeScans) {
+        if (activeScan->killed)
+            continue;
+
+        const auto timedOut =
+            now - activeScan->startTime > juce::uint32(timeoutMs);
+        if (killAll || timedOut) {
+            activeScan->timedOut = timedOut;
+            activeScan->killed = true;
+            activeScan->process.kill();
+        }
+    }
+}
+
+} // namespace app_services
@@ -0,0 +1,69 @@
+#pragma once
+
+namespace app_services {
+
+// Scans plugins by launching the LMN-3-PluginScanner executable for each
+// plugin file, so a plugin that crashes while being loaded only takes its
+// scanner process down with it. Several files are scanned in parallel and a
+// scan that takes longer than the timeout is killed. The scanner writes each
+// plugin description it finds to its stdout pipe as a line of XML, which is
+// read as it is written, followed by a line saying it has finished. If that
+// line is missing the scanner crashed, and the result keeps the plugins it
+// found before then.
+class ChildProcessPluginScanner {
+  public:
+    struct Result {
+        juce::String fileOrIdentifier;
+        juce::OwnedArray<juce::PluginDescription> types;
+        bool timedOut = false;
+        bool crashed = false;
+
+        bool succeeded() const {
+            return !timedOut && !crashed && !types.isEmpty();
+        }
+    };
+
+    // The last line the scanner writes once it has finished
+    static constexpr const char *finishedLine = "finished";
+
+    explicit ChildProcessPluginScanner(
+        const juce::File &executable = getDefaultExecutable(),
+        int numParallelScans = juce::SystemStats::getNumCpus(),
+        int timeoutMs = 20000);
+
+    // The scanner executable is installed next to the app's executable
+    static juce::File getDefaultExecutable();
+
+    bool isAvailable() const;
+
+    // Scans the files and calls onResult on this thread as each one finishes.
+    // Once shouldStop returns true, the running scans are killed and no more
+    // results are passed on.
+    void scan(const juce::String &formatName, const juce::StringArray &files,
+              const std::function<void(const Result &)> &onResult,
+              const std::function<bool()> &shouldStop);
+
+  private:
+    struct ActiveScan {
+        juce::ChildProcess process;
+        juce::uint32 startTime = 0;
+        std::atomic<bool> killed{false};
+        std::atomic<bool> timedOut{false};
+    };
+
+    juce::File executable;
+    int numParallelScans;
+    int timeoutMs;
+
+    // Scans that are running, the scan loop kills them when they time out
+    juce::CriticalSection activeScansLock;
+    juce::Array<ActiveScan *> activeScans;
+
+    std::unique_ptr<Result> scanFile(const juce::String &formatName,
+                                     const juce::String &file);
+    void killScans(bool killAll);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChildProcessPluginScanner)
+};
+
+} // namespace app_services
@@ -0,0 +1,66 @@
+#include "DeferredTaskQueue.h"
+
+namespace app_services {
+
+DeferredTaskQueue::DeferredTaskQueue(StartupProfiler *profiler)
+    : startupProfiler(profiler) {}
+
+DeferredTaskQueue::~DeferredTaskQueue() { stopTimer(); }
+
+void DeferredTaskQueue::addTask(const juce::String &name,
+                                std::function<void()> task) {
+    tasks.push_back({name, std::move(task)});
+
+    if (!isTimerRunning())
+        startTimer(taskIntervalMs);
+}
+
+bool DeferredTaskQueue::runNow(const juce::String &name) {
+    for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+        if (it->name == name) {
+            auto task = std::move(*it);
+            tasks.erase(it);
+            runTask(std::move(task));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DeferredTaskQueue::cancelTask(const juce::String &name) {
+    tasks.remove_if([&name](const Task &task) { return task.name == name; });
+}
+
+bool DeferredTaskQueue::isPending(const juce::String &name) const {
+    return std::any_of(tasks.begin(), tasks.end(), [&name](const Task &task) {
+        return task.name == name;
+    });
+}
+
+void DeferredTaskQueue::runTask(Task task) {
+    if (startupProfiler != nullptr)
+        startupProfiler->startPhase(task.name);
+
+    task.function();
+
+    if (startupProfiler != nullptr)
+        startupProfiler->endPhase();
+}
+
+void DeferredTaskQueue::timerCallback() {
+    if (!tasks.empty()) {
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+        runTask(std::move(task));
+    }
+
+    // A task may have added more tasks while it ran
+    if (tasks.empty()) {
+        stopTimer();
+        if (onAllTasksFinished)
+            onAllTasksFinished();
+    }
+}
+
+} // namespace app_services
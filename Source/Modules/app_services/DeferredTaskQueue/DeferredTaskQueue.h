@@ -0,0 +1,47 @@
+#pragma once
+
+namespace app_services {
+
+// Runs tasks on the message thread one at a time, with a short gap between
+// each one so the message loop can paint and handle input in between. Used to
+// put off the parts of startup that aren't needed to show the first screen.
+// Anything that needs a task's work before its turn can run it straight away
+// with runNow.
+class DeferredTaskQueue : private juce::Timer {
+  public:
+    explicit DeferredTaskQueue(StartupProfiler *profiler = nullptr);
+    ~DeferredTaskQueue() override;
+
+    void addTask(const juce::String &name, std::function<void()> task);
+
+    // Runs the named task now if it hasn't run yet. Returns false if there
+    // was no task with that name waiting to run.
+    bool runNow(const juce::String &name);
+
+    // Removes a task that hasn't run yet, for when its owner is destroyed
+    void cancelTask(const juce::String &name);
+
+    bool isPending(const juce::String &name) const;
+    int getNumPendingTasks() const { return int(tasks.size()); }
+
+    // Called once every task has run
+    std::function<void()> onAllTasksFinished;
+
+  private:
+    struct Task {
+        juce::String name;
+        std::function<void()> function;
+    };
+
+    static constexpr int taskIntervalMs = 5;
+
+    StartupProfiler *startupProfiler;
+    std::list<Task> tasks;
+
+    void runTask(Task task);
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeferredTaskQueue)
+};
+
+} // namespace app_services
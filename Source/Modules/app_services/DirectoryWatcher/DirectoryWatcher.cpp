@@ -0,0 +1,112 @@
+#include "DirectoryWatcher.h"
+
+#if JUCE_LINUX
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+DirectoryWatcher::DirectoryWatcher(const juce::File &dir)
+    : juce::Thread("DirectoryWatcher"), directory(dir) {
+#if JUCE_LINUX
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        juce::Logger::writeToLog("Unable to initialise inotify for " +
+                                 directory.getFullPathName());
+        return;
+    }
+
+    watchDescriptor = inotify_add_watch(
+        inotifyFd, directory.getFullPathName().toRawUTF8(),
+        IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+    if (watchDescriptor < 0) {
+        juce::Logger::writeToLog("Unable to watch directory " +
+                                 directory.getFullPathName());
+        ::close(inotifyFd);
+        inotifyFd = -1;
+        return;
+    }
+
+    ThreadPlacement::runOnAnyCore([this] { startThread(); });
+#else
+    juce::Logger::writeToLog(
+        "Directory watching is not supported on this platform: " +
+        directory.getFullPathName());
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+    stopThread(1000);
+    cancelPendingUpdate();
+
+#if JUCE_LINUX
+    if (inotifyFd >= 0) {
+        if (watchDescriptor >= 0)
+            inotify_rm_watch(inotifyFd, watchDescriptor);
+
+        ::close(inotifyFd);
+    }
+#endif
+}
+
+void DirectoryWatcher::addListener(Listener *l) { listeners.add(l); }
+
+void DirectoryWatcher::removeListener(Listener *l) { listeners.remove(l); }
+
+void DirectoryWatcher::run() {
+#if JUCE_LINUX
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (!threadShouldExit()) {
+        // poll with a timeout so the thread can notice it should exit
+        struct pollfd pfd = {inotifyFd, POLLIN, 0};
+        if (::poll(&pfd, 1, 250) <= 0)
+            continue;
+
+        auto numBytes = ::read(inotifyFd, buffer, sizeof(buffer));
+        if (numBytes <= 0)
+            continue;
+
+        juce::Array<PendingEvent> events;
+        for (char *ptr = buffer; ptr < buffer + numBytes;) {
+            auto *event = reinterpret_cast<struct inotify_event *>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->len == 0 || (event->mask & IN_ISDIR) != 0)
+                continue;
+
+            auto file = directory.getChildFile(juce::String(event->name));
+
+            // Files are only reported once they have been completely written
+            // (IN_CLOSE_WRITE) rather than when they are first created
+            if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0)
+                events.add({file, FileEvent::CREATED_OR_MODIFIED});
+            else if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0)
+                events.add({file, FileEvent::DELETED});
+        }
+
+        if (!events.isEmpty()) {
+            const juce::ScopedLock sl(pendingEventsLock);
+            pendingEvents.addArray(events);
+            triggerAsyncUpdate();
+        }
+    }
+#endif
+}
+
+void DirectoryWatcher::handleAsyncUpdate() {
+    juce::Array<PendingEvent> events;
+    {
+        const juce::ScopedLock sl(pendingEventsLock);
+        events.swapWith(pendingEvents);
+    }
+
+    for (const auto &pendingEvent : events)
+        listeners.call([&pendingEvent](Listener &l) {
+            l.fileChanged(pendingEvent.file, pendingEvent.event);
+        });
+}
+
+} // namespace app_services
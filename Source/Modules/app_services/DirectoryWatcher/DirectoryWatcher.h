@@ -0,0 +1,49 @@
+#pragma once
+
+namespace app_services {
+
+// Watches a single directory (non recursively) for files being created,
+// modified, moved or deleted. On Linux this is backed by inotify. Events are
+// collected on a background thread and delivered to listeners on the message
+// thread. On other platforms no events are delivered.
+class DirectoryWatcher : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    enum class FileEvent { CREATED_OR_MODIFIED, DELETED };
+
+    explicit DirectoryWatcher(const juce::File &dir);
+    ~DirectoryWatcher() override;
+
+    const juce::File &getDirectory() const { return directory; }
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void fileChanged(const juce::File &file, FileEvent event) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    struct PendingEvent {
+        juce::File file;
+        FileEvent event;
+    };
+
+    juce::File directory;
+    juce::ListenerList<Listener> listeners;
+
+    juce::CriticalSection pendingEventsLock;
+    juce::Array<PendingEvent> pendingEvents;
+
+    int inotifyFd = -1;
+    int watchDescriptor = -1;
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DirectoryWatcher)
+};
+
+} // namespace app_services
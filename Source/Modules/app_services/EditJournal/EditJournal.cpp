@@ -0,0 +1,325 @@
+#include "EditJournal.h"
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+namespace {
+const juce::Identifier journalGeneration("journalGeneration");
+const juce::String journalFilePrefix("journal_");
+const juce::String journalFileExtension(".bin");
+
+int getGenerationOfFile(const juce::File &file) {
+    return file.getFileNameWithoutExtension()
+        .fromFirstOccurrenceOf(journalFilePrefix, false, false)
+        .getIntValue();
+}
+
+void syncToDisk(const juce::File &file) {
+#if JUCE_LINUX
+    auto fd = ::open(file.getFullPathName().toRawUTF8(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    juce::ignoreUnused(file);
+#endif
+}
+} // namespace
+
+EditJournal::EditJournal(tracktion::Edit &e, EditSaver &saver,
+                         const juce::File &directory)
+    : juce::Thread("EditJournal"), edit(e), editSaver(saver),
+      journalDirectory(directory) {
+    journalDirectory.createDirectory();
+    generation = int(edit.state.getProperty(journalGeneration, 0));
+
+    edit.state.addListener(this);
+    editSaver.addListener(this);
+    editSaver.setSnapshotCallback([this]() { startNextGeneration(); });
+
+    ThreadPlacement::runOnAnyCore([this] { startThread(); });
+    startTimer(compactIntervalMs);
+}
+
+EditJournal::~EditJournal() {
+    stopTimer();
+    editSaver.setSnapshotCallback(nullptr);
+    editSaver.removeListener(this);
+    edit.state.removeListener(this);
+
+    // The thread writes anything still queued before it exits
+    queueCurrentChanges();
+    signalThreadShouldExit();
+    writeRequested.signal();
+    stopThread(10000);
+}
+
+void EditJournal::compact() { editSaver.save(); }
+
+void EditJournal::close() {
+    compact();
+    if (editSaver.waitUntilSaved(10000))
+        deleteOldJournals();
+}
+
+int EditJournal::replay(juce::ValueTree &state, const juce::File &directory) {
+    const int savedGeneration = state.getProperty(journalGeneration, 0);
+
+    juce::Array<int> generations;
+    for (const auto &file : directory.findChildFiles(
+             juce::File::findFiles, false,
+             journalFilePrefix + "*" + journalFileExtension)) {
+        auto fileGeneration = getGenerationOfFile(file);
+        if (fileGeneration >= savedGeneration)
+            generations.addUsingDefaultSort(fileGeneration);
+    }
+
+    int numChanges = 0;
+    for (auto fileGeneration : generations) {
+        juce::FileInputStream stream(
+            getJournalFile(directory, fileGeneration));
+        if (!stream.openedOk())
+            break;
+
+        while (!stream.isExhausted()) {
+            // A change that was only partly written when the power went is
+            // the end of the journal
+            const auto size = stream.readInt();
+            if (size <= 0 || stream.getNumBytesRemaining() < size) {
+                juce::Logger::writeToLog("Edit journal ends with a partial "
+                                         "change, ignoring it");
+                return numChanges;
+            }
+
+            juce::MemoryBlock change;
+            stream.readIntoMemoryBlock(change, size);
+            juce::MemoryInputStream changeStream(change, false);
+            if (!applyChange(state, changeStream)) {
+                juce::Logger::writeToLog(
+                    "Unable to apply edit journal change, stopping replay");
+                return numChanges;
+            }
+
+            numChanges++;
+        }
+    }
+
+    return numChanges;
+}
+
+juce::File EditJournal::getJournalFile(const juce::File &directory,
+                                       int generation) {
+    return directory.getChildFile(journalFilePrefix + juce::String(generation) +
+                                  journalFileExtension);
+}
+
+void EditJournal::startNextGeneration() {
+    // Everything recorded so far belongs to the old generation, and will be
+    // included in the state that is about to be saved
+    queueCurrentChanges();
+    generation++;
+    changedSinceCompaction = false;
+
+    edit.state.setProperty(journalGeneration, generation, nullptr);
+}
+
+void EditJournal::deleteOldJournals() {
+    // Changes from an older generation may still be waiting to be written,
+    // which would bring their journal back after it was deleted
+    writePendingChanges();
+
+    const juce::ScopedLock sl(writeLock);
+    for (const auto &file : journalDirectory.findChildFiles(
+             juce::File::findFiles, false,
+             journalFilePrefix + "*" + journalFileExtension))
+        if (getGenerationOfFile(file) < generation)
+            file.deleteFile();
+}
+
+void EditJournal::queueCurrentChanges() {
+    const juce::ScopedLock sl(pendingWritesLock);
+    if (currentChanges.getDataSize() == 0)
+        return;
+
+    pendingWrites.add({generation, currentChanges.getMemoryBlock()});
+    currentChanges.reset();
+}
+
+void EditJournal::writeChange(
+    ChangeType type, const juce::ValueTree &tree,
+    const std::function<void(juce::OutputStream &)> &body) {
+    juce::MemoryOutputStream change;
+    change.writeByte(char(type));
+
+    auto path = getPath(tree);
+    change.writeCompressedInt(path.size());
+    for (auto index : path)
+        change.writeCompressedInt(index);
+
+    body(change);
+
+    // Each change is prefixed with its size so a partly written one can be
+    // spotted when replaying
+    const juce::ScopedLock sl(pendingWritesLock);
+    currentChanges.writeInt(int(change.getDataSize()));
+    currentChanges.write(change.getData(), change.getDataSize());
+    changedSinceCompaction = true;
+}
+
+void EditJournal::writePendingChanges() {
+    const juce::ScopedLock writeScopedLock(writeLock);
+    juce::Array<PendingWrite> writes;
+    {
+        const juce::ScopedLock sl(pendingWritesLock);
+        writes.swapWith(pendingWrites);
+    }
+
+    for (const auto &write : writes) {
+        auto file = getJournalFile(journalDirectory, write.generation);
+        {
+            juce::FileOutputStream stream(file);
+            if (!stream.openedOk()) {
+                juce::Logger::writeToLog("Unable to write edit journal " +
+                                         file.getFullPathName());
+                continue;
+            }
+
+            stream.write(write.data.getData(), write.data.getSize());
+            stream.flush();
+        }
+
+        syncToDisk(file);
+    }
+}
+
+juce::Array<int> EditJournal::getPath(const juce::ValueTree &tree) {
+    juce::Array<int> path;
+    for (auto child = tree; child.getParent().isValid();
+         child = child.getParent())
+        path.insert(0, child.getParent().indexOf(child));
+
+    return path;
+}
+
+bool EditJournal::applyChange(juce::ValueTree &root,
+                              juce::InputStream &stream) {
+    const auto type = ChangeType(stream.readByte());
+
+    auto tree = root;
+    const auto pathSize = stream.readCompressedInt();
+    for (int i = 0; i < pathSize; i++) {
+        tree = tree.getChild(stream.readCompressedInt());
+        if (!tree.isValid())
+            return false;
+    }
+
+    switch (type) {
+    case ChangeType::PROPERTY_SET: {
+        auto name = stream.readString();
+        tree.setProperty(name, juce::var::readFromStream(stream), nullptr);
+        return true;
+    }
+    case ChangeType::PROPERTY_REMOVED:
+        tree.removeProperty(stream.readString(), nullptr);
+        return true;
+    case ChangeType::CHILD_ADDED: {
+        auto index = stream.readCompressedInt();
+        auto child = juce::ValueTree::readFromStream(stream);
+        if (!child.isValid())
+            return false;
+
+        tree.addChild(child, index, nullptr);
+        return true;
+    }
+    case ChangeType::CHILD_REMOVED: {
+        auto index = stream.readCompressedInt();
+        if (!juce::isPositiveAndBelow(index, tree.getNumChildren()))
+            return false;
+
+        tree.removeChild(index, nullptr);
+        return true;
+    }
+    case ChangeType::CHILD_MOVED: {
+        auto oldIndex = stream.readCompressedInt();
+        auto newIndex = stream.readCompressedInt();
+        if (!juce::isPositiveAndBelow(oldIndex, tree.getNumChildren()))
+            return false;
+
+        tree.moveChild(oldIndex, newIndex, nullptr);
+        return true;
+    }
+    }
+
+    return false;
+}
+
+void EditJournal::valueTreePropertyChanged(juce::ValueTree &tree,
+                                           const juce::Identifier &property) {
+    if (tree.hasProperty(property))
+        writeChange(ChangeType::PROPERTY_SET, tree,
+                    [&tree, &property](juce::OutputStream &stream) {
+                        stream.writeString(property.toString());
+                        tree[property].writeToStream(stream);
+                    });
+    else
+        writeChange(ChangeType::PROPERTY_REMOVED, tree,
+                    [&property](juce::OutputStream &stream) {
+                        stream.writeString(property.toString());
+                    });
+}
+
+void EditJournal::valueTreeChildAdded(juce::ValueTree &parent,
+                                      juce::ValueTree &child) {
+    writeChange(ChangeType::CHILD_ADDED, parent,
+                [&parent, &child](juce::OutputStream &stream) {
+                    stream.writeCompressedInt(parent.indexOf(child));
+                    child.writeToStream(stream);
+                });
+}
+
+void EditJournal::valueTreeChildRemoved(juce::ValueTree &parent,
+                                        juce::ValueTree &, int index) {
+    writeChange(ChangeType::CHILD_REMOVED, parent,
+                [index](juce::OutputStream &stream) {
+                    stream.writeCompressedInt(index);
+                });
+}
+
+void EditJournal::valueTreeChildOrderChanged(juce::ValueTree &parent,
+                                             int oldIndex, int newIndex) {
+    writeChange(ChangeType::CHILD_MOVED, parent,
+                [oldIndex, newIndex](juce::OutputStream &stream) {
+                    stream.writeCompressedInt(oldIndex);
+                    stream.writeCompressedInt(newIndex);
+                });
+}
+
+void EditJournal::run() {
+    while (true) {
+        writeRequested.wait(writeIntervalMs);
+
+        queueCurrentChanges();
+        writePendingChanges();
+
+        if (threadShouldExit())
+            break;
+    }
+}
+
+void EditJournal::timerCallback() {
+    if (changedSinceCompaction)
+        compact();
+}
+
+void EditJournal::editSaved(bool success) {
+    // Older journals can only go once every requested save has been written
+    if (success && !editSaver.isSaving())
+        deleteOldJournals();
+}
+
+} // namespace app_services
@@ -0,0 +1,97 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps an append only journal of every change made to an edit's state so
+// the edit can be recovered after a crash or power loss without having to
+// save the whole edit after every change. Changes are picked up by listening
+// to the edit's state tree, which also sees changes made by undo and redo,
+// and are written out and synced to disk in the background every half a
+// second.
+//
+// Every save made by the EditSaver acts as a compaction, so the edit must
+// only ever be saved through it. The journal starts a
+// new generation just before the edit state is copied for the save and
+// records that generation in the edit. The journals from older generations
+// are deleted once the save has been written. When recovering, only the
+// journals from the saved edit's generation onwards are replayed, so no
+// change is ever applied twice.
+class EditJournal : private juce::ValueTree::Listener,
+                    private juce::Thread,
+                    private juce::Timer,
+                    private EditSaver::Listener {
+  public:
+    EditJournal(tracktion::Edit &e, EditSaver &saver,
+                const juce::File &directory);
+    ~EditJournal() override;
+
+    // Saves the whole edit so the current journal is no longer needed
+    void compact();
+
+    // Compacts and waits for the save to be written, used on a clean exit
+    void close();
+
+    // Applies the journals written since the given state was saved and
+    // returns the number of changes that were applied
+    static int replay(juce::ValueTree &state, const juce::File &directory);
+
+    int getGeneration() const { return generation; }
+    static juce::File getJournalFile(const juce::File &directory,
+                                     int generation);
+
+  private:
+    enum class ChangeType : juce::uint8 {
+        PROPERTY_SET = 1,
+        PROPERTY_REMOVED,
+        CHILD_ADDED,
+        CHILD_REMOVED,
+        CHILD_MOVED
+    };
+
+    struct PendingWrite {
+        int generation;
+        juce::MemoryBlock data;
+    };
+
+    static constexpr int writeIntervalMs = 500;
+    static constexpr int compactIntervalMs = 5 * 60 * 1000;
+
+    tracktion::Edit &edit;
+    EditSaver &editSaver;
+    juce::File journalDirectory;
+    int generation = 0;
+    bool changedSinceCompaction = false;
+
+    juce::CriticalSection pendingWritesLock;
+    juce::MemoryOutputStream currentChanges;
+    juce::Array<PendingWrite> pendingWrites;
+    juce::WaitableEvent writeRequested;
+    juce::CriticalSection writeLock;
+
+    void startNextGeneration();
+    void deleteOldJournals();
+    void queueCurrentChanges();
+    void writeChange(ChangeType type, const juce::ValueTree &tree,
+                     const std::function<void(juce::OutputStream &)> &body);
+    void writePendingChanges();
+
+    static juce::Array<int> getPath(const juce::ValueTree &tree);
+    static bool applyChange(juce::ValueTree &root, juce::InputStream &stream);
+
+    void valueTreePropertyChanged(juce::ValueTree &tree,
+                                  const juce::Identifier &property) override;
+    void valueTreeChildAdded(juce::ValueTree &parent,
+                             juce::ValueTree &child) override;
+    void valueTreeChildRemoved(juce::ValueTree &parent, juce::ValueTree &child,
+                               int index) override;
+    void valueTreeChildOrderChanged(juce::ValueTree &parent, int oldIndex,
+                                    int newIndex) override;
+
+    void run() override;
+    void timerCallback() override;
+    void editSaved(bool success) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditJournal)
+};
+
+} // namespace app_services
@@ -0,0 +1,246 @@
+#include "EditRenderJob.h"
+
+namespace app_services {
+
+EditRenderJob::EditRenderJob(tracktion::Edit &e, const juce::File &destFile,
+                             const juce::BigInteger &tracksToDo)
+    : EditRenderJob(e, destFile, tracksToDo, Options()) {}
+
+EditRenderJob::EditRenderJob(tracktion::Edit &e, const juce::File &destFile,
+                             const juce::BigInteger &tracksToDo,
+                             const Options &options)
+    : EditRenderJob(e, {{destFile, tracksToDo, true}}, options) {}
+
+EditRenderJob::EditRenderJob(tracktion::Edit &e,
+                             const juce::Array<Render> &renders)
+    : EditRenderJob(e, renders, Options()) {}
+
+EditRenderJob::EditRenderJob(tracktion::Edit &e,
+                             const juce::Array<Render> &renders,
+                             const Options &options)
+    : edit(e), renderOptions(options) {
+    for (const auto &render : renders)
+        renderStates.add(new RenderState(render));
+
+    ThreadPlacement::runOnAnyCore([this] {
+        threadPool = std::make_unique<juce::ThreadPool>(
+            juce::jmax(1, renderOptions.numThreads));
+    });
+}
+
+EditRenderJob::~EditRenderJob() {
+    stopTimer();
+    threadPool->removeAllJobs(true, 10000);
+}
+
+juce::Array<EditRenderJob::Render>
+EditRenderJob::getStemRenders(tracktion::Edit &edit,
+                              const juce::File &directory) {
+    juce::Array<Render> renders;
+    juce::BigInteger allTracks;
+
+    // Track indexes are counted from all of the edit's tracks
+    auto tracks = tracktion::getAllTracks(edit);
+    auto audioTracks = tracktion::getAudioTracks(edit);
+    for (int i = 0; i < audioTracks.size(); i++) {
+        auto index = tracks.indexOf(audioTracks[i]);
+
+        // Track names don't have to be unique, so number the files
+        Render render;
+        render.destFile = directory.getChildFile(
+            juce::String(i + 1).paddedLeft('0', 2) + " " +
+            juce::File::createLegalFileName(audioTracks[i]->getName()) +
+            ".wav");
+        render.tracksToDo.setBit(index);
+        render.useMasterPlugins = false;
+        renders.add(render);
+        allTracks.setBit(index);
+    }
+
+    renders.add({directory.getChildFile("Master.wav"), allTracks, true});
+    return renders;
+}
+
+void EditRenderJob::start() {
+    if (rendering)
+        return;
+
+    createRenderEdit();
+    cancelled = false;
+    rendering = true;
+    timerCallback();
+    startTimer(progressIntervalMs);
+}
+
+void EditRenderJob::cancel() {
+    if (!rendering)
+        return;
+
+    cancelled = true;
+    for (auto *state : renderStates)
+        if (state->task != nullptr)
+            state->task->signalJobShouldExit();
+}
+
+bool EditRenderJob::isRendering() const { return rendering; }
+
+float EditRenderJob::getProgress() const {
+    if (renderStates.isEmpty())
+        return 0.0f;
+
+    float progress = 0.0f;
+    for (auto *state : renderStates) {
+        if (state->finished)
+            progress += 1.0f;
+        else if (state->task != nullptr)
+            progress += state->task->getCurrentTaskProgress();
+    }
+
+    return progress / float(renderStates.size());
+}
+
+juce::Array<juce::File> EditRenderJob::getDestinationFiles() const {
+    juce::Array<juce::File> files;
+    for (auto *state : renderStates)
+        files.add(state->render.destFile);
+
+    return files;
+}
+
+void EditRenderJob::addListener(Listener *l) { listeners.add(l); }
+
+void EditRenderJob::removeListener(Listener *l) { listeners.remove(l); }
+
+bool EditRenderJob::isRunning(const RenderState &state) const {
+    return state.task != nullptr && !state.finished;
+}
+
+bool EditRenderJob::canStart(const RenderState &state) const {
+    int numRunning = 0;
+    for (auto *other : renderStates) {
+        if (!isRunning(*other))
+            continue;
+
+        if (other->render.tracksToDo.intersects(state.render.tracksToDo))
+            return false;
+
+        numRunning++;
+    }
+
+    return numRunning < threadPool->getNumThreads();
+}
+
+void EditRenderJob::createRenderEdit() {
+    // Plugins only write their state back to the edit when asked to
+    edit.flushState();
+
+    tracktion::Edit::Options options = {
+        edit.engine, edit.state.createCopy(),
+        tracktion::ProjectItemID::createNewID(0)};
+    options.role = tracktion::Edit::forRendering;
+    options.editFileRetriever = edit.editFileRetriever;
+    options.filePathResolver = edit.filePathResolver;
+    renderEdit = tracktion::Edit::createEdit(options);
+
+    if (renderOptions.prepareEdit)
+        renderOptions.prepareEdit(*renderEdit);
+}
+
+void EditRenderJob::startRender(RenderState &state) {
+    state.render.destFile.getParentDirectory().createDirectory();
+
+    tracktion::Renderer::Parameters params(*renderEdit);
+    params.destFile = state.temporaryFile.getFile();
+    auto &formatManager = edit.engine.getAudioFileFormatManager();
+    params.audioFormat = state.render.destFile.hasFileExtension("flac")
+                             ? formatManager.getFlacFormat()
+                             : formatManager.getWavFormat();
+    params.bitDepth = 24;
+    params.sampleRateForAudio = renderOptions.sampleRate;
+    params.blockSizeForAudio = renderOptions.blockSize;
+    params.time = tracktion::TimeRange(
+        tracktion::TimePosition::fromSeconds(0.0),
+        renderEdit->getLength() + renderOptions.tailLength);
+    params.tracksToDo = state.render.tracksToDo;
+    params.usePlugins = true;
+    params.useMasterPlugins = state.render.useMasterPlugins;
+    params.realTimeRender = false;
+
+    // The task has to be created on the message thread since it builds the
+    // playback graph for the edit. The pool runs it until it has finished.
+    state.task = std::make_unique<tracktion::Renderer::RenderTask>(
+        "Render", params, nullptr, nullptr);
+    threadPool->addJob(state.task.get(), false);
+}
+
+void EditRenderJob::finishRender(RenderState &state) {
+    auto errorMessage = state.task->errorMessage;
+
+    // Deleting the task closes the writer and finalises the file
+    state.task = nullptr;
+    state.finished = true;
+
+    if (cancelled) {
+        state.temporaryFile.deleteTemporaryFile();
+        return;
+    }
+
+    if (errorMessage.isNotEmpty()) {
+        juce::Logger::writeToLog("Render failed: " + errorMessage);
+        state.temporaryFile.deleteTemporaryFile();
+        return;
+    }
+
+    if (!state.temporaryFile.overwriteTargetFileWithTemporary()) {
+        juce::Logger::writeToLog("Unable to write render to " +
+                                 state.render.destFile.getFullPathName());
+        return;
+    }
+
+    state.succeeded = true;
+}
+
+EditRenderJob::Result EditRenderJob::getResult() const {
+    if (cancelled)
+        return Result::CANCELLED;
+
+    for (auto *state : renderStates)
+        if (!state->succeeded)
+            return Result::FAILED;
+
+    return Result::SUCCEEDED;
+}
+
+void EditRenderJob::timerCallback() {
+    bool allFinished = true;
+    for (auto *state : renderStates) {
+        if (state->finished)
+            continue;
+
+        if (isRunning(*state)) {
+            if (!threadPool->contains(state->task.get()))
+                finishRender(*state);
+        } else if (cancelled) {
+            state->finished = true;
+        } else if (canStart(*state)) {
+            startRender(*state);
+        }
+
+        allFinished = allFinished && state->finished;
+    }
+
+    if (!allFinished) {
+        auto progress = getProgress();
+        listeners.call(
+            [progress](Listener &l) { l.renderProgressChanged(progress); });
+        return;
+    }
+
+    stopTimer();
+    rendering = false;
+    renderEdit = nullptr;
+    auto result = getResult();
+    listeners.call([result](Listener &l) { l.renderFinished(result); });
+}
+
+} // namespace app_services
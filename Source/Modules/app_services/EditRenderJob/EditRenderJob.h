@@ -0,0 +1,110 @@
+#pragma once
+
+namespace app_services {
+
+// Renders some or all of an edit's tracks to WAV files, or FLAC files if the
+// destination has a .flac extension. Rendering happens in the background so
+// the UI and controller stay responsive while it runs. The renders use a copy
+// of the edit taken when the job starts, so the edit can still be played and
+// changed while they run. Renders run faster than real time on a pool of
+// worker threads. Renders that use different tracks are run at the same time,
+// renders that share a track wait for each other since a plugin can't be
+// processed by two renders at once. Each render is written to a temporary
+// file that only replaces its destination file once it has been completely
+// written, so a cancelled or failed render never leaves a partial file
+// behind. Listeners are told about the progress and the result on the
+// message thread.
+class EditRenderJob : private juce::Timer {
+  public:
+    enum class Result { SUCCEEDED, CANCELLED, FAILED };
+
+    struct Render {
+        juce::File destFile;
+        juce::BigInteger tracksToDo;
+        bool useMasterPlugins = true;
+    };
+
+    struct Options {
+        // Renders don't depend on the audio device's settings, so the same
+        // edit always renders to the same file
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+        int numThreads = juce::SystemStats::getNumCpus();
+        // Rendered after the end of the edit so effect tails aren't cut off
+        tracktion::TimeDuration tailLength;
+        // Called on the message thread with the copy of the edit that is
+        // rendered, before any of the renders start
+        std::function<void(tracktion::Edit &)> prepareEdit;
+    };
+
+    // Mixes the tracks down in to a single file
+    EditRenderJob(tracktion::Edit &e, const juce::File &destFile,
+                  const juce::BigInteger &tracksToDo);
+    EditRenderJob(tracktion::Edit &e, const juce::File &destFile,
+                  const juce::BigInteger &tracksToDo, const Options &options);
+    EditRenderJob(tracktion::Edit &e, const juce::Array<Render> &renders);
+    EditRenderJob(tracktion::Edit &e, const juce::Array<Render> &renders,
+                  const Options &options);
+    ~EditRenderJob() override;
+
+    // Returns a render for each audio track without the master plugins, plus
+    // a mixdown of all of them with the master plugins
+    static juce::Array<Render> getStemRenders(tracktion::Edit &edit,
+                                              const juce::File &directory);
+
+    void start();
+    void cancel();
+    bool isRendering() const;
+
+    float getProgress() const;
+    juce::Array<juce::File> getDestinationFiles() const;
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void renderProgressChanged(float progress) {}
+        virtual void renderFinished(Result result) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    static constexpr int progressIntervalMs = 100;
+
+    struct RenderState {
+        explicit RenderState(const Render &r)
+            : render(r), temporaryFile(r.destFile,
+                                       juce::TemporaryFile::useHiddenFile) {}
+
+        Render render;
+        juce::TemporaryFile temporaryFile;
+        std::unique_ptr<tracktion::Renderer::RenderTask> task;
+        bool finished = false;
+        bool succeeded = false;
+    };
+
+    tracktion::Edit &edit;
+    Options renderOptions;
+    // The copy of the edit being rendered, deleted once the renders finish
+    std::unique_ptr<tracktion::Edit> renderEdit;
+    juce::OwnedArray<RenderState> renderStates;
+    std::unique_ptr<juce::ThreadPool> threadPool;
+    bool cancelled = false;
+    bool rendering = false;
+    juce::ListenerList<Listener> listeners;
+
+    bool isRunning(const RenderState &state) const;
+    bool canStart(const RenderState &state) const;
+    void createRenderEdit();
+    void startRender(RenderState &state);
+    void finishRender(RenderState &state);
+    Result getResult() const;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditRenderJob)
+};
+
+} // namespace app_services
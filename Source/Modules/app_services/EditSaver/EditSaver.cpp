@@ -0,0 +1,168 @@
+#include "EditSaver.h"
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+EditSaver::EditSaver(tracktion::Edit &e, const juce::File &file,
+                     Format format)
+    : juce::Thread("EditSaver"), edit(e), editFile(file), fileFormat(format) {
+    ThreadPlacement::runOnAnyCore([this] { startThread(); });
+}
+
+EditSaver::~EditSaver() {
+    // The thread writes anything still pending before it exits
+    signalThreadShouldExit();
+    saveRequested.signal();
+    stopThread(10000);
+    cancelPendingUpdate();
+}
+
+void EditSaver::save() {
+    if (snapshotCallback)
+        snapshotCallback();
+
+    // Plugins only write their state back to the edit when asked to
+    edit.flushState();
+    auto state = edit.state.createCopy();
+    numSavesRequested++;
+
+    {
+        const juce::ScopedLock sl(pendingStateLock);
+        pendingState = state;
+        pendingSaveNumber = numSavesRequested;
+    }
+
+    saveRequested.signal();
+}
+
+bool EditSaver::isSaving() const {
+    if (writing)
+        return true;
+
+    const juce::ScopedLock sl(pendingStateLock);
+    return pendingState.isValid();
+}
+
+bool EditSaver::waitUntilSaved(int timeoutMs) {
+    const auto endTime =
+        juce::Time::getMillisecondCounter() + juce::uint32(timeoutMs);
+    while (isSaving()) {
+        if (juce::Time::getMillisecondCounter() >= endTime)
+            return false;
+
+        juce::Thread::sleep(10);
+    }
+
+    return true;
+}
+
+void EditSaver::setSnapshotCallback(std::function<void()> callback) {
+    snapshotCallback = std::move(callback);
+}
+
+bool EditSaver::writeEditState(const juce::ValueTree &state,
+                               const juce::File &file, Format format) {
+    std::unique_ptr<juce::XmlElement> xml;
+    if (format == Format::XML) {
+        xml = state.createXml();
+        if (xml == nullptr)
+            return false;
+    }
+
+    juce::TemporaryFile temporaryFile(file,
+                                      juce::TemporaryFile::useHiddenFile);
+    {
+        juce::FileOutputStream stream(temporaryFile.getFile());
+        if (!stream.openedOk())
+            return false;
+
+        if (xml != nullptr)
+            xml->writeTo(stream);
+        else if (!BinaryEditFile::write(state, stream))
+            return false;
+
+        stream.flush();
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    syncToDisk(temporaryFile.getFile());
+    if (!temporaryFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    // Make sure the rename itself has reached the disk
+    syncToDisk(file.getParentDirectory());
+    return true;
+}
+
+void EditSaver::addListener(Listener *l) { listeners.add(l); }
+
+void EditSaver::removeListener(Listener *l) { listeners.remove(l); }
+
+void EditSaver::syncToDisk(const juce::File &file) {
+#if JUCE_LINUX
+    auto fd = ::open(file.getFullPathName().toRawUTF8(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    juce::ignoreUnused(file);
+#endif
+}
+
+void EditSaver::run() {
+    while (true) {
+        saveRequested.wait(-1);
+
+        // Saves requested while one was being written are written before the
+        // thread checks whether it should exit, so none are dropped
+        while (writePendingState()) {
+        }
+
+        if (threadShouldExit())
+            break;
+    }
+}
+
+bool EditSaver::writePendingState() {
+    juce::ValueTree state;
+    int saveNumber = 0;
+    {
+        const juce::ScopedLock sl(pendingStateLock);
+        std::swap(state, pendingState);
+        saveNumber = pendingSaveNumber;
+        writing = state.isValid();
+    }
+
+    if (!state.isValid())
+        return false;
+
+    const auto success = writeEditState(state, editFile, fileFormat);
+    if (!success)
+        juce::Logger::writeToLog("Unable to save edit to " +
+                                 editFile.getFullPathName());
+
+    lastSaveSucceeded = success;
+    if (success)
+        lastSaveNumberWritten = saveNumber;
+
+    writing = false;
+    triggerAsyncUpdate();
+    return true;
+}
+
+void EditSaver::handleAsyncUpdate() {
+    // The edit is only unchanged once the latest save has reached the disk
+    const bool success = lastSaveSucceeded;
+    if (success && lastSaveNumberWritten == numSavesRequested)
+        edit.resetChangedStatus();
+
+    listeners.call([success](Listener &l) { l.editSaved(success); });
+}
+
+} // namespace app_services
@@ -0,0 +1,78 @@
+#pragma once
+
+namespace app_services {
+
+// Saves an edit without blocking the message thread. Saving takes a copy of
+// the edit's state on the message thread, which is only an in memory copy,
+// and a background thread then serialises it and writes it out. The file is
+// written to a temporary file, synced to disk and renamed over the edit file,
+// so a power cut during a save leaves either the old or the new edit behind
+// and never half of one. Saves that are requested while one is being written
+// are coalesced so only the most recent state gets written next. Listeners
+// are told when each write has finished on the message thread, which is also
+// when the edit is marked as unchanged, so a failed write leaves it marked as
+// changed. Any pending save is written before the saver is destroyed. Edits
+// can be written either as XML or in the BinaryEditFile format.
+class EditSaver : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    enum class Format { XML, BINARY };
+
+    EditSaver(tracktion::Edit &e, const juce::File &file,
+              Format format = Format::XML);
+    ~EditSaver() override;
+
+    void save();
+    bool isSaving() const;
+
+    // Blocks until every requested save has been written or the timeout
+    // has passed. Returns false if the timeout passed first.
+    bool waitUntilSaved(int timeoutMs);
+
+    // Called on the message thread just before the edit state is copied for
+    // a save, so anything that needs to line up with the saved state can be
+    // updated at the same time
+    void setSnapshotCallback(std::function<void()> callback);
+
+    static bool writeEditState(const juce::ValueTree &state,
+                               const juce::File &file,
+                               Format format = Format::XML);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void editSaved(bool success) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    tracktion::Edit &edit;
+    juce::File editFile;
+    Format fileFormat;
+    std::function<void()> snapshotCallback;
+
+    juce::CriticalSection pendingStateLock;
+    juce::ValueTree pendingState;
+    int pendingSaveNumber = 0;
+    // Only used on the message thread
+    int numSavesRequested = 0;
+    std::atomic<int> lastSaveNumberWritten{0};
+    juce::WaitableEvent saveRequested;
+    std::atomic<bool> writing{false};
+    std::atomic<bool> lastSaveSucceeded{true};
+    juce::ListenerList<Listener> listeners;
+
+    static void syncToDisk(const juce::File &file);
+
+    // Writes the most recent pending state, returns false if there wasn't one
+    bool writePendingState();
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditSaver)
+};
+
+} // namespace app_services
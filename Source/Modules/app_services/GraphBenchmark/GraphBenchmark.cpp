@@ -0,0 +1,159 @@
+#include "GraphBenchmark.h"
+
+namespace app_services {
+
+double GraphBenchmark::Result::getThroughput() const {
+    return averageLoad > 0.0 ? 1.0 / averageLoad : 0.0;
+}
+
+juce::String GraphBenchmark::Result::describePlacement() const {
+    return "audio cores " + ThreadPlacement::describeCoreMask(audioCores) +
+           ", GUI cores " + ThreadPlacement::describeCoreMask(guiCores) +
+           ", real time " + (realtimeAudio ? "on" : "off");
+}
+
+GraphBenchmark::GraphBenchmark(tracktion::Edit &e, AudioCallbackMonitor &m,
+                               const juce::Array<int> &counts,
+                               int msPerConfig,
+                               const ThreadPlacement *placement)
+    : edit(e), monitor(m), threadCounts(counts),
+      msPerConfiguration(msPerConfig), threadPlacement(placement) {
+    monitor.addListener(this);
+}
+
+GraphBenchmark::~GraphBenchmark() {
+    stopTimer();
+    monitor.removeListener(this);
+}
+
+void GraphBenchmark::start() {
+    if (running || threadCounts.isEmpty())
+        return;
+
+    auto &transport = edit.getTransport();
+    originalLooping = transport.looping;
+    originalLoopRange = transport.getLoopRange();
+    if (auto behaviour = getEngineBehaviour())
+        originalNumThreads = behaviour->getNumAudioThreads();
+
+    // Loop the whole edit so every configuration plays the same material
+    auto length = edit.getLength();
+    if (length <= tracktion::TimeDuration())
+        length = tracktion::TimeDuration::fromSeconds(4.0);
+    transport.setLoopRange({tracktion::TimePosition(), length});
+    transport.looping.setValue(true, nullptr);
+
+    running = true;
+    configurationIndex = 0;
+    results.clear();
+    startConfiguration();
+    startTimer(100);
+}
+
+AppEngineBehaviour *GraphBenchmark::getEngineBehaviour() {
+    return dynamic_cast<AppEngineBehaviour *>(
+        &edit.engine.getEngineBehaviour());
+}
+
+void GraphBenchmark::startConfiguration() {
+    auto &transport = edit.getTransport();
+    transport.stop(false, false);
+
+    if (auto behaviour = getEngineBehaviour())
+        behaviour->setNumAudioThreads(threadCounts[configurationIndex]);
+    AppEngineBehaviour::reallocateContext(edit);
+
+    transport.setPosition(tracktion::TimePosition());
+    transport.play(false);
+
+    const auto &stats = monitor.getStats();
+    lastNumDropouts = stats.numLateCallbacks + stats.numXruns;
+    loadTotal = 0.0;
+    numUpdates = 0;
+    configurationStartMs = juce::Time::getMillisecondCounter();
+
+    Result result;
+    result.numThreads = threadCounts[configurationIndex];
+    if (threadPlacement != nullptr) {
+        result.audioCores = threadPlacement->getAudioCores();
+        result.guiCores = threadPlacement->getGuiCores();
+        result.realtimeAudio = threadPlacement->isRealtimeAudio();
+    }
+    results.add(result);
+}
+
+void GraphBenchmark::finishConfiguration() {
+    auto &result = results.getReference(results.size() - 1);
+    result.averageLoad = numUpdates > 0 ? loadTotal / numUpdates : 0.0;
+
+    juce::Logger::writeToLog(
+        "Benchmarked " + juce::String(result.numThreads) +
+        " audio threads (" + result.describePlacement() +
+        "): " + juce::String(result.getThroughput(), 2) + "x real time");
+
+    if (++configurationIndex < threadCounts.size())
+        startConfiguration();
+    else
+        finish();
+}
+
+void GraphBenchmark::finish() {
+    stopTimer();
+    running = false;
+
+    auto &transport = edit.getTransport();
+    transport.stop(false, false);
+    transport.setLoopRange(originalLoopRange);
+    transport.looping.setValue(originalLooping, nullptr);
+
+    if (auto behaviour = getEngineBehaviour())
+        behaviour->setNumAudioThreads(originalNumThreads);
+    AppEngineBehaviour::reallocateContext(edit);
+
+    if (onFinished)
+        onFinished();
+}
+
+juce::String GraphBenchmark::createReport() const {
+    juce::String report = "Audio graph benchmark\n";
+    for (const auto &result : results)
+        report << juce::String(result.numThreads).paddedLeft(' ', 3)
+               << " threads: "
+               << juce::String(result.getThroughput(), 2).paddedLeft(' ', 7)
+               << "x real time, load "
+               << juce::roundToInt(result.averageLoad * 100.0) << "%, peak "
+               << juce::roundToInt(result.peakLoad * 100.0) << "%, "
+               << result.numDropouts << " dropouts, "
+               << result.describePlacement() << "\n";
+
+    return report;
+}
+
+void GraphBenchmark::audioCallbackStatsChanged(
+    const AudioCallbackMonitor::Stats &stats) {
+    if (!running || results.isEmpty())
+        return;
+
+    const auto numDropouts = stats.numLateCallbacks + stats.numXruns;
+    const auto newDropouts = numDropouts - lastNumDropouts;
+    lastNumDropouts = numDropouts;
+
+    // Starting playback and allocating the graph aren't counted
+    if (juce::Time::getMillisecondCounter() - configurationStartMs <
+        juce::uint32(settleMs))
+        return;
+
+    auto &result = results.getReference(results.size() - 1);
+    result.peakLoad = juce::jmax(result.peakLoad, stats.peakLoad);
+    result.numDropouts += juce::jmax(0, newDropouts);
+    loadTotal += stats.load;
+    numUpdates++;
+}
+
+void GraphBenchmark::timerCallback() {
+    if (juce::Time::getMillisecondCounter() - configurationStartMs >=
+        juce::uint32(settleMs + msPerConfiguration))
+        finishConfiguration();
+}
+
+} // namespace app_services
@@ -0,0 +1,75 @@
+#pragma once
+
+namespace app_services {
+
+// Plays the edit once for each number of audio threads and measures the
+// audio callback load, so the best setting for a set can be found on the
+// device itself. Each configuration gets a second to settle before it is
+// measured. The edit's loop and thread settings are put back afterwards.
+// Each result records where the audio and GUI threads were placed, so runs
+// made with different placements can be compared.
+class GraphBenchmark : private AudioCallbackMonitor::Listener,
+                       private juce::Timer {
+  public:
+    struct Result {
+        int numThreads = 0;
+        juce::uint32 audioCores = 0;
+        juce::uint32 guiCores = 0;
+        bool realtimeAudio = false;
+        double averageLoad = 0.0;
+        double peakLoad = 0.0;
+        int numDropouts = 0;
+
+        // How many times faster than real time the graph was processed
+        double getThroughput() const;
+        juce::String describePlacement() const;
+    };
+
+    GraphBenchmark(tracktion::Edit &e, AudioCallbackMonitor &m,
+                   const juce::Array<int> &threadCounts,
+                   int msPerConfiguration = 10000,
+                   const ThreadPlacement *placement = nullptr);
+    ~GraphBenchmark() override;
+
+    void start();
+    bool isRunning() const { return running; }
+
+    const juce::Array<Result> &getResults() const { return results; }
+    juce::String createReport() const;
+
+    std::function<void()> onFinished;
+
+  private:
+    static constexpr int settleMs = 1000;
+
+    tracktion::Edit &edit;
+    AudioCallbackMonitor &monitor;
+    juce::Array<int> threadCounts;
+    int msPerConfiguration;
+    const ThreadPlacement *threadPlacement;
+
+    bool running = false;
+    int configurationIndex = 0;
+    juce::uint32 configurationStartMs = 0;
+    int lastNumDropouts = 0;
+    double loadTotal = 0.0;
+    int numUpdates = 0;
+    juce::Array<Result> results;
+
+    int originalNumThreads = 0;
+    bool originalLooping = false;
+    tracktion::TimeRange originalLoopRange;
+
+    AppEngineBehaviour *getEngineBehaviour();
+    void startConfiguration();
+    void finishConfiguration();
+    void finish();
+
+    void audioCallbackStatsChanged(
+        const AudioCallbackMonitor::Stats &stats) override;
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GraphBenchmark)
+};
+
+} // namespace app_services
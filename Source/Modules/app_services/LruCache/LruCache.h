@@ -0,0 +1,81 @@
+#pragma once
+
+namespace app_services {
+
+// Owns up to a fixed number of values and deletes the least recently used one
+// when a new value is added to a full cache. Looking up or inserting a value
+// marks it as the most recently used. Lookups, inserts and removals are all
+// constant time apart from the map lookup.
+template <typename Key, typename Value> class LruCache {
+  public:
+    explicit LruCache(size_t maxSize)
+        : capacity(juce::jmax(size_t(1), maxSize)) {}
+
+    // Returns nullptr if there is no value for the key
+    Value *find(const Key &key) {
+        auto it = index.find(key);
+        if (it == index.end())
+            return nullptr;
+
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second.get();
+    }
+
+    bool contains(const Key &key) const { return index.count(key) > 0; }
+
+    // Replaces any existing value for the key
+    Value &insert(const Key &key, std::unique_ptr<Value> value) {
+        remove(key);
+
+        if (entries.size() >= capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+
+        entries.emplace_front(key, std::move(value));
+        index[key] = entries.begin();
+        return *entries.front().second;
+    }
+
+    bool remove(const Key &key) {
+        auto it = index.find(key);
+        if (it == index.end())
+            return false;
+
+        entries.erase(it->second);
+        index.erase(it);
+        return true;
+    }
+
+    // Removes every value whose key the predicate returns true for
+    template <typename Predicate> void removeIf(Predicate shouldRemove) {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (shouldRemove(it->first)) {
+                index.erase(it->first);
+                it = entries.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        index.clear();
+    }
+
+    size_t size() const { return entries.size(); }
+    size_t getCapacity() const { return capacity; }
+
+  private:
+    using Entry = std::pair<Key, std::unique_ptr<Value>>;
+
+    size_t capacity;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::map<Key, typename std::list<Entry>::iterator> index;
+
+    JUCE_DECLARE_NON_COPYABLE(LruCache)
+};
+
+} // namespace app_services
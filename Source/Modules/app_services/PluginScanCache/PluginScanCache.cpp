@@ -0,0 +1,212 @@
+#include "PluginScanCache.h"
+
+namespace app_services {
+
+namespace {
+const juce::Identifier PLUGIN_SCAN_CACHE("PLUGIN_SCAN_CACHE");
+const juce::Identifier BUNDLES("BUNDLES");
+const juce::Identifier BUNDLE("BUNDLE");
+const juce::Identifier bundlePath("path");
+const juce::Identifier bundleSize("size");
+const juce::Identifier bundleModificationTime("modificationTime");
+} // namespace
+
+PluginScanCache::PluginScanCache(tracktion::Engine &e,
+                                 const juce::File &file,
+                                 const juce::FileSearchPath &paths,
+                                 const juce::File &scannerExecutable)
+    : juce::Thread("PluginScanCache"), engine(e), cacheFile(file),
+      searchPath(paths), childProcessScanner(scannerExecutable) {
+    loadCache();
+}
+
+PluginScanCache::~PluginScanCache() {
+    // A plugin can take a while to load, so give it a chance to finish
+    stopThread(10000);
+}
+
+void PluginScanCache::startScan() {
+    if (!isThreadRunning())
+        ThreadPlacement::runOnAnyCore([this] { startThread(); });
+}
+
+bool PluginScanCache::isScanning() const { return isThreadRunning(); }
+
+void PluginScanCache::loadCache() {
+    auto xml = juce::parseXML(cacheFile);
+    if (xml == nullptr || !xml->hasTagName(PLUGIN_SCAN_CACHE.toString()))
+        return;
+
+    auto &knownPluginList = engine.getPluginManager().knownPluginList;
+    if (auto *pluginsXml = xml->getChildByName("KNOWNPLUGINS"))
+        knownPluginList.recreateFromXml(*pluginsXml);
+
+    if (auto *bundlesXml = xml->getChildByName(BUNDLES.toString()))
+        for (auto *bundleXml :
+             bundlesXml->getChildWithTagNameIterator(BUNDLE.toString()))
+            cachedBundles[bundleXml->getStringAttribute(bundlePath)] = {
+                bundleXml->getStringAttribute(bundleSize).getLargeIntValue(),
+                bundleXml->getStringAttribute(bundleModificationTime)
+                    .getLargeIntValue()};
+
+    juce::Logger::writeToLog(
+        "Loaded " + juce::String(knownPluginList.getNumTypes()) +
+        " plugins from " + cacheFile.getFullPathName());
+}
+
+void PluginScanCache::saveCache(
+    const std::map<juce::String, BundleInfo> &bundles) {
+    juce::XmlElement xml(PLUGIN_SCAN_CACHE);
+    if (auto pluginsXml =
+            engine.getPluginManager().knownPluginList.createXml())
+        xml.addChildElement(pluginsXml.release());
+
+    auto *bundlesXml = xml.createNewChildElement(BUNDLES);
+    for (const auto &bundle : bundles) {
+        auto *bundleXml = bundlesXml->createNewChildElement(BUNDLE);
+        bundleXml->setAttribute(bundlePath, bundle.first);
+        bundleXml->setAttribute(bundleSize, juce::String(bundle.second.size));
+        bundleXml->setAttribute(bundleModificationTime,
+                                juce::String(bundle.second.modificationTime));
+    }
+
+    cacheFile.getParentDirectory().createDirectory();
+    if (!xml.writeTo(cacheFile))
+        juce::Logger::writeToLog("Unable to write plugin scan cache " +
+                                 cacheFile.getFullPathName());
+}
+
+void PluginScanCache::scanFormat(juce::AudioPluginFormat &format,
+                                 std::map<juce::String, BundleInfo> &bundles) {
+    auto &knownPluginList = engine.getPluginManager().knownPluginList;
+    const auto files = format.searchPathsForPlugins(searchPath, true, true);
+
+    // Forget about plugins whose bundles have gone
+    for (const auto &type : knownPluginList.getTypes())
+        if (type.pluginFormatName == format.getName() &&
+            !files.contains(type.fileOrIdentifier))
+            knownPluginList.removeType(type);
+
+    // Bundles that have changed have to be scanned again, even if they
+    // previously failed to load
+    for (const auto &file : files) {
+        const auto info = getBundleInfo(juce::File(file));
+        bundles[file] = info;
+
+        auto cached = cachedBundles.find(file);
+        if (cached == cachedBundles.end() || !(cached->second == info)) {
+            removeTypesForFile(file);
+            knownPluginList.removeFromBlacklist(file);
+        }
+    }
+
+    if (childProcessScanner.isAvailable())
+        scanInChildProcesses(format, files);
+    else
+        scanInProcess(format);
+}
+
+void PluginScanCache::scanInChildProcesses(juce::AudioPluginFormat &format,
+                                           const juce::StringArray &files) {
+    auto &knownPluginList = engine.getPluginManager().knownPluginList;
+    const auto blacklist = knownPluginList.getBlacklistedFiles();
+
+    juce::StringArray filesToScan;
+    for (const auto &file : files)
+        if (!blacklist.contains(file) &&
+            !knownPluginList.isListingUpToDate(file, format))
+            filesToScan.add(file);
+
+    childProcessScanner.scan(
+        format.getName(), filesToScan,
+        [&knownPluginList](const ChildProcessPluginScanner::Result &result) {
+            // A scan that crashed or timed out keeps the plugins it found
+            // before then, but the file isn't scanned again until it changes
+            for (auto *type : result.types) {
+                juce::Logger::writeToLog("scanned " + type->name);
+                knownPluginList.addType(*type);
+            }
+
+            if (!result.succeeded()) {
+                juce::Logger::writeToLog(
+                    "Unable to scan plugin " + result.fileOrIdentifier +
+                    (result.timedOut  ? " (timed out)"
+                     : result.crashed ? " (crashed)"
+                                      : ""));
+                knownPluginList.addToBlacklist(result.fileOrIdentifier);
+            }
+        },
+        [this] { return threadShouldExit(); });
+}
+
+void PluginScanCache::scanInProcess(juce::AudioPluginFormat &format) {
+    auto &knownPluginList = engine.getPluginManager().knownPluginList;
+    juce::PluginDirectoryScanner scanner(
+        knownPluginList, format, searchPath, true,
+        engine.getTemporaryFileManager().getTempFile(
+            "PluginScanDeadMansPedal"));
+
+    juce::String pluginBeingScanned;
+    while (!threadShouldExit() &&
+           scanner.scanNextFile(true, pluginBeingScanned))
+        juce::Logger::writeToLog("scanned " + pluginBeingScanned);
+
+    // Blacklist anything that failed so it isn't retried until it changes
+    for (const auto &file : scanner.getFailedFiles()) {
+        juce::Logger::writeToLog("Unable to scan plugin " + file);
+        knownPluginList.addToBlacklist(file);
+    }
+}
+
+void PluginScanCache::removeTypesForFile(const juce::String &fileOrIdentifier) {
+    auto &knownPluginList = engine.getPluginManager().knownPluginList;
+    for (const auto &type : knownPluginList.getTypes())
+        if (type.fileOrIdentifier == fileOrIdentifier)
+            knownPluginList.removeType(type);
+}
+
+PluginScanCache::BundleInfo
+PluginScanCache::getBundleInfo(const juce::File &bundle) {
+    BundleInfo info;
+    info.modificationTime = bundle.getLastModificationTime().toMilliseconds();
+
+    if (!bundle.isDirectory()) {
+        info.size = bundle.getSize();
+        return info;
+    }
+
+    // VST3 plugins are usually bundle directories, so look at what is in them
+    for (const auto &entry : juce::RangedDirectoryIterator(
+             bundle, true, "*", juce::File::findFiles)) {
+        info.size += entry.getFileSize();
+        info.modificationTime =
+            juce::jmax(info.modificationTime,
+                       entry.getModificationTime().toMilliseconds());
+    }
+
+    return info;
+}
+
+void PluginScanCache::run() {
+    const auto startTime = juce::Time::getMillisecondCounter();
+
+    std::map<juce::String, BundleInfo> bundles;
+    for (auto *format :
+         engine.getPluginManager().pluginFormatManager.getFormats())
+        if (format->getName() == "VST3")
+            scanFormat(*format, bundles);
+
+    if (threadShouldExit())
+        return;
+
+    saveCache(bundles);
+    cachedBundles = std::move(bundles);
+
+    juce::Logger::writeToLog(
+        "Plugin scan found " +
+        juce::String(engine.getPluginManager().knownPluginList.getNumTypes()) +
+        " plugins in " +
+        juce::String(juce::Time::getMillisecondCounter() - startTime) + "ms");
+}
+
+} // namespace app_services
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps the engine's known plugin list in a cache file so it doesn't have to
+// be rebuilt every time the app starts or the plugin browser is opened. The
+// cached list is loaded straight away, then a background scan only rescans
+// bundles that are new or whose size or modification time has changed, and
+// drops plugins whose bundles have been removed. Bundles are scanned out of
+// process by the ChildProcessPluginScanner when it has been installed, and
+// in this process otherwise. The cache file is updated once the scan has
+// finished.
+class PluginScanCache : private juce::Thread {
+  public:
+    PluginScanCache(tracktion::Engine &e, const juce::File &cacheFile,
+                    const juce::FileSearchPath &searchPath,
+                    const juce::File &scannerExecutable =
+                        ChildProcessPluginScanner::getDefaultExecutable());
+    ~PluginScanCache() override;
+
+    void startScan();
+    bool isScanning() const;
+
+  private:
+    struct BundleInfo {
+        juce::int64 size = 0;
+        juce::int64 modificationTime = 0;
+
+        bool operator==(const BundleInfo &other) const {
+            return size == other.size &&
+                   modificationTime == other.modificationTime;
+        }
+    };
+
+    tracktion::Engine &engine;
+    juce::File cacheFile;
+    juce::FileSearchPath searchPath;
+    std::map<juce::String, BundleInfo> cachedBundles;
+    ChildProcessPluginScanner childProcessScanner;
+
+    void loadCache();
+    void saveCache(const std::map<juce::String, BundleInfo> &bundles);
+    void scanFormat(juce::AudioPluginFormat &format,
+                    std::map<juce::String, BundleInfo> &bundles);
+    void scanInChildProcesses(juce::AudioPluginFormat &format,
+                              const juce::StringArray &files);
+    void scanInProcess(juce::AudioPluginFormat &format);
+    void removeTypesForFile(const juce::String &fileOrIdentifier);
+
+    static BundleInfo getBundleInfo(const juce::File &bundle);
+
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginScanCache)
+};
+
+} // namespace app_services
@@ -0,0 +1,230 @@
+#include "PluginWarmPool.h"
+
+#if JUCE_LINUX
+#include <unistd.h>
+#endif
+
+namespace app_services {
+
+PluginWarmPool::PluginWarmPool(tracktion::Edit &e, size_t memoryBudgetInBytes)
+    : juce::Thread("PluginWarmPool"), edit(e),
+      memoryBudget(memoryBudgetInBytes) {
+    if (isEnabled())
+        ThreadPlacement::runOnAnyCore([this] { startThread(); });
+}
+
+PluginWarmPool::~PluginWarmPool() {
+    signalThreadShouldExit();
+    notify();
+    stopThread(5000);
+    cancelPendingUpdate();
+}
+
+void PluginWarmPool::request(const juce::String &xmlType,
+                             const juce::PluginDescription &description) {
+    if (!isEnabled() || !isWorthWarming(xmlType))
+        return;
+
+    const auto key = getKey(description);
+    auto entry = findEntry(key);
+    if (entry != entries.end()) {
+        entry->lastUsed = juce::Time::getMillisecondCounter();
+        return;
+    }
+
+    {
+        const juce::ScopedLock sl(requestLock);
+        pendingRequest =
+            std::make_unique<Request>(Request{xmlType, description});
+    }
+
+    // A plugin that was about to be created is no longer wanted
+    cancelPendingUpdate();
+    notify();
+}
+
+tracktion::Plugin::Ptr
+PluginWarmPool::take(const juce::String &xmlType,
+                     const juce::PluginDescription &description) {
+    if (!isEnabled())
+        return nullptr;
+
+    tracktion::Plugin::Ptr plugin;
+    auto entry = findEntry(getKey(description));
+    if (entry != entries.end()) {
+        plugin = entry->plugin;
+        memoryUsage -= entry->size;
+        entries.erase(entry);
+    }
+
+    // Warm another one in case it is used again
+    request(xmlType, description);
+    return plugin;
+}
+
+bool PluginWarmPool::isWorthWarming(const juce::String &xmlType) {
+    return xmlType == tracktion::ExternalPlugin::xmlTypeName;
+}
+
+bool PluginWarmPool::isEnabled() const { return memoryBudget > 0; }
+
+int PluginWarmPool::getNumWarmPlugins() const { return int(entries.size()); }
+
+size_t PluginWarmPool::getMemoryUsage() const { return memoryUsage; }
+
+juce::String
+PluginWarmPool::getKey(const juce::PluginDescription &description) {
+    return description.createIdentifierString();
+}
+
+size_t PluginWarmPool::getResidentMemory() {
+#if JUCE_LINUX
+    // The second field is the number of resident pages
+    auto fields = juce::StringArray::fromTokens(
+        juce::File("/proc/self/statm").loadFileAsString(), false);
+    if (fields.size() > 1)
+        return size_t(fields[1].getLargeIntValue()) *
+               size_t(sysconf(_SC_PAGESIZE));
+#endif
+
+    return 0;
+}
+
+std::vector<PluginWarmPool::Entry>::iterator
+PluginWarmPool::findEntry(const juce::String &key) {
+    return std::find_if(
+        entries.begin(), entries.end(),
+        [&key](const Entry &entry) { return entry.key == key; });
+}
+
+std::unique_ptr<juce::DynamicLibrary>
+PluginWarmPool::loadBinary(const juce::PluginDescription &description) {
+    if (!juce::File::isAbsolutePath(description.fileOrIdentifier))
+        return nullptr;
+
+    // VST3 plugins are bundles with the binary inside
+    juce::File binaryFile(description.fileOrIdentifier);
+    if (binaryFile.isDirectory()) {
+        const auto binaries = binaryFile.findChildFiles(
+            juce::File::TypesOfFileToFind::findFiles, true, "*.so");
+        if (binaries.isEmpty())
+            return nullptr;
+
+        binaryFile = binaries.getFirst();
+    }
+
+    if (!binaryFile.hasFileExtension(".so"))
+        return nullptr;
+
+    auto binary = std::make_unique<juce::DynamicLibrary>();
+    if (!binary->open(binaryFile.getFullPathName()))
+        return nullptr;
+
+    return binary;
+}
+
+void PluginWarmPool::warm(const Request &request, size_t memoryBefore) {
+    auto plugin = edit.getPluginCache().createNewPlugin(request.xmlType,
+                                                        request.description);
+    if (plugin == nullptr)
+        return;
+
+    // External plugins only load their binary once they are fully initialised
+    plugin->initialiseFully();
+
+    const auto memoryAfter = getResidentMemory();
+    const auto size = memoryAfter > memoryBefore ? memoryAfter - memoryBefore
+                                                 : defaultPluginSize;
+    if (size > memoryBudget) {
+        juce::Logger::writeToLog(request.description.name +
+                                 " is too large to keep warm");
+        return;
+    }
+
+    evictToFit(size);
+    entries.push_back({getKey(request.description), plugin, size,
+                       juce::Time::getMillisecondCounter()});
+    memoryUsage += size;
+}
+
+void PluginWarmPool::evictToFit(size_t size) {
+    while (!entries.empty() && memoryUsage + size > memoryBudget) {
+        auto leastRecentlyUsed = std::min_element(
+            entries.begin(), entries.end(),
+            [](const Entry &first, const Entry &second) {
+                return first.lastUsed < second.lastUsed;
+            });
+
+        memoryUsage -= leastRecentlyUsed->size;
+        entries.erase(leastRecentlyUsed);
+    }
+}
+
+void PluginWarmPool::run() {
+    while (!threadShouldExit()) {
+        wait(-1);
+
+        // Wait for the requests to settle, so the plugins that are only
+        // passed over while scrolling through the browser aren't loaded
+        while (!threadShouldExit() && wait(settleTimeMs)) {
+        }
+
+        if (threadShouldExit())
+            break;
+
+        juce::PluginDescription description;
+        {
+            const juce::ScopedLock sl(requestLock);
+            if (pendingRequest == nullptr)
+                continue;
+
+            description = pendingRequest->description;
+        }
+
+        const auto key = getKey(description);
+        const auto memoryBefore = getResidentMemory();
+        auto binary = loadBinary(description);
+
+        {
+            // A newer request came in while loading, this thread has already
+            // been notified about it
+            const juce::ScopedLock sl(requestLock);
+            if (pendingRequest == nullptr ||
+                getKey(pendingRequest->description) != key)
+                continue;
+
+            loadedBinary = std::move(binary);
+            loadedKey = key;
+            memoryBeforeLoading = memoryBefore;
+        }
+
+        triggerAsyncUpdate();
+    }
+}
+
+void PluginWarmPool::handleAsyncUpdate() {
+    std::unique_ptr<Request> request;
+    size_t memoryBefore = 0;
+    {
+        const juce::ScopedLock sl(requestLock);
+        if (pendingRequest == nullptr ||
+            getKey(pendingRequest->description) != loadedKey)
+            return;
+
+        request = std::move(pendingRequest);
+        memoryBefore = memoryBeforeLoading;
+    }
+
+    const auto key = getKey(request->description);
+    if (findEntry(key) == entries.end())
+        warm(*request, memoryBefore);
+
+    // The plugin holds on to its own binary once it has been created
+    const juce::ScopedLock sl(requestLock);
+    if (loadedKey == key) {
+        loadedBinary = nullptr;
+        loadedKey = {};
+    }
+}
+
+} // namespace app_services
@@ -0,0 +1,84 @@
+#pragma once
+
+namespace app_services {
+
+// Creates and fully initialises external plugins ahead of time so adding one
+// to a track doesn't have to wait for its binary to be loaded. Plugins are
+// warmed when they are highlighted in the plugin browser, and recently used
+// plugins are warmed again after being taken so the next insertion is also
+// instant. Only the latest request is kept, so scrolling through the browser
+// doesn't load every plugin on the way. Once the requests settle, the
+// plugin's binary is loaded on a background thread and then the plugin is
+// created on the message thread, since tracktion plugins can only be created
+// there. The least recently used plugins are dropped to keep the memory they
+// use within the budget. A budget of 0 disables the pool.
+class PluginWarmPool : private juce::Thread, private juce::AsyncUpdater {
+  public:
+    PluginWarmPool(tracktion::Edit &e, size_t memoryBudgetInBytes);
+    ~PluginWarmPool() override;
+
+    // Queues a plugin to be warmed, replacing any request that hasn't been
+    // warmed yet
+    void request(const juce::String &xmlType,
+                 const juce::PluginDescription &description);
+
+    // Returns a warm instance of the plugin and starts warming another one,
+    // or returns nullptr if there isn't one
+    tracktion::Plugin::Ptr take(const juce::String &xmlType,
+                                const juce::PluginDescription &description);
+
+    // Only external plugins take long enough to create to be worth warming
+    static bool isWorthWarming(const juce::String &xmlType);
+
+    bool isEnabled() const;
+    int getNumWarmPlugins() const;
+    size_t getMemoryUsage() const;
+
+  private:
+    struct Request {
+        juce::String xmlType;
+        juce::PluginDescription description;
+    };
+
+    struct Entry {
+        juce::String key;
+        tracktion::Plugin::Ptr plugin;
+        size_t size = 0;
+        juce::uint32 lastUsed = 0;
+    };
+
+    // Used when the memory a plugin uses can't be measured
+    static constexpr size_t defaultPluginSize = 32 * 1024 * 1024;
+
+    // How long the requests have to stop changing before one is warmed
+    static constexpr int settleTimeMs = 250;
+
+    tracktion::Edit &edit;
+    size_t memoryBudget;
+    size_t memoryUsage = 0;
+    std::vector<Entry> entries;
+
+    // The background thread loads the binary for the pending request, which
+    // is kept open until the plugin has been created on the message thread
+    juce::CriticalSection requestLock;
+    std::unique_ptr<Request> pendingRequest;
+    std::unique_ptr<juce::DynamicLibrary> loadedBinary;
+    juce::String loadedKey;
+    size_t memoryBeforeLoading = 0;
+
+    static juce::String getKey(const juce::PluginDescription &description);
+    static size_t getResidentMemory();
+    static std::unique_ptr<juce::DynamicLibrary>
+    loadBinary(const juce::PluginDescription &description);
+
+    std::vector<Entry>::iterator findEntry(const juce::String &key);
+    void warm(const Request &request, size_t memoryBefore);
+    void evictToFit(size_t size);
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginWarmPool)
+};
+
+} // namespace app_services
@@ -0,0 +1,225 @@
+#include "SampleLibraryIndex.h"
+
+namespace app_services {
+
+namespace {
+struct EntryComparator {
+    static int compareElements(const SampleLibraryIndex::Entry &first,
+                               const SampleLibraryIndex::Entry &second) {
+        return first.file.getFileName().compareNatural(
+            second.file.getFileName());
+    }
+};
+} // namespace
+
+SampleLibraryIndex::SampleLibraryIndex(const juce::File &sourceDir,
+                                       const juce::File &mirrorDir,
+                                       bool scanInBackground)
+    : juce::Thread("SampleLibraryIndex"), sourceDirectory(sourceDir),
+      mirrorDirectory(mirrorDir), watcher(sourceDir) {
+    formatManager.registerBasicFormats();
+
+    // Listening starts before the scan so no changes are missed
+    watcher.addListener(this);
+    if (scanInBackground) {
+        scanning = true;
+        ThreadPlacement::runOnAnyCore([this] { startThread(); });
+    } else {
+        setEntries(readEntries());
+    }
+}
+
+SampleLibraryIndex::~SampleLibraryIndex() {
+    watcher.removeListener(this);
+    stopThread(5000);
+    cancelPendingUpdate();
+}
+
+int SampleLibraryIndex::size() const { return entries.size(); }
+
+const SampleLibraryIndex::Entry &SampleLibraryIndex::getEntry(int index) const {
+    if (juce::isPositiveAndBelow(index, entries.size()))
+        return entries.getReference(index);
+
+    return emptyEntry;
+}
+
+juce::File SampleLibraryIndex::getFile(int index) const {
+    return getEntry(index).file;
+}
+
+int SampleLibraryIndex::indexOf(const juce::File &file) const {
+    for (int i = 0; i < entries.size(); i++)
+        if (entries.getReference(i).file == file)
+            return i;
+
+    return -1;
+}
+
+juce::StringArray SampleLibraryIndex::getNames() const { return names; }
+
+void SampleLibraryIndex::addListener(Listener *l) { listeners.add(l); }
+
+void SampleLibraryIndex::removeListener(Listener *l) { listeners.remove(l); }
+
+juce::File SampleLibraryIndex::getIndexedDirectory() const {
+    return mirrorDirectory == juce::File() ? sourceDirectory : mirrorDirectory;
+}
+
+juce::Array<SampleLibraryIndex::Entry> SampleLibraryIndex::readEntries() {
+    juce::Array<Entry> newEntries;
+    for (const auto &file : getIndexedDirectory().findChildFiles(
+             juce::File::TypesOfFileToFind::findFiles, false)) {
+        if (threadShouldExit())
+            break;
+
+        Entry entry;
+        if (readEntry(file, entry))
+            newEntries.add(entry);
+    }
+
+    EntryComparator comparator;
+    newEntries.sort(comparator, true);
+    return newEntries;
+}
+
+void SampleLibraryIndex::setEntries(juce::Array<Entry> newEntries) {
+    entries.swapWith(newEntries);
+    updateNames();
+
+    juce::Logger::writeToLog("Indexed " + juce::String(entries.size()) +
+                             " samples in " +
+                             getIndexedDirectory().getFullPathName());
+}
+
+bool SampleLibraryIndex::readEntry(const juce::File &file, Entry &entry) {
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    if (reader == nullptr)
+        return false;
+
+    entry.file = file;
+    entry.name = file.getFileNameWithoutExtension();
+    entry.numChannels = int(reader->numChannels);
+    entry.sampleRate = reader->sampleRate;
+    entry.lengthInSeconds =
+        reader->sampleRate > 0.0
+            ? double(reader->lengthInSamples) / reader->sampleRate
+            : 0.0;
+
+    // WAV files store the root note in their sampler chunk
+    entry.rootNote =
+        reader->metadataValues.getValue("MidiUnityNote", "60").getIntValue();
+    return true;
+}
+
+void SampleLibraryIndex::addOrUpdateEntry(const juce::File &file) {
+    Entry entry;
+    if (!readEntry(file, entry))
+        return;
+
+    removeEntry(file);
+    entries.insert(findInsertionIndex(file.getFileName()), entry);
+}
+
+bool SampleLibraryIndex::removeEntry(const juce::File &file) {
+    auto index = indexOf(file);
+    if (index == -1)
+        return false;
+
+    entries.remove(index);
+    return true;
+}
+
+int SampleLibraryIndex::findInsertionIndex(const juce::String &name) const {
+    // binary search for the first entry that sorts after the given name
+    int start = 0;
+    int end = entries.size();
+    while (start < end) {
+        auto middle = (start + end) / 2;
+        if (entries.getReference(middle).file.getFileName().compareNatural(
+                name) <= 0)
+            start = middle + 1;
+        else
+            end = middle;
+    }
+
+    return start;
+}
+
+void SampleLibraryIndex::updateNames() {
+    names.clearQuick();
+    for (const auto &entry : entries)
+        names.add(entry.name);
+}
+
+bool SampleLibraryIndex::applyChange(const juce::File &indexedFile,
+                                     DirectoryWatcher::FileEvent event) {
+    if (event == DirectoryWatcher::FileEvent::CREATED_OR_MODIFIED) {
+        addOrUpdateEntry(indexedFile);
+        return indexOf(indexedFile) != -1;
+    }
+
+    return removeEntry(indexedFile);
+}
+
+void SampleLibraryIndex::fileChanged(const juce::File &file,
+                                     DirectoryWatcher::FileEvent event) {
+    auto indexedFile = file;
+    if (mirrorDirectory != juce::File())
+        indexedFile = mirrorDirectory.getChildFile(file.getFileName());
+
+    if (event == DirectoryWatcher::FileEvent::CREATED_OR_MODIFIED) {
+        if (indexedFile != file && !file.copyFileTo(indexedFile)) {
+            juce::Logger::writeToLog("Attempt to copy sample " +
+                                     file.getFullPathName() + " failed!");
+            return;
+        }
+    } else if (indexedFile != file) {
+        indexedFile.deleteFile();
+    }
+
+    // The scan may or may not have seen the change, applying it afterwards
+    // gives the same result either way
+    if (scanning) {
+        pendingChanges.add({indexedFile, event});
+        return;
+    }
+
+    if (applyChange(indexedFile, event)) {
+        updateNames();
+        listeners.call([](Listener &l) { l.sampleLibraryChanged(); });
+    }
+}
+
+void SampleLibraryIndex::run() {
+    auto newEntries = readEntries();
+    if (threadShouldExit())
+        return;
+
+    {
+        const juce::ScopedLock sl(scannedEntriesLock);
+        scannedEntries.swapWith(newEntries);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void SampleLibraryIndex::handleAsyncUpdate() {
+    juce::Array<Entry> newEntries;
+    {
+        const juce::ScopedLock sl(scannedEntriesLock);
+        newEntries.swapWith(scannedEntries);
+    }
+
+    scanning = false;
+    setEntries(std::move(newEntries));
+    for (const auto &change : pendingChanges)
+        applyChange(change.file, change.event);
+
+    pendingChanges.clear();
+    updateNames();
+    listeners.call([](Listener &l) { l.sampleLibraryChanged(); });
+}
+
+} // namespace app_services
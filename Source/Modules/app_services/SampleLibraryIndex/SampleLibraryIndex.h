@@ -0,0 +1,96 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps a sorted list of the audio files in a sample directory along with
+// some basic metadata about each one. The directory is only scanned once,
+// after that the index is kept up to date incrementally using the events
+// from a DirectoryWatcher. If a mirror directory is given, the watched
+// directory is treated as the source of truth and any changes are mirrored
+// into it. The entries then refer to the mirrored copies of the files.
+//
+// The index is made and used on the message thread. Scanning reads the
+// header of every file, so it can be done on a background thread instead, in
+// which case the index is empty until the scan has finished and listeners are
+// told once it has. Files that change during the scan are applied after it.
+class SampleLibraryIndex : private DirectoryWatcher::Listener,
+                           private juce::Thread,
+                           private juce::AsyncUpdater {
+  public:
+    struct Entry {
+        juce::File file;
+        juce::String name;
+        double lengthInSeconds = 0.0;
+        int numChannels = 0;
+        double sampleRate = 0.0;
+        int rootNote = 60;
+    };
+
+    explicit SampleLibraryIndex(const juce::File &sourceDir,
+                                const juce::File &mirrorDir = juce::File(),
+                                bool scanInBackground = false);
+    ~SampleLibraryIndex() override;
+
+    bool isScanning() const { return scanning; }
+
+    int size() const;
+    const Entry &getEntry(int index) const;
+    juce::File getFile(int index) const;
+    int indexOf(const juce::File &file) const;
+    juce::StringArray getNames() const;
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void sampleLibraryChanged() {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    struct PendingChange {
+        juce::File file;
+        DirectoryWatcher::FileEvent event;
+    };
+
+    juce::File sourceDirectory;
+    juce::File mirrorDirectory;
+    juce::AudioFormatManager formatManager;
+    juce::Array<Entry> entries;
+    juce::StringArray names;
+    DirectoryWatcher watcher;
+    juce::ListenerList<Listener> listeners;
+
+    bool scanning = false;
+    // Changes made while scanning, applied once the scan has finished
+    juce::Array<PendingChange> pendingChanges;
+    // Handed from the scanning thread to the message thread
+    juce::CriticalSection scannedEntriesLock;
+    juce::Array<Entry> scannedEntries;
+
+    // Returned for out of range lookups
+    const Entry emptyEntry;
+
+    juce::File getIndexedDirectory() const;
+    juce::Array<Entry> readEntries();
+    void setEntries(juce::Array<Entry> newEntries);
+    bool readEntry(const juce::File &file, Entry &entry);
+    void addOrUpdateEntry(const juce::File &file);
+    bool removeEntry(const juce::File &file);
+    int findInsertionIndex(const juce::String &name) const;
+    void updateNames();
+
+    bool applyChange(const juce::File &indexedFile,
+                     DirectoryWatcher::FileEvent event);
+
+    void fileChanged(const juce::File &file,
+                     DirectoryWatcher::FileEvent event) override;
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleLibraryIndex)
+};
+
+} // namespace app_services
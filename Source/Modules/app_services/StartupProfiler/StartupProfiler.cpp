@@ -0,0 +1,51 @@
+#include "StartupProfiler.h"
+
+namespace app_services {
+
+StartupProfiler::StartupProfiler()
+    : startTimeMs(juce::Time::getMillisecondCounterHiRes()) {}
+
+void StartupProfiler::startPhase(const juce::String &name) {
+    endPhase();
+
+    phases.add({name, getElapsedMs(), 0.0});
+    phaseRunning = true;
+}
+
+void StartupProfiler::endPhase() {
+    if (!phaseRunning)
+        return;
+
+    auto &phase = phases.getReference(phases.size() - 1);
+    phase.durationMs = getElapsedMs() - phase.startMs;
+    phaseRunning = false;
+}
+
+void StartupProfiler::mark(const juce::String &name) {
+    endPhase();
+    phases.add({name, getElapsedMs(), 0.0});
+}
+
+double StartupProfiler::getElapsedMs() const {
+    return juce::Time::getMillisecondCounterHiRes() - startTimeMs;
+}
+
+juce::String StartupProfiler::createReport() const {
+    juce::String report = "Startup trace:";
+    for (const auto &phase : phases) {
+        report << juce::newLine << "  "
+               << juce::String(phase.startMs, 1).paddedLeft(' ', 9) << " ms  "
+               << phase.name;
+
+        if (phase.durationMs > 0.0)
+            report << " (" << juce::String(phase.durationMs, 1) << " ms)";
+    }
+
+    return report;
+}
+
+void StartupProfiler::writeToLog() const {
+    juce::Logger::writeToLog(createReport());
+}
+
+} // namespace app_services
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace app_services {
+
+// Times each phase of startup so slow phases show up in the log. Phases are
+// timed one after another, starting a phase ends the one before it. Times are
+// measured from when the profiler was created.
+class StartupProfiler {
+  public:
+    struct Phase {
+        juce::String name;
+        double startMs = 0.0;
+        double durationMs = 0.0;
+    };
+
+    StartupProfiler();
+
+    void startPhase(const juce::String &name);
+    void endPhase();
+
+    // Records a point in time rather than a phase, such as the UI being ready
+    void mark(const juce::String &name);
+
+    double getElapsedMs() const;
+    const juce::Array<Phase> &getPhases() const { return phases; }
+
+    juce::String createReport() const;
+    void writeToLog() const;
+
+  private:
+    double startTimeMs;
+    juce::Array<Phase> phases;
+    bool phaseRunning = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StartupProfiler)
+};
+
+} // namespace app_services
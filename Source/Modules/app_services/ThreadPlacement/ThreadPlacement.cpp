@@ -0,0 +1,175 @@
+#include "ThreadPlacement.h"
+
+#if JUCE_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace app_services {
+
+namespace {
+// Below the priorities JACK and the kernel's own threads usually use
+const int realtimePriority = 70;
+} // namespace
+
+ThreadPlacement::ThreadPlacement(juce::AudioDeviceManager &dm)
+    : deviceManager(dm) {
+    deviceManager.addAudioCallback(this);
+}
+
+ThreadPlacement::~ThreadPlacement() {
+    deviceManager.removeAudioCallback(this);
+    cancelPendingUpdate();
+}
+
+void ThreadPlacement::setAudioCores(juce::uint32 mask) {
+    audioCores = mask;
+    audioThreadNeedsPlacement = true;
+}
+
+void ThreadPlacement::setGuiCores(juce::uint32 mask) {
+    guiCores = mask;
+    if (!setCurrentThreadCores(mask))
+        juce::Logger::writeToLog(
+            "Unable to place the message thread on cores " +
+            describeCoreMask(mask));
+}
+
+void ThreadPlacement::setRealtimeAudio(bool shouldUseRealtime) {
+    realtimeAudio = shouldUseRealtime;
+    audioThreadNeedsPlacement = true;
+}
+
+void ThreadPlacement::runWithAudioPlacement(
+    const std::function<void()> &function) {
+#if JUCE_LINUX
+    cpu_set_t previousCores;
+    const auto gotCores =
+        sched_getaffinity(0, sizeof(previousCores), &previousCores) == 0;
+    int previousPolicy = SCHED_OTHER;
+    sched_param previousParam{};
+    pthread_getschedparam(pthread_self(), &previousPolicy, &previousParam);
+
+    setCurrentThreadCores(audioCores);
+    setCurrentThreadRealtime(realtimeAudio);
+
+    function();
+
+    if (gotCores)
+        sched_setaffinity(0, sizeof(previousCores), &previousCores);
+    pthread_setschedparam(pthread_self(), previousPolicy, &previousParam);
+#else
+    function();
+#endif
+}
+
+void ThreadPlacement::runOnAnyCore(const std::function<void()> &function) {
+#if JUCE_LINUX
+    cpu_set_t previousCores;
+    const auto gotCores =
+        sched_getaffinity(0, sizeof(previousCores), &previousCores) == 0;
+
+    setCurrentThreadCores(0);
+    function();
+
+    if (gotCores)
+        sched_setaffinity(0, sizeof(previousCores), &previousCores);
+#else
+    function();
+#endif
+}
+
+juce::uint32 ThreadPlacement::getCoreMask(const juce::Array<int> &cores) {
+    juce::uint32 mask = 0;
+    for (auto core : cores)
+        if (juce::isPositiveAndBelow(core, juce::SystemStats::getNumCpus()) &&
+            core < 32)
+            mask |= juce::uint32(1) << core;
+
+    return mask;
+}
+
+juce::String ThreadPlacement::describeCoreMask(juce::uint32 mask) {
+    if (mask == 0)
+        return "any";
+
+    juce::StringArray cores;
+    for (int core = 0; core < 32; core++)
+        if ((mask & (juce::uint32(1) << core)) != 0)
+            cores.add(juce::String(core));
+
+    return cores.joinIntoString(",");
+}
+
+bool ThreadPlacement::setCurrentThreadCores(juce::uint32 mask) {
+#if JUCE_LINUX
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (int core = 0; core < juce::SystemStats::getNumCpus(); core++)
+        if (mask == 0 || (core < 32 && (mask & (juce::uint32(1) << core))))
+            CPU_SET(core, &cores);
+
+    return sched_setaffinity(0, sizeof(cores), &cores) == 0;
+#else
+    juce::ignoreUnused(mask);
+    return false;
+#endif
+}
+
+bool ThreadPlacement::setCurrentThreadRealtime(bool shouldUseRealtime) {
+#if JUCE_LINUX
+    sched_param param{};
+    if (!shouldUseRealtime)
+        return pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) == 0;
+
+    param.sched_priority =
+        juce::jlimit(sched_get_priority_min(SCHED_FIFO),
+                     sched_get_priority_max(SCHED_FIFO), realtimePriority);
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+    juce::ignoreUnused(shouldUseRealtime);
+    return false;
+#endif
+}
+
+void ThreadPlacement::audioDeviceIOCallbackWithContext(
+    const float *const *, int, float *const *outputChannelData,
+    int numOutputChannels, int numSamples,
+    const juce::AudioIODeviceCallbackContext &) {
+    for (int i = 0; i < numOutputChannels; i++)
+        if (outputChannelData[i] != nullptr)
+            juce::FloatVectorOperations::clear(outputChannelData[i],
+                                               numSamples);
+
+    // The system calls only happen once each time the placement changes
+    if (!audioThreadNeedsPlacement.exchange(false))
+        return;
+
+    // Real time scheduling is turned off again as well as on
+    auto placedOk = setCurrentThreadCores(audioCores);
+    placedOk = setCurrentThreadRealtime(realtimeAudio) && placedOk;
+
+    audioThreadPlacedOk = placedOk;
+    triggerAsyncUpdate();
+}
+
+void ThreadPlacement::audioDeviceAboutToStart(juce::AudioIODevice *) {
+    // A restarted device may call back on a new thread
+    audioThreadNeedsPlacement = true;
+}
+
+void ThreadPlacement::audioDeviceStopped() {}
+
+void ThreadPlacement::handleAsyncUpdate() {
+    juce::String placement = "cores " + describeCoreMask(audioCores) +
+                             (realtimeAudio ? " with real time scheduling"
+                                            : "");
+    if (audioThreadPlacedOk)
+        juce::Logger::writeToLog("Audio thread placed on " + placement);
+    else
+        juce::Logger::writeToLog("Unable to place the audio thread on " +
+                                 placement +
+                                 ", the system may not allow it");
+}
+
+} // namespace app_services
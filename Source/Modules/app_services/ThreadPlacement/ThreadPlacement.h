@@ -0,0 +1,76 @@
+#pragma once
+
+namespace app_services {
+
+// Keeps the audio and GUI threads off each other's cores. On a Raspberry Pi
+// the message thread can otherwise take time away from the audio threads
+// while it repaints.
+//
+// The audio device's thread places itself the first time it calls back
+// after the device starts, so it picks up any change to the placement on
+// its next callback. tracktion's graph worker threads are started when an
+// edit's playback context is allocated, so the context is allocated inside
+// runWithAudioPlacement and the workers inherit the placement from the
+// thread that starts them. Real time scheduling is only applied where the
+// system allows it, otherwise the threads keep their normal priority. Turning
+// it off puts the audio thread back on normal scheduling.
+//
+// Any other thread started by the message thread would inherit the GUI
+// cores, so background threads are started inside runOnAnyCore. Modules
+// that can't use this class give their threads an affinity mask instead.
+//
+// Only Linux is supported, on other platforms nothing is changed.
+class ThreadPlacement : private juce::AudioIODeviceCallback,
+                        private juce::AsyncUpdater {
+  public:
+    explicit ThreadPlacement(juce::AudioDeviceManager &dm);
+    ~ThreadPlacement() override;
+
+    // A mask of 0 lets the threads run on any core
+    void setAudioCores(juce::uint32 mask);
+    juce::uint32 getAudioCores() const { return audioCores; }
+    // Places the calling thread, which should be the message thread
+    void setGuiCores(juce::uint32 mask);
+    juce::uint32 getGuiCores() const { return guiCores; }
+    void setRealtimeAudio(bool shouldUseRealtime);
+    bool isRealtimeAudio() const { return realtimeAudio; }
+
+    // Runs the function with the calling thread placed like an audio thread,
+    // then puts it back the way it was
+    void runWithAudioPlacement(const std::function<void()> &function);
+
+    // Runs the function with the calling thread allowed on any core, then
+    // puts it back the way it was
+    static void runOnAnyCore(const std::function<void()> &function);
+
+    static juce::uint32 getCoreMask(const juce::Array<int> &cores);
+    static juce::String describeCoreMask(juce::uint32 mask);
+
+    // These return false if the system didn't allow the change
+    static bool setCurrentThreadCores(juce::uint32 mask);
+    static bool setCurrentThreadRealtime(bool shouldUseRealtime);
+
+  private:
+    juce::AudioDeviceManager &deviceManager;
+    std::atomic<juce::uint32> audioCores{0};
+    juce::uint32 guiCores = 0;
+    std::atomic<bool> realtimeAudio{false};
+
+    // Set on the message thread, cleared by the audio thread once placed
+    std::atomic<bool> audioThreadNeedsPlacement{true};
+    std::atomic<bool> audioThreadPlacedOk{true};
+
+    void audioDeviceIOCallbackWithContext(
+        const float *const *inputChannelData, int numInputChannels,
+        float *const *outputChannelData, int numOutputChannels,
+        int numSamples,
+        const juce::AudioIODeviceCallbackContext &context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice *device) override;
+    void audioDeviceStopped() override;
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ThreadPlacement)
+};
+
+} // namespace app_services
@@ -0,0 +1,200 @@
+#include "TrackFreezer.h"
+
+namespace app_services {
+
+namespace {
+const juce::Identifier FROZEN_TRACK("FROZEN_TRACK");
+const juce::Identifier FROZEN_PLUGIN("FROZEN_PLUGIN");
+const juce::Identifier pluginIndex("index");
+const juce::Identifier freezeClipID("clipID");
+const juce::Identifier mutedClipIDs("mutedClips");
+} // namespace
+
+TrackFreezer::TrackFreezer(tracktion::Edit &e) : edit(e) {}
+
+TrackFreezer::~TrackFreezer() = default;
+
+bool TrackFreezer::isFrozen(const tracktion::AudioTrack &track) {
+    return track.state.getChildWithName(FROZEN_TRACK).isValid();
+}
+
+bool TrackFreezer::isFreezing() const { return freezingTrack != nullptr; }
+
+void TrackFreezer::freeze(tracktion::AudioTrack::Ptr track) {
+    if (track == nullptr || isFreezing() || isFrozen(*track))
+        return;
+
+    const auto trackID = track->itemID;
+    EditRenderJob::Options options;
+    options.sampleRate = edit.engine.getDeviceManager().getSampleRate();
+    options.numThreads = 1;
+    options.tailLength = getTailLength(*track);
+
+    // The mixer plugins are still applied to the frozen track while it plays,
+    // so they mustn't be rendered in to the freeze file as well. They are
+    // only turned off in the copy of the edit that is rendered.
+    options.prepareEdit = [trackID](tracktion::Edit &renderEdit) {
+        if (auto renderTrack = dynamic_cast<tracktion::AudioTrack *>(
+                tracktion::findTrackForID(renderEdit, trackID)))
+            for (auto plugin : renderTrack->pluginList.getPlugins())
+                if (isMixerPlugin(*plugin))
+                    plugin->setEnabled(false);
+    };
+
+    juce::BigInteger tracksToDo;
+    tracksToDo.setBit(tracktion::getAllTracks(edit).indexOf(track.get()));
+
+    freezingTrack = track;
+    freezeLength = edit.getLength() + options.tailLength;
+    renderJob = std::make_unique<EditRenderJob>(
+        edit,
+        juce::Array<EditRenderJob::Render>{
+            {getFreezeFile(*track), tracksToDo, false}},
+        options);
+    renderJob->addListener(this);
+    renderJob->start();
+}
+
+void TrackFreezer::unfreeze(tracktion::AudioTrack::Ptr track) {
+    if (track == nullptr || !isFrozen(*track))
+        return;
+
+    auto frozenState = track->state.getChildWithName(FROZEN_TRACK);
+
+    // Copied since removing the freeze clip changes the track's clips
+    auto clips = track->getClips();
+    for (auto clip : clips) {
+        auto clipID = juce::int64(clip->itemID.getRawID());
+        if (clipID == juce::int64(frozenState[freezeClipID]))
+            clip->removeFromParent();
+    }
+
+    auto mutedClips =
+        juce::StringArray::fromTokens(frozenState[mutedClipIDs].toString(),
+                                      ",", "");
+    for (auto clip : track->getClips())
+        if (mutedClips.contains(juce::String(clip->itemID.getRawID())))
+            clip->setMuted(false);
+
+    for (const auto &frozenPlugin : frozenState) {
+        if (frozenPlugin.hasType(FROZEN_PLUGIN))
+            track->pluginList.insertPlugin(
+                frozenPlugin.getChild(0).createCopy(),
+                frozenPlugin[pluginIndex]);
+    }
+
+    track->state.removeChild(frozenState, nullptr);
+    getFreezeFile(*track).deleteFile();
+
+    juce::Logger::writeToLog("Unfroze " + track->getName());
+}
+
+juce::File
+TrackFreezer::getFreezeFile(const tracktion::AudioTrack &track) const {
+    // Freeze files are kept next to the edit so they are still there when it
+    // is reloaded
+    auto editFile = tracktion::EditFileOperations(edit).getEditFile();
+    auto directory =
+        editFile == juce::File()
+            ? edit.engine.getTemporaryFileManager().getTempDirectory()
+            : editFile.getSiblingFile(editFile.getFileNameWithoutExtension() +
+                                      "_freeze");
+
+    return directory.getChildFile(
+        "track_" + juce::String(track.itemID.getRawID()) + ".wav");
+}
+
+void TrackFreezer::addListener(Listener *l) { listeners.add(l); }
+
+void TrackFreezer::removeListener(Listener *l) { listeners.remove(l); }
+
+bool TrackFreezer::isMixerPlugin(const tracktion::Plugin &plugin) {
+    return dynamic_cast<const tracktion::VolumeAndPanPlugin *>(&plugin) !=
+               nullptr ||
+           dynamic_cast<const tracktion::LevelMeterPlugin *>(&plugin) !=
+               nullptr;
+}
+
+tracktion::TimeDuration
+TrackFreezer::getTailLength(tracktion::AudioTrack &track) {
+    auto tailSeconds = minTailSeconds;
+    for (auto plugin : track.pluginList.getPlugins())
+        if (plugin->isEnabled() && !isMixerPlugin(*plugin))
+            tailSeconds = juce::jmax(tailSeconds, plugin->getTailLength());
+
+    return tracktion::TimeDuration::fromSeconds(
+        juce::jmin(tailSeconds, maxTailSeconds));
+}
+
+void TrackFreezer::applyFreeze(tracktion::AudioTrack &track) {
+    juce::ValueTree frozenState(FROZEN_TRACK);
+
+    // Keep a copy of each plugin so it can be put back, then remove it so it
+    // is unloaded
+    auto plugins = track.pluginList.getPlugins();
+    for (int i = plugins.size(); --i >= 0;) {
+        if (isMixerPlugin(*plugins[i]))
+            continue;
+
+        // Plugins only write their state back to the edit when asked to
+        plugins[i]->flushPluginStateToValueTree();
+
+        juce::ValueTree frozenPlugin(FROZEN_PLUGIN);
+        frozenPlugin.setProperty(pluginIndex, i, nullptr);
+        frozenPlugin.appendChild(plugins[i]->state.createCopy(), nullptr);
+
+        // Plugins are restored in order, so the first one goes first
+        frozenState.addChild(frozenPlugin, 0, nullptr);
+        plugins[i]->deleteFromParent();
+    }
+
+    juce::StringArray mutedClips;
+    for (auto clip : track.getClips()) {
+        if (!clip->isMuted()) {
+            clip->setMuted(true);
+            mutedClips.add(juce::String(clip->itemID.getRawID()));
+        }
+    }
+
+    frozenState.setProperty(mutedClipIDs, mutedClips.joinIntoString(","),
+                            nullptr);
+
+    auto freezeClip = track.insertWaveClip(
+        track.getName() + " (frozen)", getFreezeFile(track),
+        {{tracktion::TimePosition(), freezeLength}, {}}, false);
+    if (freezeClip != nullptr)
+        frozenState.setProperty(
+            freezeClipID, juce::int64(freezeClip->itemID.getRawID()), nullptr);
+
+    track.state.appendChild(frozenState, nullptr);
+}
+
+void TrackFreezer::renderFinished(EditRenderJob::Result result) {
+    auto track = freezingTrack;
+    freezingTrack = nullptr;
+
+    // The track is kept alive while it renders, but it may have been deleted
+    // from the edit in the meantime
+    if (!track->isPartOfEdit()) {
+        juce::Logger::writeToLog(track->getName() +
+                                 " was deleted before it could be frozen");
+        getFreezeFile(*track).deleteFile();
+        listeners.call(
+            [&track](Listener &l) { l.freezeFinished(track.get(), false); });
+        return;
+    }
+
+    const bool success = result == EditRenderJob::Result::SUCCEEDED;
+    if (success) {
+        applyFreeze(*track);
+        juce::Logger::writeToLog("Froze " + track->getName());
+    } else {
+        juce::Logger::writeToLog("Unable to freeze " + track->getName());
+    }
+
+    listeners.call([&track, success](Listener &l) {
+        l.freezeFinished(track.get(), success);
+    });
+}
+
+} // namespace app_services
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace app_services {
+
+// Freezes audio tracks to cut the CPU and memory their plugins use. Freezing
+// renders the track's instrument and effects to a file in the background,
+// then unloads the plugins, mutes the track's clips and plays the rendered
+// file back in a clip instead. The removed plugins are kept in the track's
+// state so unfreezing can put them back exactly as they were, which also
+// means a frozen track stays frozen when the edit is saved and reloaded.
+// The track's volume and pan are left in place so it can still be mixed
+// while frozen. The render carries on past the end of the edit for long
+// enough to catch the tails of reverbs and delays.
+class TrackFreezer : private EditRenderJob::Listener {
+  public:
+    explicit TrackFreezer(tracktion::Edit &e);
+    ~TrackFreezer() override;
+
+    static bool isFrozen(const tracktion::AudioTrack &track);
+    bool isFreezing() const;
+
+    // Freezing happens in the background, listeners are told once the track
+    // has been frozen. If the track is deleted before then, the freeze fails.
+    void freeze(tracktion::AudioTrack::Ptr track);
+    void unfreeze(tracktion::AudioTrack::Ptr track);
+
+    juce::File getFreezeFile(const tracktion::AudioTrack &track) const;
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void freezeFinished(tracktion::AudioTrack *track,
+                                    bool success) {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    tracktion::Edit &edit;
+    tracktion::AudioTrack::Ptr freezingTrack;
+    std::unique_ptr<EditRenderJob> renderJob;
+    tracktion::TimeDuration freezeLength;
+    juce::ListenerList<Listener> listeners;
+
+    // Tails longer than this are cut off, since some plugins report an
+    // infinite tail
+    static constexpr double maxTailSeconds = 30.0;
+    static constexpr double minTailSeconds = 2.0;
+
+    // The volume and pan plugins stay on the track while it is frozen
+    static bool isMixerPlugin(const tracktion::Plugin &plugin);
+    static tracktion::TimeDuration getTailLength(tracktion::AudioTrack &track);
+    void applyFreeze(tracktion::AudioTrack &track);
+
+    void renderFinished(EditRenderJob::Result result) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackFreezer)
+};
+
+} // namespace app_services
@@ -5,4 +5,55 @@
 #include "MidiCommandManager/MidiCommandManager.cpp"
 
 // TimelineCamera
-#include "TimelineCamera/TimelineCamera.cpp"
\ No newline at end of file
+#include "TimelineCamera/TimelineCamera.cpp"
+
+// DirectoryWatcher
+#include "DirectoryWatcher/DirectoryWatcher.cpp"
+
+// SampleLibraryIndex
+#include "SampleLibraryIndex/SampleLibraryIndex.cpp"
+
+// ChildProcessPluginScanner
+#include "ChildProcessPluginScanner/ChildProcessPluginScanner.cpp"
+
+// PluginScanCache
+#include "PluginScanCache/PluginScanCache.cpp"
+
+// PluginWarmPool
+#include "PluginWarmPool/PluginWarmPool.cpp"
+
+// EditRenderJob
+#include "EditRenderJob/EditRenderJob.cpp"
+
+// TrackFreezer
+#include "TrackFreezer/TrackFreezer.cpp"
+
+// BinaryEditFile
+#include "BinaryEditFile/BinaryEditFile.cpp"
+
+// EditSaver
+#include "EditSaver/EditSaver.cpp"
+
+// EditJournal
+#include "EditJournal/EditJournal.cpp"
+
+// StartupProfiler
+#include "StartupProfiler/StartupProfiler.cpp"
+
+// DeferredTaskQueue
+#include "DeferredTaskQueue/DeferredTaskQueue.cpp"
+
+// AppEngineBehaviour
+#include "AppEngineBehaviour/AppEngineBehaviour.cpp"
+
+// AudioCallbackMonitor
+#include "AudioCallbackMonitor/AudioCallbackMonitor.cpp"
+
+// BufferSizeGovernor
+#include "BufferSizeGovernor/BufferSizeGovernor.cpp"
+
+// ThreadPlacement
+#include "ThreadPlacement/ThreadPlacement.cpp"
+
+// GraphBenchmark
+#include "GraphBenchmark/GraphBenchmark.cpp"
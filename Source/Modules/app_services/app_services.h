@@ -8,7 +8,7 @@
   description:      Service classes for app
   website:          http://github.com/stonepreston
   license:          GPL-3.0
-  dependencies:     juce_data_structures juce_events juce_core juce_graphics juce_gui_basics tracktion_engine
+  dependencies:     juce_data_structures juce_events juce_core juce_graphics juce_gui_basics juce_audio_formats juce_audio_processors tracktion_engine
  END_JUCE_MODULE_DECLARATION
 *******************************************************************************/
 
@@ -18,6 +18,24 @@ namespace app_services {
 
     class MidiCommandManager;
     class TimelineCamera;
+    class DirectoryWatcher;
+    class SampleLibraryIndex;
+    class ChildProcessPluginScanner;
+    class PluginScanCache;
+    class PluginWarmPool;
+    template <typename Key, typename Value> class LruCache;
+    class EditRenderJob;
+    class TrackFreezer;
+    class BinaryEditFile;
+    class EditSaver;
+    class EditJournal;
+    class StartupProfiler;
+    class DeferredTaskQueue;
+    class AppEngineBehaviour;
+    class AudioCallbackMonitor;
+    class BufferSizeGovernor;
+    class ThreadPlacement;
+    class GraphBenchmark;
 
 }
 
@@ -25,8 +43,15 @@ namespace app_services {
 #include <juce_events/juce_events.h>
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <list>
+#include <map>
 
 // MidiCommandManager
 #include "MidiCommandManager/MidiCommandManager.h"
@@ -34,3 +59,57 @@ namespace app_services {
 
 // TimelineCamera
 #include "TimelineCamera/TimelineCamera.h"
+
+// DirectoryWatcher
+#include "DirectoryWatcher/DirectoryWatcher.h"
+
+// SampleLibraryIndex
+#include "SampleLibraryIndex/SampleLibraryIndex.h"
+
+// ChildProcessPluginScanner
+#include "ChildProcessPluginScanner/ChildProcessPluginScanner.h"
+
+// PluginScanCache
+#include "PluginScanCache/PluginScanCache.h"
+
+// PluginWarmPool
+#include "PluginWarmPool/PluginWarmPool.h"
+
+// LruCache
+#include "LruCache/LruCache.h"
+
+// EditRenderJob
+#include "EditRenderJob/EditRenderJob.h"
+
+// TrackFreezer
+#include "TrackFreezer/TrackFreezer.h"
+
+// BinaryEditFile
+#include "BinaryEditFile/BinaryEditFile.h"
+
+// EditSaver
+#include "EditSaver/EditSaver.h"
+
+// EditJournal
+#include "EditJournal/EditJournal.h"
+
+// StartupProfiler
+#include "StartupProfiler/StartupProfiler.h"
+
+// DeferredTaskQueue
+#include "DeferredTaskQueue/DeferredTaskQueue.h"
+
+// AppEngineBehaviour
+#include "AppEngineBehaviour/AppEngineBehaviour.h"
+
+// AudioCallbackMonitor
+#include "AudioCallbackMonitor/AudioCallbackMonitor.h"
+
+// BufferSizeGovernor
+#include "BufferSizeGovernor/BufferSizeGovernor.h"
+
+// ThreadPlacement
+#include "ThreadPlacement/ThreadPlacement.h"
+
+// GraphBenchmark
+#include "GraphBenchmark/GraphBenchmark.h"
@@ -0,0 +1,84 @@
+namespace app_view_models {
+
+void DspLoadViewModel::PeakHoldValue::update(double value,
+                                             juce::uint32 nowMs) {
+    current = value;
+    if (value >= peak || nowMs - peakTimeMs > holdTimeMs) {
+        peak = value;
+        peakTimeMs = nowMs;
+    }
+}
+
+DspLoadViewModel::DspLoadViewModel(tracktion::Track::Ptr t) : track(t) {
+    startTimer(pollIntervalMs);
+}
+
+DspLoadViewModel::~DspLoadViewModel() { stopTimer(); }
+
+double DspLoadViewModel::getTrackLoad() const { return trackLoad.current; }
+
+double DspLoadViewModel::getTrackPeakLoad() const { return trackLoad.peak; }
+
+double
+DspLoadViewModel::getPluginLoad(const tracktion::Plugin *plugin) const {
+    if (auto load = findPluginLoad(plugin))
+        return load->current;
+
+    return 0.0;
+}
+
+double
+DspLoadViewModel::getPluginPeakLoad(const tracktion::Plugin *plugin) const {
+    if (auto load = findPluginLoad(plugin))
+        return load->peak;
+
+    return 0.0;
+}
+
+juce::String DspLoadViewModel::formatLoad(double load) {
+    return juce::String(juce::roundToInt(load * 100.0)) + "%";
+}
+
+void DspLoadViewModel::addListener(Listener *l) {
+    listeners.add(l);
+    l->dspLoadChanged();
+}
+
+void DspLoadViewModel::removeListener(Listener *l) { listeners.remove(l); }
+
+const DspLoadViewModel::PeakHoldValue *
+DspLoadViewModel::findPluginLoad(const tracktion::Plugin *plugin) const {
+    if (plugin == nullptr)
+        return nullptr;
+
+    auto load = pluginLoads.find(plugin->itemID.getRawID());
+    return load != pluginLoads.end() ? &load->second : nullptr;
+}
+
+void DspLoadViewModel::timerCallback() {
+    const auto nowMs = juce::Time::getMillisecondCounter();
+
+    std::map<juce::uint64, PeakHoldValue> newPluginLoads;
+    double total = 0.0;
+    for (auto plugin : track->pluginList.getPlugins()) {
+        // The engine only measures plugins while they are being processed
+        const auto load = plugin->isEnabled() ? plugin->getCpuUsage() : 0.0;
+        total += load;
+
+        // Carry on from the previous value so the peak is held
+        const auto id = plugin->itemID.getRawID();
+        auto previous = pluginLoads.find(id);
+        auto &value = newPluginLoads[id];
+        if (previous != pluginLoads.end())
+            value = previous->second;
+
+        value.update(load, nowMs);
+    }
+
+    trackLoad.update(total, nowMs);
+    pluginLoads.swap(newPluginLoads);
+
+    listeners.call([](Listener &l) { l.dspLoadChanged(); });
+}
+
+} // namespace app_view_models
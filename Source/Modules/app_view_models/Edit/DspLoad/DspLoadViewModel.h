@@ -0,0 +1,57 @@
+#pragma once
+
+namespace app_view_models {
+
+// Reports how much of the audio block time a track and each of its plugins
+// is using. The engine measures the time each plugin spends processing on
+// the audio thread and stores it atomically, so reading it here doesn't need
+// any locks. Loads are polled a few times a second and listeners are told
+// when they change. Each load also has a peak that is held for a couple of
+// seconds so short spikes can still be seen.
+class DspLoadViewModel : private juce::Timer {
+  public:
+    struct PeakHoldValue {
+        static constexpr juce::uint32 holdTimeMs = 2000;
+
+        double current = 0.0;
+        double peak = 0.0;
+        juce::uint32 peakTimeMs = 0;
+
+        void update(double value, juce::uint32 nowMs);
+    };
+
+    explicit DspLoadViewModel(tracktion::Track::Ptr t);
+    ~DspLoadViewModel() override;
+
+    // Loads are proportions of the block time, so 1.0 is the whole budget
+    double getTrackLoad() const;
+    double getTrackPeakLoad() const;
+    double getPluginLoad(const tracktion::Plugin *plugin) const;
+    double getPluginPeakLoad(const tracktion::Plugin *plugin) const;
+
+    static juce::String formatLoad(double load);
+
+    class Listener {
+      public:
+        virtual ~Listener() = default;
+
+        virtual void dspLoadChanged() {}
+    };
+
+    void addListener(Listener *l);
+    void removeListener(Listener *l);
+
+  private:
+    static constexpr int pollIntervalMs = 250;
+
+    tracktion::Track::Ptr track;
+    PeakHoldValue trackLoad;
+    std::map<juce::uint64, PeakHoldValue> pluginLoads;
+    juce::ListenerList<Listener> listeners;
+
+    const PeakHoldValue *findPluginLoad(const tracktion::Plugin *plugin) const;
+
+    void timerCallback() override;
+};
+
+} // namespace app_view_models
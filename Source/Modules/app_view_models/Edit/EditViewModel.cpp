@@ -2,9 +2,11 @@
 
 namespace app_view_models {
 
-EditViewModel::EditViewModel(tracktion::Edit &e)
-    : edit(e), state(edit.state.getOrCreateChildWithName(IDs::EDIT_VIEW_STATE,
-                                                         nullptr)) {
+EditViewModel::EditViewModel(tracktion::Edit &e,
+                             app_services::EditSaver *saver)
+    : edit(e), editSaver(saver),
+      state(edit.state.getOrCreateChildWithName(IDs::EDIT_VIEW_STATE,
+                                                nullptr)) {
     jassert(state.hasType(IDs::EDIT_VIEW_STATE));
 
     std::function<int(int)> octaveConstrainer = [this](int param) {
@@ -44,8 +46,8 @@ int EditViewModel::getCurrentOctave() const { return currentOctave.get(); }
 
 void EditViewModel::setCurrentOctave(int octave) {
     currentOctave.setValue(octave, nullptr);
-    tracktion::EditFileOperations fileOperations(edit);
-    fileOperations.save(true, true, false);
+    if (editSaver != nullptr)
+        editSaver->save();
 }
 
 void EditViewModel::valueTreePropertyChanged(
@@ -9,7 +9,8 @@ const juce::Identifier currentOctave("currentOctave");
 class EditViewModel : public juce::ValueTree::Listener,
                       public FlaggedAsyncUpdater {
   public:
-    EditViewModel(tracktion::Edit &e);
+    EditViewModel(tracktion::Edit &e,
+                  app_services::EditSaver *saver = nullptr);
     ~EditViewModel() override;
 
     class Listener {
@@ -29,6 +30,7 @@ class EditViewModel : public juce::ValueTree::Listener,
     const int MIN_OCTAVE = -4;
     const int MAX_OCTAVE = 4;
     tracktion::Edit &edit;
+    app_services::EditSaver *editSaver;
     // this is the EDIT_VIEW_STATE value tree that is a child of the edit
     // value tree
     juce::ValueTree state;
@@ -37,8 +39,8 @@ class EditViewModel : public juce::ValueTree::Listener,
     tracktion::ConstrainedCachedValue<int> currentOctave;
 
     // Async updater flags
-    bool shouldUpdateOctave = false;
-    bool shouldUpdateTracks = false;
+    std::atomic<bool> shouldUpdateOctave{false};
+    std::atomic<bool> shouldUpdateTracks{false};
     void handleAsyncUpdate() override;
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
                                   const juce::Identifier &property) override;
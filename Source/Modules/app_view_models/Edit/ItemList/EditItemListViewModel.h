@@ -27,7 +27,7 @@ class EditItemListViewModel : public juce::ValueTree::Listener,
     void removeListener(Listener *l);
 
     // async update markers
-    bool shouldUpdateItems = false;
+    std::atomic<bool> shouldUpdateItems{false};
 
   protected:
     // This is what we are interested in watching for child changes
@@ -34,7 +34,7 @@ class ItemListState : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // Async update markers
-    bool shouldUpdateSelectedIndex = false;
+    std::atomic<bool> shouldUpdateSelectedIndex{false};
 
     void handleAsyncUpdate() override;
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
@@ -35,10 +35,10 @@ class MixerTrackViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // Async updater flags
-    bool shouldUpdateVolume = false;
-    bool shouldUpdatePan = false;
-    bool shouldUpdateMute = false;
-    bool shouldUpdateSolo = false;
+    std::atomic<bool> shouldUpdateVolume{false};
+    std::atomic<bool> shouldUpdatePan{false};
+    std::atomic<bool> shouldUpdateMute{false};
+    std::atomic<bool> shouldUpdateSolo{false};
 
     void handleAsyncUpdate() override;
 
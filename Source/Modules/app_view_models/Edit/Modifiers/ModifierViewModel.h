@@ -38,6 +38,6 @@ class ModifierViewModel : public juce::ValueTree::Listener,
 
     void handleAsyncUpdate() override;
 
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 };
 } // namespace app_view_models
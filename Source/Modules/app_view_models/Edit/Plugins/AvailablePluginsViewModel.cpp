@@ -3,8 +3,8 @@
 namespace app_view_models {
 
 AvailablePluginsViewModel::AvailablePluginsViewModel(
-    tracktion::AudioTrack::Ptr t)
-    : track(t), rootPluginTreeGroup(track->edit),
+    tracktion::AudioTrack::Ptr t, app_services::PluginWarmPool *pool)
+    : track(t), warmPool(pool), rootPluginTreeGroup(track->edit),
       state(track->state.getOrCreateChildWithName(
           IDs::AVAILABLE_PLUGINS_VIEW_STATE, nullptr)) {
     jassert(state.hasType(app_view_models::IDs::AVAILABLE_PLUGINS_VIEW_STATE));
@@ -74,6 +74,8 @@ AvailablePluginsViewModel::AvailablePluginsViewModel(
                 rootPluginTreeGroup.getSubItem(i)))
             categoryNames.add(category->name);
     }
+
+    warmSelectedPlugin();
 }
 
 AvailablePluginsViewModel::~AvailablePluginsViewModel() {
@@ -114,19 +116,34 @@ void AvailablePluginsViewModel::setSelectedPluginIndex(int newIndex) {
 }
 
 tracktion::Plugin::Ptr AvailablePluginsViewModel::getSelectedPlugin() {
+    if (auto selectedPluginItem = getSelectedPluginItem()) {
+        if (warmPool != nullptr)
+            if (auto plugin = warmPool->take(selectedPluginItem->xmlType,
+                                             selectedPluginItem->description))
+                return plugin;
+
+        return selectedPluginItem->create(track->edit);
+    }
+
+    return nullptr;
+}
+
+PluginTreeItem *AvailablePluginsViewModel::getSelectedPluginItem() {
     if (selectedPluginIndex != -1) {
-        if (auto selectedCategoryPluginGroup = getSelectedCategory()) {
-            if (auto selectedPluginItem = dynamic_cast<PluginTreeItem *>(
-                    selectedCategoryPluginGroup->getSubItem(
-                        getSelectedPluginIndex())))
-                return selectedPluginItem->create(track->edit);
-            else
-                return nullptr;
-        } else
-            return nullptr;
+        if (auto selectedCategoryPluginGroup = getSelectedCategory())
+            return dynamic_cast<PluginTreeItem *>(
+                selectedCategoryPluginGroup->getSubItem(
+                    getSelectedPluginIndex()));
+    }
 
-    } else
-        return nullptr;
+    return nullptr;
+}
+
+void AvailablePluginsViewModel::warmSelectedPlugin() {
+    if (warmPool != nullptr)
+        if (auto selectedPluginItem = getSelectedPluginItem())
+            warmPool->request(selectedPluginItem->xmlType,
+                              selectedPluginItem->description);
 }
 
 juce::StringArray AvailablePluginsViewModel::getCategoryNames() {
@@ -201,6 +218,7 @@ void AvailablePluginsViewModel::handleAsyncUpdate() {
     }
 
     if (compareAndReset(shouldUpdateSelectedPluginIndex)) {
+        warmSelectedPlugin();
         listeners.call([this](Listener &l) {
             l.selectedPluginIndexChanged(getSelectedPluginIndex());
         });
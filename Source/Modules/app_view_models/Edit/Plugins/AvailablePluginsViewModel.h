@@ -17,7 +17,10 @@ const juce::Identifier
 class AvailablePluginsViewModel : public juce::ValueTree::Listener,
                                   public FlaggedAsyncUpdater {
   public:
-    AvailablePluginsViewModel(tracktion::AudioTrack::Ptr t);
+    // If a warm pool is given, the highlighted plugin is warmed up so it can
+    // be added to the track straight away
+    AvailablePluginsViewModel(tracktion::AudioTrack::Ptr t,
+                              app_services::PluginWarmPool *pool = nullptr);
     ~AvailablePluginsViewModel() override;
 
     int getSelectedCategoryIndex();
@@ -46,6 +49,7 @@ class AvailablePluginsViewModel : public juce::ValueTree::Listener,
 
   private:
     tracktion::AudioTrack::Ptr track;
+    app_services::PluginWarmPool *warmPool;
     // root plugin group has 1 node called plugins
     PluginTreeGroup rootPluginTreeGroup;
     // this is the TRACKS_VIEW_STATE value tree that is a child of the edit
@@ -60,9 +64,12 @@ class AvailablePluginsViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // async update markers
-    bool shouldUpdatePluginTree = false;
-    bool shouldUpdateSelectedPluginIndex = false;
-    bool shouldUpdateSelectedCategoryIndex = false;
+    std::atomic<bool> shouldUpdatePluginTree{false};
+    std::atomic<bool> shouldUpdateSelectedPluginIndex{false};
+    std::atomic<bool> shouldUpdateSelectedCategoryIndex{false};
+
+    PluginTreeItem *getSelectedPluginItem();
+    void warmSelectedPlugin();
 
     void handleAsyncUpdate() override;
 
@@ -42,7 +42,7 @@ class ADSRViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     void handleAsyncUpdate() override;
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 };
 
 } // namespace app_view_models
@@ -62,7 +62,7 @@ class FilterViewModel : public juce::ValueTree::Listener,
 
     void handleAsyncUpdate() override;
     static float convertMidiNoteToHz(float noteNumber);
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 };
 
 } // namespace app_view_models
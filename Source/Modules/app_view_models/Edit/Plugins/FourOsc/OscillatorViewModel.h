@@ -63,7 +63,7 @@ class OscillatorViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     void handleAsyncUpdate() override;
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 };
 
 } // namespace app_view_models
@@ -38,7 +38,7 @@ class InternalPluginViewModel : public juce::ValueTree::Listener,
 
     void handleAsyncUpdate() override;
 
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 };
 
 } // namespace app_view_models
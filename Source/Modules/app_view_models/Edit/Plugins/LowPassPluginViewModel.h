@@ -36,7 +36,7 @@ class LowPassPluginViewModel : public juce::ValueTree::Listener,
 
     juce::ListenerList<Listener> listeners;
 
-    bool shouldUpdateParameters = false;
+    std::atomic<bool> shouldUpdateParameters{false};
 
     void handleAsyncUpdate() override;
 };
@@ -6,11 +6,12 @@ namespace app_view_models {
 
 PluginTreeGroup::PluginTreeGroup(tracktion::Edit &e)
     : name("Plugins"), edit(e) {
-    scanForPlugins();
-
     // we need to add the app internal plugins to the cache:
     // edit.engine.getPluginManager().createBuiltInType<internal_plugins::DrumSamplerPlugin>();
 
+    // External plugins are scanned in the background by the
+    // app_services::PluginScanCache when the app starts, so this only reads
+    // the list it has built so far
     auto &list = edit.engine.getPluginManager().knownPluginList;
 
     {
@@ -91,36 +92,4 @@ void PluginTreeGroup::populateBuiltInEffects(int &num) {
     //        num);
 }
 
-void PluginTreeGroup::scanForPlugins() const {
-    juce::Logger::writeToLog("scan for plugins called");
-    // Scan for plugins
-    juce::File homeDirectory = juce::File::getSpecialLocation(
-        juce::File::SpecialLocationType::userHomeDirectory);
-    juce::File vst3Directory = homeDirectory.getChildFile(".vst3");
-    if (!vst3Directory.exists()) {
-        vst3Directory.createDirectory();
-    }
-
-    edit.engine.getPluginManager().knownPluginList.clear();
-
-    for (auto format :
-         edit.engine.getPluginManager().pluginFormatManager.getFormats()) {
-        juce::Logger::writeToLog("looking for VST3 files...");
-        if (format->getName() == "VST3") {
-            juce::PluginDirectoryScanner scanner(
-                edit.engine.getPluginManager().knownPluginList,
-                reinterpret_cast<juce::AudioPluginFormat &>(*format),
-                juce::FileSearchPath(vst3Directory.getFullPathName()), true,
-                edit.engine.getTemporaryFileManager().getTempFile(
-                    "PluginScanDeadMansPedal"));
-
-            juce::String pluginBeingScanned;
-            juce::Logger::writeToLog("scanning " + pluginBeingScanned);
-            while (scanner.scanNextFile(false, pluginBeingScanned)) {
-                scanner.scanNextFile(false, pluginBeingScanned);
-            }
-        }
-    }
-}
-
 } // namespace app_view_models
\ No newline at end of file
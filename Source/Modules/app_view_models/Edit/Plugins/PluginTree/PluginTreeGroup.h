@@ -16,8 +16,6 @@ class PluginTreeGroup : public PluginTreeBase {
   private:
     tracktion::Edit &edit;
 
-    void scanForPlugins() const;
-
     void populateExternalInstruments(juce::KnownPluginList &list);
     void populateExternalEffects(juce::KnownPluginList &list);
 
@@ -3,7 +3,8 @@ namespace app_view_models {
 
 DrumSamplerViewModel::DrumSamplerViewModel(
     internal_plugins::DrumSamplerPlugin *sampler)
-    : SamplerViewModel(sampler, IDs::DRUM_SAMPLER_VIEW_STATE) {
+    : SamplerViewModel(sampler, IDs::DRUM_SAMPLER_VIEW_STATE),
+      drumSamplerPlugin(sampler) {
     updateDrumKits();
     itemListState.listSize = drumKitNames.size();
 
@@ -109,6 +110,13 @@ void DrumSamplerViewModel::readMappingFileIntoSampler(
                 index, 0,
                 tracktion::AudioFile(samplerPlugin->engine, file).getLength());
             samplerPlugin->setSoundOpenEnded(index, true);
+
+            // Pads with the same choke group cut each other off, eg. a closed
+            // hi-hat stopping an open one
+            int chokeGroup = 0;
+            if (mapping["choke_group"])
+                chokeGroup = mapping["choke_group"].as<int>();
+            drumSamplerPlugin->setSoundChokeGroup(index, chokeGroup);
         }
     }
 }
@@ -20,6 +20,7 @@ class DrumSamplerViewModel : public app_view_models::SamplerViewModel {
                                   const juce::Identifier &property) override;
 
   private:
+    internal_plugins::DrumSamplerPlugin *drumSamplerPlugin;
     juce::StringArray drumKitNames;
     juce::Array<juce::File> mapFiles;
     juce::Array<juce::File> drumSampleFiles;
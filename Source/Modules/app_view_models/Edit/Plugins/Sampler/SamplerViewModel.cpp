@@ -41,6 +41,15 @@ double SamplerViewModel::getEndTime() {
            samplerPlugin->getSoundLength(selectedSoundIndex);
 }
 
+double SamplerViewModel::getSoundFileLength() {
+    // The drum sampler doesn't load its sounds through the SamplerPlugin, so
+    // go to the sound's media rather than using getSoundFile
+    return tracktion::AudioFile(
+               samplerPlugin->engine,
+               juce::File(samplerPlugin->getSoundMedia(selectedSoundIndex)))
+        .getLength();
+}
+
 double SamplerViewModel::getGain() {
     return samplerPlugin->getSoundGainDb(selectedSoundIndex);
 }
@@ -56,8 +65,7 @@ void SamplerViewModel::decreaseSelectedIndex() {
 }
 
 void SamplerViewModel::increaseStartTime() {
-    double increment =
-        samplerPlugin->getSoundFile(selectedSoundIndex).getLength() / 100.0;
+    double increment = getSoundFileLength() / 100.0;
     if (samplerPlugin->getSoundLength(selectedSoundIndex) >
         increment + increment / 2.0) {
         double start =
@@ -70,8 +78,7 @@ void SamplerViewModel::increaseStartTime() {
 }
 
 void SamplerViewModel::decreaseStartTime() {
-    double decrement =
-        samplerPlugin->getSoundFile(selectedSoundIndex).getLength() / 100.0;
+    double decrement = getSoundFileLength() / 100.0;
     double start = samplerPlugin->getSoundStartTime(selectedSoundIndex);
     double length = samplerPlugin->getSoundLength(selectedSoundIndex);
 
@@ -87,14 +94,11 @@ void SamplerViewModel::decreaseStartTime() {
 }
 
 void SamplerViewModel::increaseEndTime() {
-    double increment =
-        samplerPlugin->getSoundFile(selectedSoundIndex).getLength() / 100.0;
+    double increment = getSoundFileLength() / 100.0;
     double currentEnd = samplerPlugin->getSoundStartTime(selectedSoundIndex) +
                         samplerPlugin->getSoundLength(selectedSoundIndex);
 
-    if (currentEnd <
-        samplerPlugin->getSoundFile(selectedSoundIndex).getLength() -
-            increment) {
+    if (currentEnd < getSoundFileLength() - increment) {
         samplerPlugin->setSoundExcerpt(
             selectedSoundIndex,
             samplerPlugin->getSoundStartTime(selectedSoundIndex),
@@ -103,14 +107,13 @@ void SamplerViewModel::increaseEndTime() {
         samplerPlugin->setSoundExcerpt(
             selectedSoundIndex,
             samplerPlugin->getSoundStartTime(selectedSoundIndex),
-            samplerPlugin->getSoundFile(selectedSoundIndex).getLength() -
+            getSoundFileLength() -
                 samplerPlugin->getSoundStartTime(selectedSoundIndex));
     }
 }
 
 void SamplerViewModel::decreaseEndTime() {
-    double decrement =
-        samplerPlugin->getSoundFile(selectedSoundIndex).getLength() / 100.0;
+    double decrement = getSoundFileLength() / 100.0;
     double currentEnd = samplerPlugin->getSoundStartTime(selectedSoundIndex) +
                         samplerPlugin->getSoundLength(selectedSoundIndex);
 
@@ -143,6 +146,9 @@ void SamplerViewModel::decreaseGain() {
 }
 
 void SamplerViewModel::handleAsyncUpdate() {
+    if (compareAndReset(shouldUpdateItemNames))
+        listeners.call([this](Listener &l) { l.itemNamesChanged(); });
+
     if (compareAndReset(shouldUpdateSample))
         listeners.call([this](Listener &l) { l.sampleChanged(); });
 
@@ -56,6 +56,7 @@ class SamplerViewModel : public juce::ChangeListener,
         virtual void fullSampleThumbnailChanged() {}
         virtual void sampleExcerptThumbnailChanged() {}
         virtual void gainChanged() {}
+        virtual void itemNamesChanged() {}
     };
 
     void addListener(Listener *l);
@@ -76,10 +77,13 @@ class SamplerViewModel : public juce::ChangeListener,
 
     juce::ListenerList<Listener> listeners;
 
-    bool shouldUpdateFullSampleThumbnail = false;
-    bool shouldUpdateSampleExcerptTimes = false;
-    bool shouldUpdateSample = false;
-    bool shouldUpdateGain = false;
+    std::atomic<bool> shouldUpdateFullSampleThumbnail{false};
+    std::atomic<bool> shouldUpdateSampleExcerptTimes{false};
+    std::atomic<bool> shouldUpdateSample{false};
+    std::atomic<bool> shouldUpdateGain{false};
+    std::atomic<bool> shouldUpdateItemNames{false};
+
+    double getSoundFileLength();
 
     void handleAsyncUpdate() override;
 
@@ -1,76 +1,75 @@
 namespace app_view_models {
-SynthSamplerViewModel::SynthSamplerViewModel(tracktion::SamplerPlugin *sampler)
-    : SamplerViewModel(sampler, IDs::SYNTH_SAMPLER_VIEW_STATE) {
-    const auto samplesDir = ConfigurationHelpers::getTempSamplesDirectory(
-        samplerPlugin->edit.engine);
-    itemListState.listSize = samplesDir.getNumberOfChildFiles(
-        juce::File::TypesOfFileToFind::findFiles);
-
-    auto files = samplesDir.findChildFiles(
-        juce::File::TypesOfFileToFind::findFiles, false);
-
-    if (samplerPlugin->getNumSounds() <= 0) {
-        const auto file = files[0];
+SynthSamplerViewModel::SynthSamplerViewModel(
+    tracktion::SamplerPlugin *sampler, app_services::SampleLibraryIndex &index)
+    : SamplerViewModel(sampler, IDs::SYNTH_SAMPLER_VIEW_STATE),
+      sampleLibraryIndex(index) {
+    itemListState.listSize = sampleLibraryIndex.size();
+
+    // The sample is loaded once the index is ready
+    waitingForScan = sampleLibraryIndex.isScanning();
+    if (!waitingForScan)
+        loadInitialSample();
+
+    sampleLibraryIndex.addListener(this);
+    markAndUpdate(shouldUpdateSample);
+}
+
+SynthSamplerViewModel::~SynthSamplerViewModel() {
+    sampleLibraryIndex.removeListener(this);
+}
+
+juce::StringArray SynthSamplerViewModel::getItemNames() {
+    return sampleLibraryIndex.getNames();
+}
+
+juce::String SynthSamplerViewModel::getSelectedItemName() {
+    if (waitingForScan)
+        return "Indexing samples...";
+
+    return SamplerViewModel::getSelectedItemName();
+}
+
+void SynthSamplerViewModel::loadInitialSample() {
+    if (samplerPlugin->getNumSounds() <= 0 && sampleLibraryIndex.size() > 0) {
+        const auto &entry = sampleLibraryIndex.getEntry(0);
         const auto error = samplerPlugin->addSound(
-            file.getFullPathName(), file.getFileNameWithoutExtension(), 0.0,
-            0.0, 1.0);
-        samplerPlugin->setSoundParams(0, 60, 0, 127);
+            entry.file.getFullPathName(), entry.name, 0.0, 0.0, 1.0);
+        samplerPlugin->setSoundParams(0, entry.rootNote, 0, 127);
         samplerPlugin->setSoundGains(0, 1, 0);
-        samplerPlugin->setSoundExcerpt(
-            0, 0,
-            tracktion::AudioFile(samplerPlugin->engine, file).getLength());
+        samplerPlugin->setSoundExcerpt(0, 0, entry.lengthInSeconds);
         selectedSoundIndex.setValue(0, nullptr);
         itemListState.setSelectedItemIndex(0);
 
         jassert(error.isEmpty());
     }
 
-    const auto file = files[itemListState.getSelectedItemIndex()];
-    auto *reader = formatManager.createReaderFor(file);
-    if (reader != nullptr) {
+    const auto file =
+        sampleLibraryIndex.getFile(itemListState.getSelectedItemIndex());
+    if (file.existsAsFile()) {
         // This must be set in order for the plugin state to be loaded in
         // correctly if the sound already existed (ie the number of sounds was >
         // 0)
         samplerPlugin->setSoundMedia(selectedSoundIndex.get(),
                                      file.getFullPathName());
-
-        std::unique_ptr<juce::AudioFormatReaderSource> newSource(
-            new juce::AudioFormatReaderSource(reader, true));
-        fullSampleThumbnail.clear();
-        fullSampleThumbnailCache.clear();
-        fullSampleThumbnail.setSource(new juce::FileInputSource(file));
-        readerSource.reset(newSource.release());
-    }
-    markAndUpdate(shouldUpdateSample);
-}
-
-juce::StringArray SynthSamplerViewModel::getItemNames() {
-    juce::StringArray sampleNames;
-    const auto destDir =
-        samplerPlugin->edit.engine.getTemporaryFileManager().getTempFile(
-            ConfigurationHelpers::SAMPLES_DIRECTORY_NAME);
-    auto files =
-        destDir.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false);
-    for (const auto &file : files) {
-        sampleNames.add(file.getFileNameWithoutExtension());
+        loadThumbnail(file);
     }
-
-    return sampleNames;
 }
 
 void SynthSamplerViewModel::selectedIndexChanged(int newIndex) {
-    const auto destDir =
-        samplerPlugin->edit.engine.getTemporaryFileManager().getTempFile(
-            ConfigurationHelpers::SAMPLES_DIRECTORY_NAME);
-    auto files =
-        destDir.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false);
-    auto file = files[newIndex];
-    samplerPlugin->setSoundMedia(0, file.getFullPathName());
-    samplerPlugin->setSoundParams(0, 60, 0, 127);
+    if (!juce::isPositiveAndBelow(newIndex, sampleLibraryIndex.size()))
+        return;
+
+    const auto &entry = sampleLibraryIndex.getEntry(newIndex);
+    samplerPlugin->setSoundMedia(0, entry.file.getFullPathName());
+    samplerPlugin->setSoundParams(0, entry.rootNote, 0, 127);
     samplerPlugin->setSoundGains(0, 1, 0);
-    samplerPlugin->setSoundExcerpt(
-        0, 0, tracktion::AudioFile(samplerPlugin->engine, file).getLength());
+    samplerPlugin->setSoundExcerpt(0, 0, entry.lengthInSeconds);
 
+    loadThumbnail(entry.file);
+    markAndUpdate(shouldUpdateSample);
+}
+
+void SynthSamplerViewModel::loadThumbnail(const juce::File &file) {
     auto *reader = formatManager.createReaderFor(file);
     if (reader != nullptr) {
         std::unique_ptr<juce::AudioFormatReaderSource> newSource(
@@ -80,7 +79,35 @@ void SynthSamplerViewModel::selectedIndexChanged(int newIndex) {
         fullSampleThumbnail.setSource(new juce::FileInputSource(file));
         readerSource.reset(newSource.release());
     }
+}
+
+void SynthSamplerViewModel::sampleLibraryChanged() {
+    itemListState.listSize = sampleLibraryIndex.size();
+    if (waitingForScan) {
+        waitingForScan = false;
+        loadInitialSample();
+    }
+
+    // Entries may have shifted around, so keep the list pointing at the sample
+    // that is currently loaded rather than at the same index
+    const auto currentFile =
+        juce::File(samplerPlugin->getSoundMedia(selectedSoundIndex.get()));
+
+    const auto currentIndex = sampleLibraryIndex.indexOf(currentFile);
+    if (currentIndex != -1) {
+        itemListState.setSelectedItemIndex(currentIndex);
+    } else {
+        // The sample has been deleted, so load the one that took its place in
+        // the list, or the last one if it was at the end. Changing the index
+        // loads the sample, but if it hasn't changed that has to be done here.
+        const auto oldIndex = itemListState.getSelectedItemIndex();
+        itemListState.setSelectedItemIndex(
+            juce::jmin(oldIndex, sampleLibraryIndex.size() - 1));
+        if (itemListState.getSelectedItemIndex() == oldIndex)
+            selectedIndexChanged(oldIndex);
+    }
 
+    markAndUpdate(shouldUpdateItemNames);
     markAndUpdate(shouldUpdateSample);
 }
 
@@ -6,13 +6,28 @@ const juce::Identifier SYNTH_SAMPLER_VIEW_STATE("SYNTH_SAMPLER_VIEW_STATE");
 
 }
 
-class SynthSamplerViewModel : public app_view_models::SamplerViewModel {
+class SynthSamplerViewModel
+    : public app_view_models::SamplerViewModel,
+      private app_services::SampleLibraryIndex::Listener {
   public:
-    SynthSamplerViewModel(tracktion::SamplerPlugin *sampler);
+    SynthSamplerViewModel(tracktion::SamplerPlugin *sampler,
+                          app_services::SampleLibraryIndex &index);
+    ~SynthSamplerViewModel() override;
 
     juce::StringArray getItemNames() override;
+    juce::String getSelectedItemName() override;
 
     void selectedIndexChanged(int newIndex) override;
+
+  private:
+    app_services::SampleLibraryIndex &sampleLibraryIndex;
+    // Set until the index has finished scanning and the sample is loaded
+    bool waitingForScan = false;
+
+    void loadInitialSample();
+    void loadThumbnail(const juce::File &file);
+
+    void sampleLibraryChanged() override;
 };
 
 } // namespace app_view_models
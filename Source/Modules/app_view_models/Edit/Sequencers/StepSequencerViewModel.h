@@ -77,10 +77,10 @@ class StepSequencerViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // Async update markers
-    bool shouldUpdatePattern = false;
-    bool shouldUpdateSelectedNoteIndex = false;
-    bool shouldUpdateNumberOfNotes = false;
-    bool shouldUpdateNotesPerMeasure = false;
+    std::atomic<bool> shouldUpdatePattern{false};
+    std::atomic<bool> shouldUpdateSelectedNoteIndex{false};
+    std::atomic<bool> shouldUpdateNumberOfNotes{false};
+    std::atomic<bool> shouldUpdateNotesPerMeasure{false};
 
     juce::CachedValue<int> notesPerMeasure;
     juce::Array<int> notesPerMeasureOptions = juce::Array<int>({4, 8, 16});
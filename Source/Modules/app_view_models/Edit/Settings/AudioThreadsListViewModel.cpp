@@ -0,0 +1,57 @@
+namespace app_view_models {
+AudioThreadsListViewModel::AudioThreadsListViewModel(tracktion::Edit &e)
+    : edit(e),
+      state(e.state.getOrCreateChildWithName(IDs::SETTINGS_VIEW_STATE, nullptr)
+                .getOrCreateChildWithName(IDs::AUDIO_THREADS_LIST_VIEW_STATE,
+                                          nullptr)),
+      itemListState(state, threadCounts.size()) {
+    threadCounts.add(defaultItemName);
+    for (int i = 1; i <= juce::SystemStats::getNumCpus(); i++)
+        threadCounts.add(juce::String(i));
+    itemListState.listSize = threadCounts.size();
+
+    int currentIndex = 0;
+    if (auto behaviour = getEngineBehaviour())
+        if (behaviour->getNumAudioThreads() > 0)
+            currentIndex = juce::jmax(
+                0, threadCounts.indexOf(
+                       juce::String(behaviour->getNumAudioThreads())));
+    itemListState.setSelectedItemIndex(currentIndex);
+    itemListState.addListener(this);
+}
+
+AudioThreadsListViewModel::~AudioThreadsListViewModel() {
+    itemListState.removeListener(this);
+}
+
+juce::StringArray AudioThreadsListViewModel::getItemNames() {
+    return threadCounts;
+}
+
+juce::String AudioThreadsListViewModel::getSelectedItem() {
+    return threadCounts[itemListState.getSelectedItemIndex()];
+}
+
+void AudioThreadsListViewModel::updateNumAudioThreads() {
+    auto behaviour = getEngineBehaviour();
+    if (behaviour == nullptr)
+        return;
+
+    // "Default" isn't a number so it gives 0, which is tracktion's default
+    behaviour->setNumAudioThreads(getSelectedItem().getIntValue());
+    if (!behaviour->reallocateContextWhenStopped(edit))
+        juce::Logger::writeToLog(
+            "The number of audio threads will change once playback stops");
+}
+
+app_services::AppEngineBehaviour *
+AudioThreadsListViewModel::getEngineBehaviour() {
+    return dynamic_cast<app_services::AppEngineBehaviour *>(
+        &edit.engine.getEngineBehaviour());
+}
+
+void AudioThreadsListViewModel::selectedIndexChanged(int newIndex) {
+    updateNumAudioThreads();
+}
+
+} // namespace app_view_models
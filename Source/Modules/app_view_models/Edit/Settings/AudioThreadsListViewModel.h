@@ -0,0 +1,34 @@
+#pragma once
+
+namespace app_view_models {
+namespace IDs {
+const juce::Identifier
+    AUDIO_THREADS_LIST_VIEW_STATE("AUDIO_THREADS_LIST_VIEW_STATE");
+}
+
+class AudioThreadsListViewModel : private ItemListState::Listener {
+  public:
+    explicit AudioThreadsListViewModel(tracktion::Edit &e);
+
+    ~AudioThreadsListViewModel() override;
+    juce::StringArray getItemNames();
+    juce::String getSelectedItem();
+    void updateNumAudioThreads();
+
+    const juce::String defaultItemName = "Default";
+
+  private:
+    tracktion::Edit &edit;
+    juce::ValueTree state;
+    juce::StringArray threadCounts;
+
+    app_services::AppEngineBehaviour *getEngineBehaviour();
+    void selectedIndexChanged(int newIndex) override;
+
+  public:
+    // Must appear below the other variables since it needs to be initialized
+    // last
+    ItemListState itemListState;
+};
+
+} // namespace app_view_models
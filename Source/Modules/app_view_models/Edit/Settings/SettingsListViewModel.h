@@ -17,6 +17,7 @@ class SettingsListViewModel {
     const juce::String outputSettingName = "Output";
     const juce::String sampleRateSettingName = "Sample Rate";
     const juce::String audioBufferSizeSettingName = "Audio Buffer Size";
+    const juce::String audioThreadsSettingName = "Audio Threads";
     const juce::String midiInputSettingName = "Midi Input";
 
   private:
@@ -25,7 +26,8 @@ class SettingsListViewModel {
     juce::StringArray settingNames =
         juce::StringArray(juce::Array<juce::String>(
             {deviceTypeSettingName, outputSettingName, sampleRateSettingName,
-             audioBufferSizeSettingName, midiInputSettingName}));
+             audioBufferSizeSettingName, audioThreadsSettingName,
+             midiInputSettingName}));
 
   public:
     // Must appear below the other variables since it needs to be initialized
@@ -53,9 +53,9 @@ class TempoSettingsViewModel : public juce::ValueTree::Listener,
     int timeout = 3000;
 
     // Async update markers
-    bool shouldUpdateBPM = false;
-    bool shouldUpdateClickTrackGain = false;
-    bool shouldUpdateTapMode = false;
+    std::atomic<bool> shouldUpdateBPM{false};
+    std::atomic<bool> shouldUpdateClickTrackGain{false};
+    std::atomic<bool> shouldUpdateTapMode{false};
 
     void handleAsyncUpdate() override;
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged,
@@ -41,9 +41,9 @@ class TrackViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // Async updater flags
-    bool shouldUpdateClips = false;
-    bool shouldUpdateClipPositions = false;
-    bool shouldUpdateTransport = false;
+    std::atomic<bool> shouldUpdateClips{false};
+    std::atomic<bool> shouldUpdateClipPositions{false};
+    std::atomic<bool> shouldUpdateTransport{false};
 
     void handleAsyncUpdate() override;
 
@@ -3,10 +3,12 @@
 namespace app_view_models {
 
 TracksListViewModel::TracksListViewModel(tracktion::Edit &e,
-                                         app_services::TimelineCamera &cam)
+                                         app_services::TimelineCamera &cam,
+                                         app_services::EditSaver *saver)
     : edit(e),
 
-      camera(cam), adapter(std::make_unique<TracksListAdapter>(edit)),
+      camera(cam), editSaver(saver),
+      adapter(std::make_unique<TracksListAdapter>(edit)),
       state(edit.state.getOrCreateChildWithName(IDs::TRACKS_LIST_VIEW_STATE,
                                                 nullptr)),
       listViewModel(edit.state, state, tracktion::IDs::TRACK, adapter.get()) {
@@ -223,9 +225,8 @@ void TracksListViewModel::stopRecordingOrPlaying() {
     if (transport.isPlaying() || transport.isRecording()) {
         transport.stop(false, false);
 
-        tracktion::EditFileOperations fileOperations(edit);
-        fileOperations.save(true, true, false);
-
+        if (editSaver != nullptr)
+            editSaver->save();
     } else {
         // if we try to stop while currently not playing
         // return transport to beginning
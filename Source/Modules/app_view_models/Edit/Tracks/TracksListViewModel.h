@@ -18,7 +18,10 @@ class TracksListViewModel : public juce::ValueTree::Listener,
   public:
     enum class TracksViewType { MULTI_TRACK, SINGLE_TRACK };
 
-    TracksListViewModel(tracktion::Edit &e, app_services::TimelineCamera &cam);
+    // The edit is saved whenever the transport stops, in the background if
+    // an edit saver is given
+    TracksListViewModel(tracktion::Edit &e, app_services::TimelineCamera &cam,
+                        app_services::EditSaver *saver = nullptr);
     ~TracksListViewModel() override;
 
     void addTrack();
@@ -79,6 +82,7 @@ class TracksListViewModel : public juce::ValueTree::Listener,
   private:
     tracktion::Edit &edit;
     app_services::TimelineCamera &camera;
+    app_services::EditSaver *editSaver;
     std::unique_ptr<TracksListAdapter> adapter;
     juce::ValueTree state;
 
@@ -86,10 +90,10 @@ class TracksListViewModel : public juce::ValueTree::Listener,
     juce::ListenerList<Listener> listeners;
 
     // async update markers
-    bool shouldUpdateTracksViewType = false;
-    bool shouldUpdateLooping = false;
-    bool shouldUpdateSolo = false;
-    bool shouldUpdateMute = false;
+    std::atomic<bool> shouldUpdateTracksViewType{false};
+    std::atomic<bool> shouldUpdateLooping{false};
+    std::atomic<bool> shouldUpdateSolo{false};
+    std::atomic<bool> shouldUpdateMute{false};
 
     void initialiseInputs();
 
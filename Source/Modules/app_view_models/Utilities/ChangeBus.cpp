@@ -0,0 +1,91 @@
+#include "ChangeBus.h"
+
+namespace app_view_models {
+
+JUCE_IMPLEMENT_SINGLETON(ChangeBus)
+
+double ChangeBus::Metrics::getAverageFanOut() const {
+    return numPasses > 0 ? double(numUpdates) / double(numPasses) : 0.0;
+}
+
+ChangeBus::ChangeBus() = default;
+
+ChangeBus::~ChangeBus() {
+    cancelPendingUpdate();
+    clearSingletonInstance();
+}
+
+void ChangeBus::addClient(FlaggedAsyncUpdater *client) {
+    JUCE_ASSERT_MESSAGE_THREAD
+    clients.add(client);
+}
+
+void ChangeBus::removeClient(FlaggedAsyncUpdater *client) {
+    JUCE_ASSERT_MESSAGE_THREAD
+    const auto index = clients.indexOf(client);
+    if (index == -1)
+        return;
+
+    clients.remove(index);
+    if (isDelivering && index <= deliveryIndex)
+        deliveryIndex--;
+}
+
+void ChangeBus::markChanged(FlaggedAsyncUpdater &client) {
+    numMarks.fetch_add(1, std::memory_order_relaxed);
+    if (!client.updatePending.exchange(true))
+        triggerAsyncUpdate();
+}
+
+void ChangeBus::deliverChanges() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // Already in a pass, which will get to any newly marked clients
+    if (isDelivering)
+        return;
+
+    // A client updated during the pass can delete others or mark them again,
+    // ones it marks that have already been passed wait for the next pass
+    isDelivering = true;
+    int fanOut = 0;
+    for (deliveryIndex = 0; deliveryIndex < clients.size(); deliveryIndex++) {
+        auto *client = clients.getUnchecked(deliveryIndex);
+        if (client->updatePending.exchange(false)) {
+            client->handleAsyncUpdate();
+            fanOut++;
+        }
+    }
+    deliveryIndex = -1;
+    isDelivering = false;
+
+    if (fanOut == 0)
+        return;
+
+    numPasses++;
+    numUpdates += fanOut;
+    lastFanOut = fanOut;
+    maxFanOut = juce::jmax(maxFanOut, fanOut);
+}
+
+ChangeBus::Metrics ChangeBus::getMetrics() const {
+    Metrics metrics;
+    metrics.numMarks = numMarks.load();
+    metrics.numPasses = numPasses;
+    metrics.numUpdates = numUpdates;
+    metrics.lastFanOut = lastFanOut;
+    metrics.maxFanOut = maxFanOut;
+    metrics.numClients = clients.size();
+    return metrics;
+}
+
+void ChangeBus::resetMetrics() {
+    numMarks = 0;
+    numPasses = 0;
+    numUpdates = 0;
+    lastFanOut = 0;
+    maxFanOut = 0;
+}
+
+void ChangeBus::handleAsyncUpdate() { deliverChanges(); }
+
+} // namespace app_view_models
@@ -0,0 +1,65 @@
+#pragma once
+
+namespace app_view_models {
+
+// Delivers the view models' pending updates on the message thread. One user
+// action usually changes the edit in several places, and each view model
+// listening to it marks itself as changed. Rather than each one posting its
+// own message, the bus posts one and then calls every marked view model in
+// a single pass, in the order they were created, so the view models that
+// others are built from are brought up to date first. View models can be
+// marked from any thread.
+class ChangeBus : private juce::AsyncUpdater, private juce::DeletedAtShutdown {
+  public:
+    struct Metrics {
+        // Number of times a view model was marked, including marks for view
+        // models that were already waiting to be updated
+        juce::int64 numMarks = 0;
+        juce::int64 numPasses = 0;
+        juce::int64 numUpdates = 0;
+        // View models updated by the most recent pass and the busiest one
+        int lastFanOut = 0;
+        int maxFanOut = 0;
+        int numClients = 0;
+
+        double getAverageFanOut() const;
+    };
+
+    ChangeBus();
+    ~ChangeBus() override;
+
+    // Called on the message thread as view models are created and deleted
+    void addClient(FlaggedAsyncUpdater *client);
+    void removeClient(FlaggedAsyncUpdater *client);
+
+    // Can be called from any thread
+    void markChanged(FlaggedAsyncUpdater &client);
+
+    // Updates every marked view model now rather than waiting for the
+    // message, called on the message thread
+    void deliverChanges();
+
+    Metrics getMetrics() const;
+    void resetMetrics();
+
+    JUCE_DECLARE_SINGLETON(ChangeBus, false)
+
+  private:
+    juce::Array<FlaggedAsyncUpdater *> clients;
+    // The client being updated by the current pass, so clients removed
+    // during the pass don't make it skip any
+    int deliveryIndex = -1;
+    bool isDelivering = false;
+
+    std::atomic<juce::int64> numMarks{0};
+    juce::int64 numPasses = 0;
+    juce::int64 numUpdates = 0;
+    int lastFanOut = 0;
+    int maxFanOut = 0;
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChangeBus)
+};
+
+} // namespace app_view_models
@@ -1,16 +1,41 @@
 #include "FlaggedAsyncUpdater.h"
 
 namespace app_view_models {
-void FlaggedAsyncUpdater::markAndUpdate(bool &flag) {
+FlaggedAsyncUpdater::FlaggedAsyncUpdater() {
+    ChangeBus::getInstance()->addClient(this);
+}
+
+FlaggedAsyncUpdater::~FlaggedAsyncUpdater() {
+    if (auto *bus = ChangeBus::getInstanceWithoutCreating())
+        bus->removeClient(this);
+}
+
+void FlaggedAsyncUpdater::markAndUpdate(std::atomic<bool> &flag) {
     flag = true;
     triggerAsyncUpdate();
 }
 
-bool FlaggedAsyncUpdater::compareAndReset(bool &flag) noexcept {
-    if (!flag)
-        return false;
+bool FlaggedAsyncUpdater::compareAndReset(std::atomic<bool> &flag) noexcept {
+    return flag.exchange(false);
+}
+
+void FlaggedAsyncUpdater::triggerAsyncUpdate() {
+    // The bus is only missing once JUCE has shut down
+    if (auto *bus = ChangeBus::getInstanceWithoutCreating())
+        bus->markChanged(*this);
+}
+
+void FlaggedAsyncUpdater::cancelPendingUpdate() noexcept {
+    updatePending = false;
+}
+
+bool FlaggedAsyncUpdater::isUpdatePending() const noexcept {
+    return updatePending;
+}
 
-    flag = false;
-    return true;
+void FlaggedAsyncUpdater::handleUpdateNowIfNeeded() {
+    JUCE_ASSERT_MESSAGE_THREAD
+    if (updatePending.exchange(false))
+        handleAsyncUpdate();
 }
-} // namespace app_view_models
\ No newline at end of file
+} // namespace app_view_models
@@ -2,11 +2,35 @@
 
 namespace app_view_models {
 
-class FlaggedAsyncUpdater : public juce::AsyncUpdater {
+// Base for view models that batch up their listener calls. Changes set one
+// of the view model's flags and mark it on the ChangeBus, which calls
+// handleAsyncUpdate on the message thread where the flags are checked and
+// reset. Flags can be marked from any thread.
+class FlaggedAsyncUpdater {
   public:
-    void markAndUpdate(bool &flag);
+    FlaggedAsyncUpdater();
+    virtual ~FlaggedAsyncUpdater();
 
-    bool compareAndReset(bool &flag) noexcept;
+    void markAndUpdate(std::atomic<bool> &flag);
+
+    bool compareAndReset(std::atomic<bool> &flag) noexcept;
+
+    // Marks the view model without setting a flag
+    void triggerAsyncUpdate();
+    void cancelPendingUpdate() noexcept;
+    bool isUpdatePending() const noexcept;
+
+    // Calls handleAsyncUpdate now if the view model is marked, rather than
+    // waiting for the bus. Called on the message thread.
+    void handleUpdateNowIfNeeded();
+
+    virtual void handleAsyncUpdate() = 0;
+
+  private:
+    friend class ChangeBus;
+    std::atomic<bool> updatePending{false};
+
+    JUCE_DECLARE_NON_COPYABLE(FlaggedAsyncUpdater)
 };
 
 } // namespace app_view_models
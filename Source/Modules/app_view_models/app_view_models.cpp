@@ -3,6 +3,7 @@
 
 // Utilities
 #include "Utilities/FlaggedAsyncUpdater.cpp"
+#include "Utilities/ChangeBus.cpp"
 #include "Utilities/EngineHelpers.cpp"
 
 // EditItemList
@@ -60,12 +61,16 @@
 #include "Edit/Mixer/MixerViewModel.cpp"
 #include "Edit/Mixer/MixerTrackViewModel.cpp"
 
+// DspLoad
+#include "Edit/DspLoad/DspLoadViewModel.cpp"
+
 // Settings
 #include "Edit/Settings/SettingsListViewModel.cpp"
 #include "Edit/Settings/DeviceTypeListViewModel.cpp"
 #include "Edit/Settings/OutputListViewModel.cpp"
 #include "Edit/Settings/SampleRateListViewModel.cpp"
 #include "Edit/Settings/AudioBufferSizeListViewModel.cpp"
+#include "Edit/Settings/AudioThreadsListViewModel.cpp"
 #include "Edit/Settings/MidiInputListViewModel.cpp"
 
 // Edit
@@ -14,6 +14,7 @@
 #pragma once
 
 namespace app_view_models {
+    class ChangeBus;
     class FlaggedAsyncUpdater;
     class MidiCommandManager;
     class ItemListState;
@@ -51,11 +52,13 @@ namespace app_view_models {
     class FilterViewModel;
     class MixerViewModel;
     class MixerTrackViewModel;
+    class DspLoadViewModel;
     class SettingsListViewModel;
     class DeviceTypeListViewModel;
     class OutputListViewModel;
     class SampleRateListViewModel;
     class AudioBufferSizeListViewModel;
+    class AudioThreadsListViewModel;
     class MidiInputListViewModel;
     class EditViewModel;
 }
@@ -68,11 +71,14 @@ namespace app_view_models {
 #include <app_models/app_models.h>
 #include <app_services/app_services.h>
 #include <internal_plugins/internal_plugins.h>
+#include <atomic>
 #include <functional>
+#include <map>
 #include <app_configuration/app_configuration.h>
 
 // Utilities
 #include "Utilities/FlaggedAsyncUpdater.h"
+#include "Utilities/ChangeBus.h"
 #include "Utilities/EngineHelpers.h"
 
 // ItemList
@@ -131,12 +137,16 @@ namespace app_view_models {
 #include "Edit/Mixer/MixerViewModel.h"
 #include "Edit/Mixer/MixerTrackViewModel.h"
 
+// DspLoad
+#include "Edit/DspLoad/DspLoadViewModel.h"
+
 // Settings
 #include "Edit/Settings/SettingsListViewModel.h"
 #include "Edit/Settings/DeviceTypeListViewModel.h"
 #include "Edit/Settings/OutputListViewModel.h"
 #include "Edit/Settings/SampleRateListViewModel.h"
 #include "Edit/Settings/AudioBufferSizeListViewModel.h"
+#include "Edit/Settings/AudioThreadsListViewModel.h"
 #include "Edit/Settings/MidiInputListViewModel.h"
 
 // Edit
@@ -4,7 +4,217 @@ namespace internal_plugins {
 
 const char *DrumSamplerPlugin::xmlTypeName = "drumSampler";
 
+namespace {
+std::atomic<PackedSampleBuffer::Format> sampleStorageFormat{
+    PackedSampleBuffer::Format::float32};
+}
+
 DrumSamplerPlugin::DrumSamplerPlugin(tracktion::PluginCreationInfo info)
-    : tracktion::SamplerPlugin(info) {}
+    : tracktion::SamplerPlugin(info), voiceEngine(numVoices) {
+    formatManager.registerBasicFormats();
+    streamLongSamples.referTo(state, IDs::streamLongSamples, getUndoManager(),
+                              true);
+
+    // Load the sounds for the device until the plugin is initialised
+    const auto deviceSampleRate = engine.getDeviceManager().getSampleRate();
+    if (deviceSampleRate > 0.0)
+        sampleRate = deviceSampleRate;
+
+    ResampledSampleCache::getInstance()->addChangeListener(this);
+    handleAsyncUpdate();
+}
+
+DrumSamplerPlugin::~DrumSamplerPlugin() {
+    if (auto *cache = ResampledSampleCache::getInstanceWithoutCreating())
+        cache->removeChangeListener(this);
+
+    voiceEngine.getStreamer().stopThread();
+}
+
+void DrumSamplerPlugin::initialise(
+    const tracktion::PluginInitialisationInfo &info) {
+    SamplerPlugin::initialise(info);
+
+    sampleRate = info.sampleRate;
+    voiceEngine.prepare(info.sampleRate, info.blockSizeSamples);
+    voiceEngine.getStreamer().startThread();
+
+    // The sounds are loaded for the device sample rate, so if this doesn't
+    // match (e.g. when rendering) they need to be loaded again. They are
+    // loaded straight away on the message thread so a render doesn't start
+    // with sounds at the wrong rate, otherwise it is left to the message
+    // thread.
+    if (info.sampleRate == loadedSampleRate)
+        return;
+
+    if (juce::MessageManager::existsAndIsCurrentThread()) {
+        handleAsyncUpdate();
+    } else {
+        juce::ReferenceCountedObjectPtr<DrumSamplerPlugin> plugin(this);
+        juce::MessageManager::callAsync(
+            [plugin, rate = info.sampleRate] {
+                if (plugin->sampleRate == rate)
+                    plugin->handleAsyncUpdate();
+            });
+    }
+}
+
+void DrumSamplerPlugin::deinitialise() {
+    voiceEngine.getStreamer().stopThread();
+    voiceEngine.stopAll();
+
+    SamplerPlugin::deinitialise();
+}
+
+void DrumSamplerPlugin::applyToBuffer(
+    const tracktion::PluginRenderContext &fc) {
+    const RealtimeSafetyChecker::ScopedRealtimeSection realtimeSection;
+    if (fc.destBuffer == nullptr || fc.bufferNumSamples <= 0)
+        return;
+
+    updateActiveSoundSet();
+
+    auto &buffer = *fc.destBuffer;
+    auto renderPosition = 0;
+
+    if (fc.bufferForMidiMessages != nullptr) {
+        auto &midi = *fc.bufferForMidiMessages;
+        if (midi.isAllNotesOff)
+            voiceEngine.releaseAll();
+
+        for (auto &message : midi) {
+            const auto eventPosition =
+                juce::jlimit(renderPosition, fc.bufferNumSamples,
+                             juce::roundToInt(message.getTimeStamp() *
+                                              sampleRate));
+
+            voiceEngine.render(buffer, fc.bufferStartSample + renderPosition,
+                               eventPosition - renderPosition);
+            renderPosition = eventPosition;
+
+            if (message.isNoteOn() && activeSoundSet != nullptr)
+                voiceEngine.noteOn(*activeSoundSet, message.getNoteNumber(),
+                                   message.getFloatVelocity());
+            else if (message.isNoteOff())
+                voiceEngine.noteOff(message.getNoteNumber());
+            else if (message.isAllNotesOff() || message.isAllSoundOff())
+                voiceEngine.releaseAll();
+        }
+    }
+
+    voiceEngine.render(buffer, fc.bufferStartSample + renderPosition,
+                       fc.bufferNumSamples - renderPosition);
+}
+
+void DrumSamplerPlugin::setSoundChokeGroup(int index, int chokeGroup) {
+    auto soundState = getSoundState(index);
+    if (soundState.isValid())
+        soundState.setProperty(IDs::chokeGroup, chokeGroup, getUndoManager());
+}
+
+int DrumSamplerPlugin::getSoundChokeGroup(int index) const {
+    return getSoundState(index).getProperty(IDs::chokeGroup, 0);
+}
+
+void DrumSamplerPlugin::setSampleStorageFormat(
+    PackedSampleBuffer::Format format) {
+    sampleStorageFormat = format;
+}
+
+PackedSampleBuffer::Format DrumSamplerPlugin::getSampleStorageFormat() {
+    return sampleStorageFormat;
+}
+
+int DrumSamplerPlugin::getNumStreamingUnderruns() const {
+    return voiceEngine.getStreamer().getNumUnderruns();
+}
+
+int DrumSamplerPlugin::getNumActiveStreams() const {
+    return voiceEngine.getStreamer().getNumActiveStreams();
+}
+
+juce::ValueTree DrumSamplerPlugin::getSoundState(int index) const {
+    int soundIndex = 0;
+    for (const auto &child : state)
+        if (child.hasType(tracktion::IDs::SOUND))
+            if (soundIndex++ == index)
+                return child;
+
+    return {};
+}
+
+void DrumSamplerPlugin::updateActiveSoundSet() {
+    const juce::SpinLock::ScopedTryLockType sl(soundSetLock);
+    if (!sl.isLocked() || !pendingSoundSetIsNew)
+        return;
+
+    // Voices playing the active set carry on once it is retired, only the
+    // ones still playing the retired set are stopped before it is released
+    if (retiredSoundSet != nullptr)
+        voiceEngine.stopVoicesFromSet(retiredSoundSet->version);
+
+    std::swap(activeSoundSet, pendingSoundSet);
+    std::swap(pendingSoundSet, retiredSoundSet);
+    pendingSoundSetIsNew = false;
+}
+
+void DrumSamplerPlugin::handleAsyncUpdate() {
+    auto newSet = new DrumSoundSet(nextSoundSetVersion++);
+    DrumSoundSet::Ptr newSetPtr(newSet);
+
+    const auto targetSampleRate = sampleRate.load();
+    waitingForResampledSounds = false;
+    for (int i = 0; i < getNumSounds(); i++) {
+        const juce::File file(getSoundMedia(i));
+        auto sound = DrumSoundSet::loadSound(
+            formatManager, file, getSoundStartTime(i), getSoundLength(i),
+            streamLongSamples.get(), targetSampleRate,
+            getSampleStorageFormat());
+
+        if (sound == nullptr) {
+            juce::Logger::writeToLog("Unable to load drum sample " +
+                                     file.getFullPathName());
+
+            // Keep an empty sound so the indices still match the sound list
+            sound = std::make_unique<DrumSound>();
+        } else {
+            sound->keyNote = getKeyNote(i);
+            sound->minNote = getMinKey(i);
+            sound->maxNote = getMaxKey(i);
+            sound->gain = juce::Decibels::decibelsToGain(getSoundGainDb(i));
+            sound->pan = getSoundPan(i);
+            sound->openEnded = isSoundOpenEnded(i);
+            sound->chokeGroup = getSoundChokeGroup(i);
+
+            if (sound->sampleRate != targetSampleRate)
+                waitingForResampledSounds = true;
+        }
+
+        newSet->sounds.add(sound.release());
+    }
+
+    // Whatever was pending gets released here rather than on the audio
+    // thread. The streamer is given the active set under the lock, so the
+    // audio thread can't switch to another set before the new one is pending.
+    DrumSoundSet::Ptr oldSet;
+    {
+        const juce::SpinLock::ScopedLockType sl(soundSetLock);
+        voiceEngine.getStreamer().setSoundSet(newSetPtr, activeSoundSet);
+        oldSet = pendingSoundSet;
+        pendingSoundSet = newSetPtr;
+        pendingSoundSetIsNew = true;
+    }
+
+    loadedSampleRate = targetSampleRate;
+}
+
+void DrumSamplerPlugin::changeListenerCallback(
+    juce::ChangeBroadcaster *source) {
+    // Pick up any copies that have been made for the current sounds. Only
+    // samplers that are still waiting for copies need to reload.
+    if (source == ResampledSampleCache::getInstanceWithoutCreating() &&
+        waitingForResampledSounds)
+        handleAsyncUpdate();
+}
 
 } // namespace internal_plugins
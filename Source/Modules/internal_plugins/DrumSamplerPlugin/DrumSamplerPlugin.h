@@ -2,9 +2,23 @@
 
 namespace internal_plugins {
 
-class DrumSamplerPlugin : public tracktion::SamplerPlugin {
+namespace IDs {
+
+const juce::Identifier streamLongSamples("streamLongSamples");
+const juce::Identifier chokeGroup("chokeGroup");
+
+}
+
+// The drum sampler uses the SamplerPlugin's sound list for its state, but
+// plays the sounds with its own DrumVoiceEngine. When streaming is enabled,
+// only the head of long samples is kept in memory and the rest is streamed
+// from disk. Sounds that aren't at the device sample rate are played from
+// copies in the ResampledSampleCache once they have been made.
+class DrumSamplerPlugin : public tracktion::SamplerPlugin,
+                          private juce::ChangeListener {
   public:
     explicit DrumSamplerPlugin(tracktion::PluginCreationInfo info);
+    ~DrumSamplerPlugin() override;
 
     static const char *getPluginName() { return NEEDS_TRANS("DrumSampler"); }
 
@@ -19,6 +33,61 @@ class DrumSamplerPlugin : public tracktion::SamplerPlugin {
     juce::String getSelectableDescription() override {
         return TRANS("DrumSampler");
     }
+
+    void initialise(const tracktion::PluginInitialisationInfo &info) override;
+    void deinitialise() override;
+    void applyToBuffer(const tracktion::PluginRenderContext &fc) override;
+
+    // Sounds in the same choke group (other than 0) cut each other off
+    void setSoundChokeGroup(int index, int chokeGroup);
+    int getSoundChokeGroup(int index) const;
+
+    // The number of times a voice ran out of streamed samples
+    int getNumStreamingUnderruns() const;
+    int getNumActiveStreams() const;
+
+    juce::CachedValue<bool> streamLongSamples;
+
+    // The format sounds are held in memory in. This applies to every drum
+    // sampler, and takes effect the next time their sounds are loaded.
+    static void setSampleStorageFormat(PackedSampleBuffer::Format format);
+    static PackedSampleBuffer::Format getSampleStorageFormat();
+
+  private:
+    static constexpr int numVoices = 64;
+
+    juce::AudioFormatManager formatManager;
+    DrumVoiceEngine voiceEngine;
+    // Set when the plugin is initialised, which may not be on the message
+    // thread where the sounds are loaded
+    std::atomic<double> sampleRate{44100.0};
+    int nextSoundSetVersion = 1;
+
+    // The sample rate the current sounds were loaded for
+    std::atomic<double> loadedSampleRate{0.0};
+
+    // Set when some of the sounds are waiting for the ResampledSampleCache
+    bool waitingForResampledSounds = false;
+
+    // The message thread puts a new sound set in pendingSoundSet, the audio
+    // thread makes it the active set. The old active set is kept as the
+    // retired set so voices that are playing it can finish, and the retired
+    // set before that goes back into pendingSoundSet so it is always released
+    // on the message thread.
+    juce::SpinLock soundSetLock;
+    DrumSoundSet::Ptr pendingSoundSet;
+    bool pendingSoundSetIsNew = false;
+    DrumSoundSet::Ptr activeSoundSet;
+    DrumSoundSet::Ptr retiredSoundSet;
+
+    juce::ValueTree getSoundState(int index) const;
+    void updateActiveSoundSet();
+
+    // Called by the SamplerPlugin whenever its sounds change. This replaces
+    // the SamplerPlugin's version, which loads every sound fully into memory.
+    void handleAsyncUpdate() override;
+
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
 };
 
 } // namespace internal_plugins
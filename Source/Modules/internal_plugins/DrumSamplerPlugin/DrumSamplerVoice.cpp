@@ -0,0 +1,182 @@
+#include "DrumSamplerVoice.h"
+
+namespace internal_plugins {
+
+DrumSamplerVoice::DrumSamplerVoice(SampleStreamer &s, int index)
+    : streamer(s), streamIndex(index) {}
+
+void DrumSamplerVoice::prepare(double sampleRate, int maxBlockSize) {
+    stop();
+
+    outputSampleRate = sampleRate;
+
+    releaseLength = juce::jmax(1, juce::roundToInt(releaseTime * sampleRate));
+    releaseRamp.allocate(size_t(releaseLength), false);
+    for (int i = 0; i < releaseLength; i++)
+        releaseRamp[i] = 1.0f - float(i + 1) / float(releaseLength);
+
+    // Leave room for the interpolators to look a few samples ahead
+    staging.setSize(2, int(std::ceil(maxBlockSize * maxPitchRatio)) + 8);
+    voiceBuffer.setSize(2, maxBlockSize);
+}
+
+void DrumSamplerVoice::start(const DrumSound &s, int soundIndex, int version,
+                             int note, float velocity, juce::uint64 order) {
+    stop();
+
+    sound = &s;
+    setVersion = version;
+    noteNumber = note;
+    startOrder = order;
+    pitchRatio = juce::jlimit(
+        1.0 / maxPitchRatio, maxPitchRatio,
+        std::pow(2.0, (note - s.keyNote) / 12.0) * s.sampleRate /
+            outputSampleRate);
+
+    const auto gain = s.gain * velocity;
+    leftGain = gain * juce::jmin(1.0f, 1.0f - s.pan);
+    rightGain = gain * juce::jmin(1.0f, 1.0f + s.pan);
+
+    sourcePosition = 0;
+    stagingLength = 0;
+    stagingEnd = 0;
+    releasing = false;
+    finished = false;
+
+    for (auto &interpolator : interpolators)
+        interpolator.reset();
+
+    if (s.isStreamed())
+        streamer.start(streamIndex, soundIndex, version);
+}
+
+void DrumSamplerVoice::release() {
+    if (isActive() && !releasing) {
+        releasing = true;
+        releasePosition = 0;
+    }
+}
+
+void DrumSamplerVoice::stop() {
+    if (sound != nullptr && sound->isStreamed())
+        streamer.stop(streamIndex);
+
+    sound = nullptr;
+    noteNumber = -1;
+}
+
+int DrumSamplerVoice::render(int numSamples) {
+    jassert(numSamples <= voiceBuffer.getNumSamples());
+
+    if (pitchRatio == 1.0)
+        renderDirect(numSamples);
+    else
+        renderResampled(numSamples);
+
+    auto numRendered = numSamples;
+    if (releasing) {
+        numRendered = juce::jmin(numSamples, releaseLength - releasePosition);
+        for (int channel = 0; channel < sound->numChannels; channel++)
+            juce::FloatVectorOperations::multiply(
+                voiceBuffer.getWritePointer(channel),
+                releaseRamp + releasePosition, numRendered);
+
+        releasePosition += numRendered;
+        finished = finished || releasePosition >= releaseLength;
+    }
+
+    return numRendered;
+}
+
+void DrumSamplerVoice::renderDirect(int numSamples) {
+    const auto numToPull = int(juce::jmin(
+        juce::int64(numSamples), sound->lengthInSamples - sourcePosition));
+    const auto numPulled = pullSource(voiceBuffer, 0, numToPull);
+
+    // Fill in anything the stream couldn't provide or past the end
+    for (int channel = 0; channel < sound->numChannels; channel++)
+        voiceBuffer.clear(channel, numPulled, numSamples - numPulled);
+
+    finished = sourcePosition >= sound->lengthInSamples;
+}
+
+void DrumSamplerVoice::renderResampled(int numSamples) {
+    fillStaging(juce::jmin(staging.getNumSamples(),
+                           int(std::ceil(numSamples * pitchRatio)) + 4));
+
+    int numUsed = 0;
+    for (int channel = 0; channel < sound->numChannels; channel++)
+        numUsed = interpolators[channel].process(
+            pitchRatio, staging.getReadPointer(channel),
+            voiceBuffer.getWritePointer(channel), numSamples);
+
+    numUsed = juce::jmin(numUsed, stagingLength);
+    stagingLength -= numUsed;
+    stagingEnd = juce::jmax(0, stagingEnd - numUsed);
+    for (int channel = 0; channel < sound->numChannels; channel++) {
+        auto *data = staging.getWritePointer(channel);
+        std::memmove(data, data + numUsed,
+                     size_t(stagingLength) * sizeof(float));
+    }
+
+    finished = sourcePosition >= sound->lengthInSamples && stagingEnd == 0;
+}
+
+void DrumSamplerVoice::fillStaging(int numSamplesNeeded) {
+    while (stagingLength < numSamplesNeeded) {
+        const auto numRemaining = sound->lengthInSamples - sourcePosition;
+        const auto numWanted = numSamplesNeeded - stagingLength;
+
+        if (numRemaining <= 0) {
+            // Pad the end of the sound with silence
+            for (int channel = 0; channel < sound->numChannels; channel++)
+                staging.clear(channel, stagingLength, numWanted);
+
+            stagingLength = numSamplesNeeded;
+            return;
+        }
+
+        const auto numToPull =
+            int(juce::jmin(juce::int64(numWanted), numRemaining));
+        const auto numPulled = pullSource(staging, stagingLength, numToPull);
+
+        if (numPulled < numToPull) {
+            // The stream couldn't keep up, output silence until it catches up
+            for (int channel = 0; channel < sound->numChannels; channel++)
+                staging.clear(channel, stagingLength + numPulled,
+                              numToPull - numPulled);
+        }
+
+        stagingLength += numToPull;
+        stagingEnd = stagingLength;
+    }
+}
+
+int DrumSamplerVoice::pullSource(juce::AudioBuffer<float> &dest,
+                                 int destStartSample, int numSamples) {
+    int numPulled = 0;
+
+    const auto headLength = sound->getHeadLength();
+    if (sourcePosition < headLength) {
+        numPulled = int(juce::jmin(juce::int64(numSamples),
+                                   headLength - sourcePosition));
+        for (int channel = 0; channel < sound->numChannels; channel++)
+            sound->head.read(channel, int(sourcePosition),
+                             dest.getWritePointer(channel, destStartSample),
+                             numPulled);
+
+        sourcePosition += numPulled;
+    }
+
+    if (numPulled < numSamples && sound->isStreamed()) {
+        auto numRead =
+            streamer.read(streamIndex, dest, destStartSample + numPulled,
+                          numSamples - numPulled);
+        sourcePosition += numRead;
+        numPulled += numRead;
+    }
+
+    return numPulled;
+}
+
+} // namespace internal_plugins
@@ -0,0 +1,90 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Plays a single DrumSound. The voice pulls samples from the sound's head
+// and then from its stream into its own buffer, which the DrumVoiceEngine
+// then mixes into the output. Sounds are only resampled if they are pitched
+// or aren't at the output sample rate, otherwise they are copied straight
+// into the buffer.
+// Everything it needs is allocated in prepare() so rendering never
+// allocates.
+class DrumSamplerVoice {
+  public:
+    DrumSamplerVoice(SampleStreamer &streamer, int streamIndex);
+
+    void prepare(double sampleRate, int maxBlockSize);
+
+    void start(const DrumSound &sound, int soundIndex, int setVersion,
+               int noteNumber, float velocity, juce::uint64 startOrder);
+
+    // Fades the voice out over a few milliseconds
+    void release();
+
+    // Stops the voice immediately
+    void stop();
+
+    bool isActive() const { return sound != nullptr; }
+    bool isReleasing() const { return releasing; }
+    bool hasFinished() const { return finished; }
+    int getNoteNumber() const { return noteNumber; }
+    const DrumSound *getSound() const { return sound; }
+    int getSetVersion() const { return setVersion; }
+    juce::uint64 getStartOrder() const { return startOrder; }
+
+    // Renders up to numSamples (no more than the prepared block size) into
+    // the voice's output buffer and returns how many samples were rendered
+    int render(int numSamples);
+
+    const juce::AudioBuffer<float> &getOutput() const { return voiceBuffer; }
+    int getNumChannels() const { return sound->numChannels; }
+    float getLeftGain() const { return leftGain; }
+    float getRightGain() const { return rightGain; }
+
+  private:
+    static constexpr double maxPitchRatio = 8.0;
+    static constexpr double releaseTime = 0.005;
+
+    SampleStreamer &streamer;
+    const int streamIndex;
+
+    double outputSampleRate = 44100.0;
+
+    const DrumSound *sound = nullptr;
+    int setVersion = 0;
+    int noteNumber = -1;
+    juce::uint64 startOrder = 0;
+    double pitchRatio = 1.0;
+    float leftGain = 1.0f;
+    float rightGain = 1.0f;
+    bool finished = false;
+
+    // Number of source samples that have been pulled from the sound
+    juce::int64 sourcePosition = 0;
+
+    // Source samples waiting to be resampled. stagingLength is the number of
+    // valid samples, stagingEnd is how many of those belong to the sound
+    // (the rest is padding once the end of the sound has been reached).
+    juce::AudioBuffer<float> staging;
+    int stagingLength = 0;
+    int stagingEnd = 0;
+
+    juce::AudioBuffer<float> voiceBuffer;
+    juce::LagrangeInterpolator interpolators[2];
+
+    // The release fade is applied by multiplying with this precomputed ramp
+    juce::HeapBlock<float> releaseRamp;
+    int releaseLength = 0;
+    int releasePosition = 0;
+    bool releasing = false;
+
+    void renderDirect(int numSamples);
+    void renderResampled(int numSamples);
+    void fillStaging(int numSamplesNeeded);
+    int pullSource(juce::AudioBuffer<float> &dest, int destStartSample,
+                   int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumSamplerVoice)
+};
+
+} // namespace internal_plugins
@@ -0,0 +1,58 @@
+#include "DrumSound.h"
+
+namespace internal_plugins {
+
+std::unique_ptr<DrumSound>
+DrumSoundSet::loadSound(juce::AudioFormatManager &formatManager,
+                        const juce::File &file, double startTime,
+                        double length, bool allowStreaming,
+                        double targetSampleRate,
+                        PackedSampleBuffer::Format storageFormat) {
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 ||
+        reader->sampleRate <= 0.0)
+        return nullptr;
+
+    if (targetSampleRate > 0.0 && reader->sampleRate != targetSampleRate) {
+        auto playbackFile =
+            ResampledSampleCache::getInstance()->getFileForSampleRate(
+                file, reader->sampleRate, targetSampleRate);
+        if (playbackFile != file)
+            if (auto *resampledReader =
+                    formatManager.createReaderFor(playbackFile))
+                reader.reset(resampledReader);
+    }
+
+    auto sound = std::make_unique<DrumSound>();
+    sound->file = file;
+    sound->sampleRate = reader->sampleRate;
+    sound->numChannels = juce::jlimit(1, 2, int(reader->numChannels));
+
+    sound->startSample = juce::jlimit(
+        juce::int64(0), reader->lengthInSamples - 1,
+        juce::int64(std::floor(startTime * reader->sampleRate)));
+
+    const auto maxLength = reader->lengthInSamples - sound->startSample;
+    sound->lengthInSamples =
+        length > 0.0 ? juce::jlimit(juce::int64(1), maxLength,
+                                    juce::int64(length * reader->sampleRate))
+                     : maxLength;
+
+    // Short sounds are kept entirely in memory, there is no point streaming a
+    // sound that would only be slightly longer than its head
+    auto headLength = sound->lengthInSamples;
+    if (allowStreaming &&
+        sound->lengthInSamples > 2 * juce::int64(SampleStreamer::headLength))
+        headLength = SampleStreamer::headLength;
+
+    sound->head.setSize(sound->numChannels, int(headLength), storageFormat);
+    sound->head.readFromReader(*reader, sound->startSample);
+
+    if (sound->isStreamed())
+        sound->reader = std::move(reader);
+
+    return sound;
+}
+
+} // namespace internal_plugins
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace internal_plugins {
+
+// A single sound loaded by the DrumSamplerPlugin. Only the first part of the
+// sound (the head) is held in memory, if the sound is longer than that the
+// rest is streamed from disk by the SampleStreamer using the reader. Sounds
+// are never modified once they have been loaded.
+struct DrumSound {
+    juce::File file;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    PackedSampleBuffer head;
+
+    // Position of the excerpt in the file and its length, in source samples
+    juce::int64 startSample = 0;
+    juce::int64 lengthInSamples = 0;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+
+    int keyNote = 60;
+    int minNote = 0;
+    int maxNote = 127;
+    float gain = 1.0f;
+    float pan = 0.0f;
+    bool openEnded = false;
+
+    // Sounds with the same choke group (other than 0) cut each other off
+    int chokeGroup = 0;
+
+    int getHeadLength() const { return head.getNumSamples(); }
+    bool isStreamed() const { return getHeadLength() < lengthInSamples; }
+};
+
+// The set of sounds used by a DrumSamplerPlugin. A new set is loaded on the
+// message thread whenever the sounds change and is then handed over to the
+// audio and disk threads, so a set can be read from any thread without
+// locking.
+class DrumSoundSet : public juce::ReferenceCountedObject {
+  public:
+    using Ptr = juce::ReferenceCountedObjectPtr<DrumSoundSet>;
+
+    explicit DrumSoundSet(int versionNumber) : version(versionNumber) {}
+
+    // Loads the sound's excerpt, keeping at most headLength samples in memory
+    // if streaming is allowed. If the file isn't at the target sample rate,
+    // its copy from the ResampledSampleCache is used when there is one. The
+    // head is stored in the given format. Returns nullptr if the file can't
+    // be read.
+    static std::unique_ptr<DrumSound>
+    loadSound(juce::AudioFormatManager &formatManager, const juce::File &file,
+              double startTime, double length, bool allowStreaming,
+              double targetSampleRate,
+              PackedSampleBuffer::Format storageFormat =
+                  PackedSampleBuffer::Format::float32);
+
+    const int version;
+    juce::OwnedArray<DrumSound> sounds;
+
+  private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumSoundSet)
+};
+
+} // namespace internal_plugins
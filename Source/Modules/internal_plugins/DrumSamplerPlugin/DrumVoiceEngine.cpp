@@ -0,0 +1,134 @@
+#include "DrumVoiceEngine.h"
+
+namespace internal_plugins {
+
+DrumVoiceEngine::DrumVoiceEngine(int numVoices) : streamer(numVoices) {
+    for (int i = 0; i < numVoices; i++)
+        voices.add(new DrumSamplerVoice(streamer, i));
+}
+
+void DrumVoiceEngine::prepare(double sampleRate, int blockSize) {
+    maxBlockSize = blockSize;
+    for (auto *voice : voices)
+        voice->prepare(sampleRate, blockSize);
+}
+
+void DrumVoiceEngine::noteOn(const DrumSoundSet &soundSet, int noteNumber,
+                             float velocity) {
+    for (int i = 0; i < soundSet.sounds.size(); i++) {
+        const auto &sound = *soundSet.sounds.getUnchecked(i);
+        if (sound.lengthInSamples <= 0 || noteNumber < sound.minNote ||
+            noteNumber > sound.maxNote)
+            continue;
+
+        if (sound.chokeGroup > 0)
+            choke(sound.chokeGroup);
+
+        findVoiceToUse().start(sound, i, soundSet.version, noteNumber,
+                               velocity, nextStartOrder++);
+    }
+}
+
+void DrumVoiceEngine::noteOff(int noteNumber) {
+    for (auto *voice : voices)
+        if (voice->isActive() && voice->getNoteNumber() == noteNumber &&
+            !voice->getSound()->openEnded)
+            voice->release();
+}
+
+void DrumVoiceEngine::releaseAll() {
+    for (auto *voice : voices)
+        voice->release();
+}
+
+void DrumVoiceEngine::stopAll() {
+    for (auto *voice : voices)
+        voice->stop();
+}
+
+void DrumVoiceEngine::stopVoicesFromSet(int setVersion) {
+    for (auto *voice : voices)
+        if (voice->isActive() && voice->getSetVersion() == setVersion)
+            voice->stop();
+}
+
+void DrumVoiceEngine::render(juce::AudioBuffer<float> &buffer,
+                             int startSample, int numSamples) {
+    while (numSamples > 0) {
+        const auto numThisTime = juce::jmin(numSamples, maxBlockSize);
+
+        for (auto *voice : voices) {
+            if (!voice->isActive())
+                continue;
+
+            mixVoice(*voice, buffer, startSample, voice->render(numThisTime));
+
+            if (voice->hasFinished())
+                voice->stop();
+        }
+
+        startSample += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
+int DrumVoiceEngine::getNumActiveVoices() const {
+    int numActive = 0;
+    for (auto *voice : voices)
+        if (voice->isActive())
+            numActive++;
+
+    return numActive;
+}
+
+DrumSamplerVoice &DrumVoiceEngine::findVoiceToUse() {
+    jassert(!voices.isEmpty());
+
+    DrumSamplerVoice *oldest = nullptr;
+    DrumSamplerVoice *oldestReleasing = nullptr;
+
+    for (auto *voice : voices) {
+        if (!voice->isActive())
+            return *voice;
+
+        if (oldest == nullptr ||
+            voice->getStartOrder() < oldest->getStartOrder())
+            oldest = voice;
+
+        if (voice->isReleasing() &&
+            (oldestReleasing == nullptr ||
+             voice->getStartOrder() < oldestReleasing->getStartOrder()))
+            oldestReleasing = voice;
+    }
+
+    return oldestReleasing != nullptr ? *oldestReleasing : *oldest;
+}
+
+void DrumVoiceEngine::choke(int chokeGroup) {
+    for (auto *voice : voices)
+        if (voice->isActive() && voice->getSound()->chokeGroup == chokeGroup)
+            voice->release();
+}
+
+void DrumVoiceEngine::mixVoice(const DrumSamplerVoice &voice,
+                               juce::AudioBuffer<float> &buffer,
+                               int startSample, int numSamples) {
+    if (numSamples <= 0)
+        return;
+
+    // Mono sounds are panned by mixing the same channel into both sides
+    const auto &output = voice.getOutput();
+    const auto rightChannel = voice.getNumChannels() > 1 ? 1 : 0;
+
+    juce::FloatVectorOperations::addWithMultiply(
+        buffer.getWritePointer(0, startSample), output.getReadPointer(0),
+        voice.getLeftGain(), numSamples);
+
+    if (buffer.getNumChannels() > 1)
+        juce::FloatVectorOperations::addWithMultiply(
+            buffer.getWritePointer(1, startSample),
+            output.getReadPointer(rightChannel), voice.getRightGain(),
+            numSamples);
+}
+
+} // namespace internal_plugins
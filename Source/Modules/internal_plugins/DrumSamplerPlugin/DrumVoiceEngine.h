@@ -0,0 +1,50 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Plays DrumSounds using a fixed pool of voices that is allocated up front,
+// so nothing is allocated on the audio thread. Starting a sound chokes any
+// other voices in the same choke group (for example an open hi-hat is cut
+// off by a closed one). When every voice is busy the oldest releasing voice
+// is stolen, or failing that the oldest voice, so the same input always
+// produces the same output.
+class DrumVoiceEngine {
+  public:
+    explicit DrumVoiceEngine(int numVoices);
+
+    SampleStreamer &getStreamer() { return streamer; }
+    const SampleStreamer &getStreamer() const { return streamer; }
+
+    void prepare(double sampleRate, int maxBlockSize);
+
+    void noteOn(const DrumSoundSet &soundSet, int noteNumber, float velocity);
+    void noteOff(int noteNumber);
+    void releaseAll();
+    void stopAll();
+
+    // Stops the voices playing sounds from the given set
+    void stopVoicesFromSet(int setVersion);
+
+    // Adds the active voices to the buffer
+    void render(juce::AudioBuffer<float> &buffer, int startSample,
+                int numSamples);
+
+    int getNumVoices() const { return voices.size(); }
+    int getNumActiveVoices() const;
+
+  private:
+    SampleStreamer streamer;
+    juce::OwnedArray<DrumSamplerVoice> voices;
+    int maxBlockSize = 0;
+    juce::uint64 nextStartOrder = 0;
+
+    DrumSamplerVoice &findVoiceToUse();
+    void choke(int chokeGroup);
+    static void mixVoice(const DrumSamplerVoice &voice,
+                         juce::AudioBuffer<float> &buffer, int startSample,
+                         int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumVoiceEngine)
+};
+
+} // namespace internal_plugins
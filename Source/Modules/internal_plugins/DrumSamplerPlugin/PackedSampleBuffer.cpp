@@ -0,0 +1,154 @@
+#include "PackedSampleBuffer.h"
+
+namespace internal_plugins {
+
+namespace {
+constexpr float int16Scale = 32768.0f;
+constexpr float int24Scale = 8388608.0f;
+
+// The conversion loops are kept simple so the compiler can vectorise them
+void floatToInt16(const float *source, juce::int16 *dest, int numSamples) {
+    for (int i = 0; i < numSamples; i++)
+        dest[i] = juce::int16(juce::jlimit(
+            -32768, 32767, juce::roundToInt(source[i] * int16Scale)));
+}
+
+void int16ToFloat(const juce::int16 *source, float *dest, int numSamples) {
+    constexpr auto scale = 1.0f / int16Scale;
+    for (int i = 0; i < numSamples; i++)
+        dest[i] = float(source[i]) * scale;
+}
+
+void floatToInt24(const float *source, juce::uint8 *dest, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        const auto value = juce::jlimit(
+            -8388608, 8388607, juce::roundToInt(source[i] * int24Scale));
+        dest[3 * i] = juce::uint8(value);
+        dest[3 * i + 1] = juce::uint8(value >> 8);
+        dest[3 * i + 2] = juce::uint8(value >> 16);
+    }
+}
+
+void int24ToFloat(const juce::uint8 *source, float *dest, int numSamples) {
+    constexpr auto scale = 1.0f / int24Scale;
+    for (int i = 0; i < numSamples; i++) {
+        // Build the value in the top 24 bits so the shift sign extends it
+        const auto value = juce::int32(juce::uint32(source[3 * i]) << 8 |
+                                       juce::uint32(source[3 * i + 1]) << 16 |
+                                       juce::uint32(source[3 * i + 2]) << 24) >>
+                           8;
+        dest[i] = float(value) * scale;
+    }
+}
+} // namespace
+
+PackedSampleBuffer::Format
+PackedSampleBuffer::getFormatForBitDepth(int bitDepth) {
+    switch (bitDepth) {
+    case 16:
+        return Format::int16;
+    case 24:
+        return Format::int24;
+    default:
+        return Format::float32;
+    }
+}
+
+int PackedSampleBuffer::getBytesPerSample(Format format) {
+    switch (format) {
+    case Format::int16:
+        return 2;
+    case Format::int24:
+        return 3;
+    case Format::float32:
+    default:
+        return 4;
+    }
+}
+
+void PackedSampleBuffer::setSize(int newNumChannels, int newNumSamples,
+                                 Format newFormat) {
+    format = newFormat;
+    numChannels = juce::jmax(0, newNumChannels);
+    numSamples = juce::jmax(0, newNumSamples);
+    data.calloc(getSizeInBytes());
+}
+
+void PackedSampleBuffer::readFromReader(juce::AudioFormatReader &reader,
+                                        juce::int64 readerStartSample) {
+    constexpr int blockLength = 16384;
+    juce::AudioBuffer<float> block(numChannels,
+                                   juce::jmin(blockLength, numSamples));
+
+    for (int position = 0; position < numSamples; position += blockLength) {
+        const auto numToRead = juce::jmin(blockLength, numSamples - position);
+        reader.read(&block, 0, numToRead, readerStartSample + position, true,
+                    true);
+
+        for (int channel = 0; channel < numChannels; channel++)
+            write(channel, position, block.getReadPointer(channel),
+                  numToRead);
+    }
+}
+
+void PackedSampleBuffer::write(int channel, int destStartSample,
+                               const float *source, int numSamplesToWrite) {
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    jassert(destStartSample >= 0 &&
+            destStartSample + numSamplesToWrite <= numSamples);
+
+    auto *dest = getChannelData(channel) +
+                 size_t(destStartSample) * size_t(getBytesPerSample(format));
+
+    switch (format) {
+    case Format::int16:
+        floatToInt16(source, reinterpret_cast<juce::int16 *>(dest),
+                     numSamplesToWrite);
+        break;
+    case Format::int24:
+        floatToInt24(source, reinterpret_cast<juce::uint8 *>(dest),
+                     numSamplesToWrite);
+        break;
+    case Format::float32:
+        juce::FloatVectorOperations::copy(reinterpret_cast<float *>(dest),
+                                          source, numSamplesToWrite);
+        break;
+    }
+}
+
+void PackedSampleBuffer::read(int channel, int startSample, float *dest,
+                              int numSamplesToRead) const {
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    jassert(startSample >= 0 && startSample + numSamplesToRead <= numSamples);
+
+    const auto *source =
+        getChannelData(channel) +
+        size_t(startSample) * size_t(getBytesPerSample(format));
+
+    switch (format) {
+    case Format::int16:
+        int16ToFloat(reinterpret_cast<const juce::int16 *>(source), dest,
+                     numSamplesToRead);
+        break;
+    case Format::int24:
+        int24ToFloat(reinterpret_cast<const juce::uint8 *>(source), dest,
+                     numSamplesToRead);
+        break;
+    case Format::float32:
+        juce::FloatVectorOperations::copy(
+            dest, reinterpret_cast<const float *>(source), numSamplesToRead);
+        break;
+    }
+}
+
+size_t PackedSampleBuffer::getSizeInBytes() const {
+    return size_t(numChannels) * size_t(numSamples) *
+           size_t(getBytesPerSample(format));
+}
+
+char *PackedSampleBuffer::getChannelData(int channel) const {
+    return data.get() + size_t(channel) * size_t(numSamples) *
+                            size_t(getBytesPerSample(format));
+}
+
+} // namespace internal_plugins
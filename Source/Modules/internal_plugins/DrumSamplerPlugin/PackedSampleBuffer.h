@@ -0,0 +1,49 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Holds decoded audio in memory using either 32 bit floats or 24 or 16 bit
+// packed integers. The integer formats use a half or less of the memory of
+// floats, which lets large kits fit on devices without much RAM. Samples are
+// converted back to floats as they are read.
+class PackedSampleBuffer {
+  public:
+    enum class Format { float32, int24, int16 };
+
+    PackedSampleBuffer() = default;
+
+    // Returns the format with the given bit depth, or float32 if there isn't
+    // one
+    static Format getFormatForBitDepth(int bitDepth);
+    static int getBytesPerSample(Format format);
+
+    // Clears the buffer and resizes it to hold the given number of samples
+    void setSize(int newNumChannels, int newNumSamples,
+                 Format newFormat = Format::float32);
+
+    // Reads the given number of samples from a reader into the buffer, in
+    // blocks so the whole sound is never held as floats
+    void readFromReader(juce::AudioFormatReader &reader,
+                        juce::int64 readerStartSample);
+
+    void write(int channel, int destStartSample, const float *source,
+               int numSamples);
+    void read(int channel, int startSample, float *dest, int numSamples) const;
+
+    int getNumChannels() const { return numChannels; }
+    int getNumSamples() const { return numSamples; }
+    Format getFormat() const { return format; }
+    size_t getSizeInBytes() const;
+
+  private:
+    Format format = Format::float32;
+    int numChannels = 0;
+    int numSamples = 0;
+    juce::HeapBlock<char> data;
+
+    char *getChannelData(int channel) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PackedSampleBuffer)
+};
+
+} // namespace internal_plugins
@@ -0,0 +1,155 @@
+#include "SampleStreamer.h"
+
+namespace internal_plugins {
+
+SampleStreamer::SampleStreamer(int numStreams) {
+    for (int i = 0; i < numStreams; i++)
+        streams.add(new Stream());
+}
+
+SampleStreamer::~SampleStreamer() { stopThread(); }
+
+void SampleStreamer::setSoundSet(DrumSoundSet::Ptr newSet,
+                                 DrumSoundSet::Ptr previousSet) {
+    const juce::ScopedLock sl(soundSetLock);
+    soundSet = std::move(newSet);
+    previousSoundSet = std::move(previousSet);
+}
+
+void SampleStreamer::startThread() { diskThread->addTimeSliceClient(this); }
+
+void SampleStreamer::stopThread() {
+    // This waits for the disk thread to finish with us if it is busy
+    diskThread->removeTimeSliceClient(this);
+}
+
+void SampleStreamer::start(int streamIndex, int soundIndex, int setVersion) {
+    auto &stream = *streams.getUnchecked(streamIndex);
+    stream.soundIndex.store(soundIndex, std::memory_order_relaxed);
+    stream.setVersion.store(setVersion, std::memory_order_relaxed);
+
+    auto generation =
+        getGeneration(stream.state.load(std::memory_order_relaxed)) + 1;
+    stream.state.store((generation << 2) | STARTING, std::memory_order_release);
+}
+
+void SampleStreamer::stop(int streamIndex) {
+    auto &stream = *streams.getUnchecked(streamIndex);
+    auto generation =
+        getGeneration(stream.state.load(std::memory_order_relaxed));
+    stream.state.store((generation << 2) | IDLE, std::memory_order_release);
+}
+
+int SampleStreamer::read(int streamIndex, juce::AudioBuffer<float> &dest,
+                         int startSample, int numSamples) {
+    auto &stream = *streams.getUnchecked(streamIndex);
+    if (getState(stream.state.load(std::memory_order_acquire)) != STREAMING) {
+        numUnderruns++;
+        return 0;
+    }
+
+    int start1, size1, start2, size2;
+    stream.fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    const auto numChannels = juce::jmin(dest.getNumChannels(), 2);
+    for (int channel = 0; channel < numChannels; channel++) {
+        if (size1 > 0)
+            dest.copyFrom(channel, startSample, stream.ring, channel, start1,
+                          size1);
+        if (size2 > 0)
+            dest.copyFrom(channel, startSample + size1, stream.ring, channel,
+                          start2, size2);
+    }
+
+    stream.fifo.finishedRead(size1 + size2);
+
+    if (size1 + size2 < numSamples)
+        numUnderruns++;
+
+    return size1 + size2;
+}
+
+int SampleStreamer::getNumUnderruns() const { return numUnderruns.load(); }
+
+int SampleStreamer::getNumActiveStreams() const {
+    int numActive = 0;
+    for (auto *stream : streams)
+        if (getState(stream->state.load(std::memory_order_relaxed)) != IDLE)
+            numActive++;
+
+    return numActive;
+}
+
+const DrumSoundSet *SampleStreamer::findSoundSet(int version) const {
+    for (auto *set : {soundSet.get(), previousSoundSet.get()})
+        if (set != nullptr && set->version == version)
+            return set;
+
+    return nullptr;
+}
+
+bool SampleStreamer::serviceStream(Stream &stream) {
+    const auto value = stream.state.load(std::memory_order_acquire);
+    const auto state = getState(value);
+    if (state == IDLE)
+        return false;
+
+    // Streams started with a set that is no longer kept are about to be
+    // stopped by the audio thread, so leave them alone
+    const auto *set =
+        findSoundSet(stream.setVersion.load(std::memory_order_relaxed));
+    if (set == nullptr)
+        return false;
+
+    auto *sound =
+        set->sounds[stream.soundIndex.load(std::memory_order_relaxed)];
+    if (sound == nullptr || sound->reader == nullptr)
+        return false;
+
+    if (state == STARTING) {
+        // The audio thread doesn't read from the stream until it is streaming
+        // so it is safe to reset the fifo here
+        stream.fifo.reset();
+        stream.nextReadPosition = sound->startSample + sound->getHeadLength();
+        stream.endPosition = sound->startSample + sound->lengthInSamples;
+
+        auto expected = value;
+        auto streaming = (getGeneration(value) << 2) | STREAMING;
+        if (!stream.state.compare_exchange_strong(expected, streaming,
+                                                  std::memory_order_acq_rel))
+            return true;
+    }
+
+    const auto numToRead = int(juce::jmin(
+        juce::int64(juce::jmin(stream.fifo.getFreeSpace(), readChunkLength)),
+        stream.endPosition - stream.nextReadPosition));
+    if (numToRead <= 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    stream.fifo.prepareToWrite(numToRead, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        sound->reader->read(&stream.ring, start1, size1,
+                            stream.nextReadPosition, true, true);
+    if (size2 > 0)
+        sound->reader->read(&stream.ring, start2, size2,
+                            stream.nextReadPosition + size1, true, true);
+
+    stream.fifo.finishedWrite(size1 + size2);
+    stream.nextReadPosition += size1 + size2;
+    return true;
+}
+
+int SampleStreamer::useTimeSlice() {
+    const juce::ScopedLock sl(soundSetLock);
+
+    bool isBusy = false;
+    for (auto *stream : streams)
+        isBusy = serviceStream(*stream) || isBusy;
+
+    // Come back straight away if there is still more to read
+    return isBusy ? 0 : 5;
+}
+
+} // namespace internal_plugins
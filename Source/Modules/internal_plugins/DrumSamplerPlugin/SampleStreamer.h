@@ -0,0 +1,95 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Streams the parts of DrumSounds that aren't held in memory. Each voice owns
+// one stream, which is a ring buffer that is kept filled by a disk thread
+// shared between all the drum samplers. The audio thread starts and stops
+// streams and reads from them without blocking. If a stream can't provide
+// the samples the audio thread asks for, an underrun is counted.
+// When the sounds are reloaded the set the audio thread is playing is kept
+// alongside the new one, so voices that are already playing can finish.
+class SampleStreamer : private juce::TimeSliceClient {
+  public:
+    // Number of samples of a streamed sound that are kept in memory. This has
+    // to cover the time it takes the disk thread to start filling a stream.
+    static constexpr int headLength = 8192;
+    static constexpr int ringLength = 8192;
+
+    explicit SampleStreamer(int numStreams);
+    ~SampleStreamer() override;
+
+    // Called on the message thread. The previous set is the one voices may
+    // still be playing while the audio thread switches to the new set.
+    void setSoundSet(DrumSoundSet::Ptr newSet,
+                     DrumSoundSet::Ptr previousSet = nullptr);
+    void startThread();
+    void stopThread();
+
+    // Called on the audio thread
+    void start(int streamIndex, int soundIndex, int setVersion);
+    void stop(int streamIndex);
+    int read(int streamIndex, juce::AudioBuffer<float> &dest, int startSample,
+             int numSamples);
+
+    int getNumUnderruns() const;
+    int getNumActiveStreams() const;
+
+  private:
+    enum StreamState : juce::uint32 { IDLE = 0, STARTING, STREAMING };
+
+    struct Stream {
+        // The state is packed together with a generation that is increased
+        // every time the stream is started, so the disk thread can tell if a
+        // stream was restarted while it was working on it.
+        std::atomic<juce::uint32> state{IDLE};
+        std::atomic<int> soundIndex{-1};
+        std::atomic<int> setVersion{0};
+
+        // Only used by the disk thread
+        juce::int64 nextReadPosition = 0;
+        juce::int64 endPosition = 0;
+
+        juce::AbstractFifo fifo{ringLength};
+        juce::AudioBuffer<float> ring{2, ringLength};
+    };
+
+    struct DiskThread : public juce::TimeSliceThread {
+        DiskThread() : juce::TimeSliceThread("DrumSampler Disk") {
+            // The first drum sampler is usually made on the message thread,
+            // which may be kept to the GUI cores, and the disk thread
+            // shouldn't inherit them or repaints could underrun the streams
+            setAffinityMask(~juce::uint32(0));
+            juce::TimeSliceThread::startThread();
+        }
+
+        ~DiskThread() override { juce::TimeSliceThread::stopThread(2000); }
+    };
+
+    static constexpr int readChunkLength = 2048;
+
+    juce::OwnedArray<Stream> streams;
+    juce::SharedResourcePointer<DiskThread> diskThread;
+
+    // Held by the disk thread while it is reading from the sound sets
+    juce::CriticalSection soundSetLock;
+    DrumSoundSet::Ptr soundSet;
+    DrumSoundSet::Ptr previousSoundSet;
+
+    std::atomic<int> numUnderruns{0};
+
+    static StreamState getState(juce::uint32 value) {
+        return StreamState(value & 3);
+    }
+
+    static juce::uint32 getGeneration(juce::uint32 value) { return value >> 2; }
+
+    const DrumSoundSet *findSoundSet(int version) const;
+    bool serviceStream(Stream &stream);
+
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleStreamer)
+};
+
+} // namespace internal_plugins
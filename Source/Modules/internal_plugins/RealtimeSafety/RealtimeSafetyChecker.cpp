@@ -0,0 +1,189 @@
+#include "RealtimeSafetyChecker.h"
+
+#if LMN3_REALTIME_SAFETY_CHECKS && JUCE_LINUX
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+namespace internal_plugins {
+
+namespace {
+std::atomic<RealtimeSafetyChecker *> activeChecker{nullptr};
+
+// Both are constant initialised, so reading them from inside malloc doesn't
+// allocate
+thread_local int realtimeSectionDepth = 0;
+// Set while a violation is being recorded, since recording it allocates and
+// locks
+thread_local bool isReporting = false;
+} // namespace
+
+RealtimeSafetyChecker::ScopedRealtimeSection::ScopedRealtimeSection() {
+    realtimeSectionDepth++;
+}
+
+RealtimeSafetyChecker::ScopedRealtimeSection::~ScopedRealtimeSection() {
+    realtimeSectionDepth--;
+}
+
+RealtimeSafetyChecker::RealtimeSafetyChecker()
+    : previousLogger(juce::Logger::getCurrentLogger()), logger(previousLogger) {
+    jassert(activeChecker == nullptr);
+    juce::Logger::setCurrentLogger(&logger);
+    activeChecker = this;
+}
+
+RealtimeSafetyChecker::~RealtimeSafetyChecker() {
+    activeChecker = nullptr;
+    juce::Logger::setCurrentLogger(previousLogger);
+}
+
+juce::Array<RealtimeSafetyChecker::Violation>
+RealtimeSafetyChecker::getViolations() const {
+    const std::lock_guard<std::mutex> lock(violationsMutex);
+    return violations;
+}
+
+void RealtimeSafetyChecker::clearViolations() {
+    const std::lock_guard<std::mutex> lock(violationsMutex);
+    violations.clear();
+}
+
+juce::String RealtimeSafetyChecker::describeViolations() const {
+    juce::String description;
+    for (const auto &violation : getViolations())
+        description << getTypeName(violation.type) << " on "
+                    << violation.threadName << "\n"
+                    << violation.stackTrace << "\n";
+
+    return description;
+}
+
+bool RealtimeSafetyChecker::canInterceptAllocations() {
+    return LMN3_REALTIME_SAFETY_CHECKS && JUCE_LINUX;
+}
+
+bool RealtimeSafetyChecker::isInRealtimeSection() {
+    return realtimeSectionDepth > 0;
+}
+
+void RealtimeSafetyChecker::reportViolation(ViolationType type) {
+    if (realtimeSectionDepth == 0 || isReporting)
+        return;
+
+    auto *checker = activeChecker.load();
+    if (checker == nullptr)
+        return;
+
+    isReporting = true;
+
+    // Scoped so the violation is freed before reporting is turned back on
+    {
+        Violation violation;
+        violation.type = type;
+        if (auto *thread = juce::Thread::getCurrentThread())
+            violation.threadName = thread->getThreadName();
+        else
+            violation.threadName =
+                "thread " + juce::String::toHexString(juce::pointer_sized_int(
+                                juce::Thread::getCurrentThreadId()));
+        violation.stackTrace = juce::SystemStats::getStackBacktrace();
+        checker->addViolation(std::move(violation));
+    }
+
+    isReporting = false;
+}
+
+juce::String RealtimeSafetyChecker::getTypeName(ViolationType type) {
+    switch (type) {
+    case ViolationType::ALLOCATION:
+        return "Allocation";
+    case ViolationType::DEALLOCATION:
+        return "Deallocation";
+    case ViolationType::LOCK:
+        return "Lock";
+    case ViolationType::LOGGING:
+        return "Logging";
+    }
+
+    return {};
+}
+
+void RealtimeSafetyChecker::addViolation(Violation violation) {
+    const std::lock_guard<std::mutex> lock(violationsMutex);
+    if (violations.size() < maxNumViolations)
+        violations.add(std::move(violation));
+}
+
+RealtimeSafetyChecker::CheckingLogger::CheckingLogger(juce::Logger *previous)
+    : previousLogger(previous) {}
+
+void RealtimeSafetyChecker::CheckingLogger::logMessage(
+    const juce::String &message) {
+    reportViolation(ViolationType::LOGGING);
+
+    if (previousLogger != nullptr)
+        previousLogger->logMessage(message);
+    else
+        juce::Logger::outputDebugString(message);
+}
+
+} // namespace internal_plugins
+
+#if LMN3_REALTIME_SAFETY_CHECKS && JUCE_LINUX
+// These replace the C library's functions for the whole process. The
+// allocation functions forward to glibc's own entry points, which avoids
+// looking them up while the dynamic linker may itself be allocating.
+extern "C" {
+void *__libc_malloc(size_t size) noexcept;
+void *__libc_calloc(size_t count, size_t size) noexcept;
+void *__libc_realloc(void *ptr, size_t size) noexcept;
+void __libc_free(void *ptr) noexcept;
+
+void *malloc(size_t size) noexcept {
+    internal_plugins::RealtimeSafetyChecker::reportViolation(
+        internal_plugins::RealtimeSafetyChecker::ViolationType::ALLOCATION);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+    internal_plugins::RealtimeSafetyChecker::reportViolation(
+        internal_plugins::RealtimeSafetyChecker::ViolationType::ALLOCATION);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept {
+    internal_plugins::RealtimeSafetyChecker::reportViolation(
+        internal_plugins::RealtimeSafetyChecker::ViolationType::ALLOCATION);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) noexcept {
+    if (ptr != nullptr)
+        internal_plugins::RealtimeSafetyChecker::reportViolation(
+            internal_plugins::RealtimeSafetyChecker::ViolationType::
+                DEALLOCATION);
+    __libc_free(ptr);
+}
+
+// Only blocking locks are reported, try locks are how the audio thread is
+// meant to share data
+int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept {
+    using LockFunction = int (*)(pthread_mutex_t *);
+
+    // Constant initialised, so there's no guard that could itself lock.
+    // Racing lookups find the same function, so that's harmless.
+    static std::atomic<LockFunction> nextLock{nullptr};
+    auto lock = nextLock.load(std::memory_order_relaxed);
+    if (lock == nullptr) {
+        lock = reinterpret_cast<LockFunction>(
+            dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        nextLock.store(lock, std::memory_order_relaxed);
+    }
+
+    internal_plugins::RealtimeSafetyChecker::reportViolation(
+        internal_plugins::RealtimeSafetyChecker::ViolationType::LOCK);
+    return lock(mutex);
+}
+}
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+// Targets that want allocations and locks checked (e.g. the tests) build with
+// this set to 1, which replaces malloc, free and pthread_mutex_lock for the
+// whole process. It is only supported on Linux.
+#ifndef LMN3_REALTIME_SAFETY_CHECKS
+#define LMN3_REALTIME_SAFETY_CHECKS 0
+#endif
+
+namespace internal_plugins {
+
+// Records allocations, frees, blocking locks and logging made by code that
+// runs on the audio thread. Audio code marks itself with a
+// ScopedRealtimeSection, so it is checked even when it runs on a render
+// thread during an offline render. The interposed functions see the whole
+// process, so code that can't mark itself, such as a hosted plugin or one of
+// the engine's built in plugins, is checked by marking the call into it.
+// Violations are only recorded while a checker exists, and each one keeps the
+// stack trace of where it happened.
+class RealtimeSafetyChecker {
+  public:
+    enum class ViolationType { ALLOCATION, DEALLOCATION, LOCK, LOGGING };
+
+    struct Violation {
+        ViolationType type;
+        juce::String threadName;
+        juce::String stackTrace;
+    };
+
+    // Marks the code run on the current thread while it exists as real-time.
+    // Sections can be nested.
+    class ScopedRealtimeSection {
+      public:
+        ScopedRealtimeSection();
+        ~ScopedRealtimeSection();
+
+      private:
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeSection)
+    };
+
+    // Only one checker can exist at a time
+    RealtimeSafetyChecker();
+    ~RealtimeSafetyChecker();
+
+    juce::Array<Violation> getViolations() const;
+    void clearViolations();
+
+    // Returns one line per violation followed by its stack trace
+    juce::String describeViolations() const;
+
+    // Returns false if allocations and locks can't be intercepted in this
+    // build, in which case only logging is checked
+    static bool canInterceptAllocations();
+    static bool isInRealtimeSection();
+
+    // Called by the interposed functions, does nothing unless the current
+    // thread is in a real-time section and a checker exists
+    static void reportViolation(ViolationType type);
+
+    static juce::String getTypeName(ViolationType type);
+
+  private:
+    // Logging isn't a function that can be interposed, so the checker
+    // installs a logger that reports it before passing the message on
+    class CheckingLogger : public juce::Logger {
+      public:
+        explicit CheckingLogger(juce::Logger *previous);
+        void logMessage(const juce::String &message) override;
+
+      private:
+        juce::Logger *previousLogger;
+    };
+
+    // Keeps a plugin that allocates on every block from using up the memory
+    static constexpr int maxNumViolations = 100;
+
+    void addViolation(Violation violation);
+
+    mutable std::mutex violationsMutex;
+    juce::Array<Violation> violations;
+    juce::Logger *previousLogger;
+    CheckingLogger logger;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeSafetyChecker)
+};
+
+} // namespace internal_plugins
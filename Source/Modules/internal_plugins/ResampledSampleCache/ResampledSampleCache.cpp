@@ -0,0 +1,266 @@
+#include "ResampledSampleCache.h"
+
+namespace internal_plugins {
+
+JUCE_IMPLEMENT_SINGLETON(ResampledSampleCache)
+
+namespace {
+
+// Number of output samples converted at a time
+constexpr int conversionBlockLength = 4096;
+
+// A windowed sinc lowpass used to work out each output sample from the input
+// samples around it. The cutoff is a little below the lower of the two
+// Nyquist frequencies, so content that can't be represented at the new rate
+// is filtered out rather than aliased when downsampling. The Blackman window
+// keeps the stopband more than 70dB down.
+class ResamplingKernel {
+  public:
+    explicit ResamplingKernel(double speedRatio)
+        : cutoff(juce::jmin(1.0, 1.0 / speedRatio) * passband),
+          halfWidth(double(zeroCrossings) / cutoff),
+          table(size_t(zeroCrossings * resolution + 2)) {
+        const auto pi = juce::MathConstants<double>::pi;
+        for (size_t i = 0; i < table.size(); i++) {
+            const auto x = double(i) / double(resolution);
+            const auto phase = juce::jmin(1.0, x / double(zeroCrossings));
+            const auto window = 0.42 + 0.5 * std::cos(pi * phase) +
+                                0.08 * std::cos(2.0 * pi * phase);
+            const auto sinc = i == 0 ? 1.0 : std::sin(pi * x) / (pi * x);
+            table[i] = float(sinc * window);
+        }
+    }
+
+    // Half the length of the kernel in input samples
+    double getHalfWidth() const { return halfWidth; }
+
+    // The weight of an input sample the given number of input samples away
+    // from the output sample
+    float getWeight(double distance) const {
+        const auto position = std::abs(distance) * cutoff * double(resolution);
+        const auto index = size_t(position);
+        if (index + 1 >= table.size())
+            return 0.0f;
+
+        const auto fraction = float(position - double(index));
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+  private:
+    static constexpr int zeroCrossings = 32;
+    static constexpr int resolution = 256;
+    static constexpr double passband = 0.9;
+
+    const double cutoff;
+    const double halfWidth;
+
+    // The windowed sinc from zero to the last zero crossing
+    std::vector<float> table;
+};
+
+} // namespace
+
+ResampledSampleCache::ResampledSampleCache()
+    : directory(juce::File::getSpecialLocation(
+                    juce::File::userApplicationDataDirectory)
+                    .getChildFile("LMN-3")
+                    .getChildFile("sample_cache")) {}
+
+ResampledSampleCache::~ResampledSampleCache() {
+    threadPool.removeAllJobs(true, 10000);
+    clearSingletonInstance();
+}
+
+void ResampledSampleCache::setDirectory(const juce::File &newDirectory) {
+    const juce::ScopedLock sl(lock);
+    directory = newDirectory;
+    cachedFiles.clear();
+}
+
+juce::File ResampledSampleCache::getDirectory() const {
+    const juce::ScopedLock sl(lock);
+    return directory;
+}
+
+juce::File ResampledSampleCache::getFileForSampleRate(
+    const juce::File &file, double fileSampleRate, double targetSampleRate) {
+    if (fileSampleRate == targetSampleRate || targetSampleRate <= 0.0)
+        return file;
+
+    const auto key = getKey(file, targetSampleRate);
+
+    const juce::ScopedLock sl(lock);
+    if (cachedFiles.contains(key)) {
+        const auto cachedFile = cachedFiles[key];
+        if (cachedFile.existsAsFile())
+            return cachedFile;
+
+        // The copy has been deleted since, so it needs to be made again
+        cachedFiles.remove(key);
+    }
+
+    if (pendingFiles.contains(key) || failedFiles.contains(key))
+        return file;
+
+    // Finding the copy means hashing the file, so that is done on the
+    // background thread along with the conversion
+    pendingFiles.add(key);
+    threadPool.addJob([this, file, key, targetSampleRate] {
+        // The pool's thread was started by whichever thread made the cache,
+        // which may have been kept to the GUI cores
+        juce::Thread::setCurrentThreadAffinityMask(~juce::uint32(0));
+
+        const auto cachedFile = getCachedFile(file, targetSampleRate);
+        auto success = cachedFile != juce::File();
+        if (success && !cachedFile.existsAsFile())
+            success = convertFile(file, cachedFile, targetSampleRate);
+
+        if (!success)
+            juce::Logger::writeToLog("Unable to resample " +
+                                     file.getFullPathName());
+
+        const juce::ScopedLock sl(lock);
+        pendingFiles.removeString(key);
+        if (success)
+            cachedFiles.set(key, cachedFile);
+        else
+            failedFiles.add(key);
+
+        if (pendingFiles.isEmpty())
+            sendChangeMessage();
+    });
+
+    return file;
+}
+
+bool ResampledSampleCache::isConverting() const {
+    const juce::ScopedLock sl(lock);
+    return !pendingFiles.isEmpty();
+}
+
+juce::String ResampledSampleCache::getKey(const juce::File &file,
+                                          double targetSampleRate) {
+    return file.getFullPathName() + "|" + juce::String(file.getSize()) + "|" +
+           juce::String(file.getLastModificationTime().toMilliseconds()) +
+           "|" + juce::String(juce::roundToInt(targetSampleRate));
+}
+
+juce::File ResampledSampleCache::getCachedFile(const juce::File &file,
+                                               double targetSampleRate) {
+    juce::FileInputStream stream(file);
+    if (stream.failedToOpen())
+        return {};
+
+    // The samples are copied to a new location every time the app starts, so
+    // the cache is keyed on the contents of the file rather than its path or
+    // modification time. Hashing the start and end of the file is enough to
+    // tell samples apart without reading all of them.
+    const auto fileSize = stream.getTotalLength();
+    const size_t numBytesToHash = 65536;
+
+    juce::MemoryBlock data;
+    data.append(&fileSize, sizeof(fileSize));
+    stream.readIntoMemoryBlock(data, numBytesToHash);
+    if (fileSize > juce::int64(numBytesToHash)) {
+        stream.setPosition(juce::jmax(juce::int64(numBytesToHash),
+                                      fileSize - juce::int64(numBytesToHash)));
+        stream.readIntoMemoryBlock(data, numBytesToHash);
+    }
+
+    const auto hash = juce::MD5(data).toHexString().substring(0, 16);
+    return getDirectory()
+        .getChildFile(juce::String(juce::roundToInt(targetSampleRate)))
+        .getChildFile(file.getFileNameWithoutExtension() + "-" + hash +
+                      ".wav");
+}
+
+bool ResampledSampleCache::convertFile(const juce::File &source,
+                                       const juce::File &dest,
+                                       double targetSampleRate) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(source));
+    if (reader == nullptr || reader->sampleRate <= 0.0 ||
+        reader->lengthInSamples <= 0 || targetSampleRate <= 0.0)
+        return false;
+
+    const auto numChannels = int(reader->numChannels);
+    const auto speedRatio = reader->sampleRate / targetSampleRate;
+    const auto numOutputSamples = juce::int64(
+        std::llround(double(reader->lengthInSamples) / speedRatio));
+
+    const ResamplingKernel kernel(speedRatio);
+    const auto halfWidth = kernel.getHalfWidth();
+    const auto maxNumTaps = int(std::ceil(2.0 * halfWidth)) + 1;
+    const auto maxInputLength = int(std::ceil(
+        double(conversionBlockLength) * speedRatio + 2.0 * halfWidth)) + 1;
+
+    // Write to a temporary file first so a half written file is never used
+    dest.getParentDirectory().createDirectory();
+    juce::TemporaryFile tempFile(dest);
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(
+        new juce::FileOutputStream(tempFile.getFile()), targetSampleRate,
+        juce::uint32(numChannels), 32, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return false;
+
+    juce::AudioBuffer<float> input(numChannels, maxInputLength);
+    juce::AudioBuffer<float> output(numChannels, conversionBlockLength);
+    std::vector<float> weights(size_t(maxNumTaps));
+
+    for (juce::int64 outputStart = 0; outputStart < numOutputSamples;
+         outputStart += conversionBlockLength) {
+        const auto numThisTime =
+            int(juce::jmin(juce::int64(conversionBlockLength),
+                           numOutputSamples - outputStart));
+
+        // Read the input the block needs, the reader fills anything before
+        // the start or after the end of the file with silence
+        const auto inputStart = juce::int64(
+            std::ceil(double(outputStart) * speedRatio - halfWidth));
+        const auto inputEnd = juce::int64(std::floor(
+            double(outputStart + numThisTime - 1) * speedRatio + halfWidth));
+        const auto numInputSamples = int(inputEnd - inputStart) + 1;
+        jassert(numInputSamples <= maxInputLength);
+        reader->read(&input, 0, numInputSamples, inputStart, true, true);
+
+        for (int i = 0; i < numThisTime; i++) {
+            const auto position = double(outputStart + i) * speedRatio;
+            const auto firstTap = juce::int64(std::ceil(position - halfWidth));
+            const auto numTaps =
+                int(juce::int64(std::floor(position + halfWidth)) - firstTap) +
+                1;
+
+            // Normalising by the sum of the weights keeps the gain at exactly
+            // one whatever the fractional position
+            float weightSum = 0.0f;
+            for (int tap = 0; tap < numTaps; tap++) {
+                weights[size_t(tap)] =
+                    kernel.getWeight(position - double(firstTap + tap));
+                weightSum += weights[size_t(tap)];
+            }
+
+            const auto offset = int(firstTap - inputStart);
+            for (int channel = 0; channel < numChannels; channel++) {
+                const auto *samples = input.getReadPointer(channel, offset);
+                float sum = 0.0f;
+                for (int tap = 0; tap < numTaps; tap++)
+                    sum += samples[tap] * weights[size_t(tap)];
+
+                output.setSample(channel, i, sum / weightSum);
+            }
+        }
+
+        if (!writer->writeFromAudioSampleBuffer(output, 0, numThisTime))
+            return false;
+    }
+
+    writer.reset();
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+} // namespace internal_plugins
@@ -0,0 +1,54 @@
+#pragma once
+
+namespace internal_plugins {
+
+// Keeps copies of samples that have been converted to the device sample rate
+// so the sampler voices don't need to resample them while playing. Copies
+// are made once on a background thread using a windowed sinc resampler,
+// which filters out anything above the new Nyquist frequency when
+// downsampling, and are kept in the cache directory between runs. Listeners
+// are sent a change message once all the pending conversions have finished.
+class ResampledSampleCache : public juce::ChangeBroadcaster,
+                             private juce::DeletedAtShutdown {
+  public:
+    ResampledSampleCache();
+    ~ResampledSampleCache() override;
+
+    void setDirectory(const juce::File &newDirectory);
+    juce::File getDirectory() const;
+
+    // Returns the file to load for playback at the target sample rate. If the
+    // file doesn't have that rate, this is the cached copy if it is known.
+    // Otherwise the copy is looked for (and made if needed) on the background
+    // thread and the original file is returned.
+    juce::File getFileForSampleRate(const juce::File &file,
+                                    double fileSampleRate,
+                                    double targetSampleRate);
+
+    bool isConverting() const;
+
+    // Converts the file synchronously a block at a time, returns true if it
+    // was successful
+    static bool convertFile(const juce::File &source, const juce::File &dest,
+                            double targetSampleRate);
+
+    JUCE_DECLARE_SINGLETON(ResampledSampleCache, false)
+
+  private:
+    juce::CriticalSection lock;
+    juce::File directory;
+    // These are keyed on the file's path, size and modification time, so
+    // the file is only hashed the first time it is asked for
+    juce::HashMap<juce::String, juce::File> cachedFiles;
+    juce::StringArray pendingFiles;
+    juce::StringArray failedFiles;
+    juce::ThreadPool threadPool{1};
+
+    static juce::String getKey(const juce::File &file,
+                               double targetSampleRate);
+    juce::File getCachedFile(const juce::File &file, double targetSampleRate);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResampledSampleCache)
+};
+
+} // namespace internal_plugins
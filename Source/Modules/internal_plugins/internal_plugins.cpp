@@ -1,4 +1,11 @@
 // clang-format off
 #include "internal_plugins.h"
 
+#include "RealtimeSafety/RealtimeSafetyChecker.cpp"
+#include "ResampledSampleCache/ResampledSampleCache.cpp"
+#include "DrumSamplerPlugin/PackedSampleBuffer.cpp"
+#include "DrumSamplerPlugin/DrumSound.cpp"
+#include "DrumSamplerPlugin/SampleStreamer.cpp"
+#include "DrumSamplerPlugin/DrumSamplerVoice.cpp"
+#include "DrumSamplerPlugin/DrumVoiceEngine.cpp"
 #include "DrumSamplerPlugin/DrumSamplerPlugin.cpp"
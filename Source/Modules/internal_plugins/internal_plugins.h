@@ -8,7 +8,7 @@
   description:      Internal plugins for app
   website:          http://github.com/stonepreston
   license:          GPL-3.0
-  dependencies:     juce_data_structures tracktion_engine juce_events juce_core juce_graphics
+  dependencies:     juce_data_structures tracktion_engine juce_events juce_core juce_graphics juce_audio_formats
  END_JUCE_MODULE_DECLARATION
 *******************************************************************************/
 #pragma once
@@ -16,6 +16,14 @@
 namespace internal_plugins {
 
     class DrumSamplerPlugin;
+    class DrumSamplerVoice;
+    class DrumSoundSet;
+    class DrumVoiceEngine;
+    class PackedSampleBuffer;
+    class RealtimeSafetyChecker;
+    class ResampledSampleCache;
+    class SampleStreamer;
+    struct DrumSound;
 
 }
 
@@ -23,9 +31,19 @@ namespace internal_plugins {
 #include <juce_events/juce_events.h>
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include <atomic>
 #include <functional>
-
+#include <mutex>
+
+#include "RealtimeSafety/RealtimeSafetyChecker.h"
+#include "ResampledSampleCache/ResampledSampleCache.h"
+#include "DrumSamplerPlugin/PackedSampleBuffer.h"
+#include "DrumSamplerPlugin/DrumSound.h"
+#include "DrumSamplerPlugin/SampleStreamer.h"
+#include "DrumSamplerPlugin/DrumSamplerVoice.h"
+#include "DrumSamplerPlugin/DrumVoiceEngine.h"
 #include "DrumSamplerPlugin/DrumSamplerPlugin.h"
 
 
@@ -7,14 +7,8 @@ App::App(tracktion::Edit &e, app_services::MidiCommandManager &mcm)
       editTabBarView(edit, midiCommandManager) {
     edit.setTimecodeFormat(tracktion::TimecodeType::millisecs);
 
-    auto userAppDataDirectory = juce::File::getSpecialLocation(
-        juce::File::userApplicationDataDirectory);
-    auto configFile =
-        userAppDataDirectory.getChildFile(JUCE_APPLICATION_NAME_STRING)
-            .getChildFile("config.yaml");
-    auto width = int(ConfigurationHelpers::getWidth(configFile));
-    auto height = int(ConfigurationHelpers::getHeight(configFile));
-    setSize(width, height);
+    auto appConfig = AppConfig::getCurrent();
+    setSize(int(appConfig->width), int(appConfig->height));
 
     setLookAndFeel(&lookAndFeel);
 
@@ -42,4 +36,9 @@ void App::resized() {
 }
 
 void App::showProgressView() { progressView.setVisible(true); }
-void App::hideProgressView() { progressView.setVisible(false); }
+void App::hideProgressView() {
+    progressView.setVisible(false);
+    progressView.setProgress(-1.0f);
+}
+
+void App::setProgress(float progress) { progressView.setProgress(progress); }
@@ -19,6 +19,7 @@ class App : public juce::Component,
     void resized() override;
     void showProgressView();
     void hideProgressView();
+    void setProgress(float progress);
 
   private:
     tracktion::Edit &edit;
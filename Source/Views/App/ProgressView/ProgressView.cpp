@@ -2,6 +2,13 @@
 
 ProgressView::ProgressView() {
     addAndMakeVisible(svgImageComponent);
+
+    progressLabel.setJustificationType(juce::Justification::centred);
+    progressLabel.setColour(juce::Label::textColourId,
+                            appLookAndFeel.blackColour);
+    progressLabel.setInterceptsMouseClicks(false, false);
+    addChildComponent(progressLabel);
+
     startTimerHz(refreshRate);
 }
 
@@ -14,6 +21,16 @@ void ProgressView::resized() {
     auto angle = speed * juce::MathConstants<float>::pi / refreshRate;
     setRotatedWithBounds(svgImageComponent, float(angle), true,
                          getLocalBounds().reduced(4));
+
+    progressLabel.setFont(juce::Font(float(getHeight()) / 4.0f));
+    progressLabel.setBounds(getLocalBounds());
+}
+
+void ProgressView::setProgress(float progress) {
+    progressLabel.setVisible(progress >= 0.0f);
+    progressLabel.setText(juce::String(juce::roundToInt(progress * 100.0f)) +
+                              "%",
+                          juce::dontSendNotification);
 }
 
 void ProgressView::timerCallback() { resized(); }
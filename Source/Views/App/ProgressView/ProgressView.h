@@ -8,9 +8,14 @@ class ProgressView : public juce::Component, private juce::Timer {
     ProgressView();
     void resized() override;
 
+    // Shows how far through the task is, from 0 to 1. A negative progress
+    // hides it for tasks that can't tell how long they will take.
+    void setProgress(float progress);
+
   private:
     AppLookAndFeel appLookAndFeel;
     SVGImageComponent svgImageComponent;
+    juce::Label progressLabel;
     int refreshRate = 30;
     void timerCallback() override;
 
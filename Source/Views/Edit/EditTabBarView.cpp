@@ -1,5 +1,7 @@
 #include "EditTabBarView.h"
+#include "App.h"
 #include "AvailableSequencersListView.h"
+#include "ExtendedUIBehaviour.h"
 #include "FourOscView.h"
 #include "MixerView.h"
 #include "PluginView.h"
@@ -8,24 +10,45 @@
 #include "TrackModifiersListView.h"
 #include "TrackPluginsListView.h"
 #include "TracksView.h"
+
+static app_services::EditSaver *getEditSaver(tracktion::Edit &edit) {
+    if (auto uiBehaviour = dynamic_cast<ExtendedUIBehaviour *>(
+            &edit.engine.getUIBehaviour()))
+        return uiBehaviour->getEditSaver();
+
+    return nullptr;
+}
+
 EditTabBarView::EditTabBarView(tracktion::Edit &e,
                                app_services::MidiCommandManager &mcm)
     : TabbedComponent(juce::TabbedButtonBar::Orientation::TabsAtTop), edit(e),
-      midiCommandManager(mcm), viewModel(edit) {
+      midiCommandManager(mcm), viewModel(edit, getEditSaver(edit)) {
     // Note: Some tabs are on a per-track basis and are added in
     // selectedIndexChanged, not here this is possible since this view is a
     // listener of the tracks item list state
     addTab(tracksTabName, juce::Colours::transparentBlack,
            new TracksView(edit, midiCommandManager), true);
-    addTab(tempoSettingsTabName, juce::Colours::transparentBlack,
-           new TempoSettingsView(edit, midiCommandManager), true);
-    addTab(mixerTabName, juce::Colours::transparentBlack,
-           new MixerView(edit, midiCommandManager), true);
-    addTab(settingsTabName, juce::Colours::transparentBlack,
-           new app_navigation::StackNavigationController(new SettingsListView(
-               edit, edit.engine.getDeviceManager().deviceManager,
-               midiCommandManager)),
-           true);
+
+    if (auto uiBehaviour = dynamic_cast<ExtendedUIBehaviour *>(
+            &edit.engine.getUIBehaviour())) {
+        editSaver = uiBehaviour->getEditSaver();
+        deferredTaskQueue = uiBehaviour->getDeferredTaskQueue();
+    }
+
+    // Only the tracks tab is needed to show the first screen, the others are
+    // created after startup or as soon as they are asked for
+    addDeferredTab(tempoSettingsTabName, [this]() -> juce::Component * {
+        return new TempoSettingsView(edit, midiCommandManager);
+    });
+    addDeferredTab(mixerTabName, [this]() -> juce::Component * {
+        return new MixerView(edit, midiCommandManager);
+    });
+    addDeferredTab(settingsTabName, [this]() -> juce::Component * {
+        return new app_navigation::StackNavigationController(
+            new SettingsListView(edit,
+                                 edit.engine.getDeviceManager().deviceManager,
+                                 midiCommandManager));
+    });
 
     juce::StringArray tabNames = getTabNames();
     int tracksIndex = tabNames.indexOf(tracksTabName);
@@ -48,6 +71,9 @@ EditTabBarView::EditTabBarView(tracktion::Edit &e,
     midiCommandManager.addListener(this);
     viewModel.addListener(this);
 
+    if (editSaver != nullptr)
+        editSaver->addListener(this);
+
     // Set tracks as initial view
     setCurrentTabIndex(tracksIndex);
 }
@@ -55,6 +81,13 @@ EditTabBarView::EditTabBarView(tracktion::Edit &e,
 EditTabBarView::~EditTabBarView() {
     midiCommandManager.removeListener(this);
     viewModel.removeListener(this);
+    if (editSaver != nullptr)
+        editSaver->removeListener(this);
+
+    if (deferredTaskQueue != nullptr)
+        for (const auto &tab : deferredTabs)
+            deferredTaskQueue->cancelTask(getDeferredTabTaskName(tab.first));
+
     juce::StringArray tabNames = getTabNames();
     int tracksIndex = tabNames.indexOf(tracksTabName);
 
@@ -62,6 +95,11 @@ EditTabBarView::~EditTabBarView() {
             dynamic_cast<TracksView *>(getTabContentComponent(tracksIndex)))
         tracksView->getViewModel().listViewModel.itemListState.removeListener(
             this);
+
+    // The cached track views aren't owned by the tabs, so remove them before
+    // the cache deletes them
+    clearTabs();
+    trackTabViews.clear();
 }
 
 void EditTabBarView::paint(juce::Graphics &g) {
@@ -106,6 +144,7 @@ void EditTabBarView::tracksButtonReleased() {
 
 void EditTabBarView::tempoSettingsButtonReleased() {
     if (isShowing()) {
+        createDeferredTab(tempoSettingsTabName);
         juce::StringArray tabNames = getTabNames();
         int index = tabNames.indexOf(tempoSettingsTabName);
         if (index != getCurrentTabIndex()) {
@@ -119,49 +158,126 @@ void EditTabBarView::tempoSettingsButtonReleased() {
 void EditTabBarView::saveButtonReleased() {
     if (isShowing()) {
         juce::Logger::writeToLog("Saving edit ...");
-        tracktion::EditFileOperations fileOperations(edit);
-        fileOperations.save(true, true, false);
+
+        // The message is shown by editSaved once the file has been written
+        if (editSaver != nullptr) {
+            showSaveMessage = true;
+            editSaver->save();
+        } else {
+            editSaved(false);
+        }
+    }
+}
+
+void EditTabBarView::editSaved(bool success) {
+    if (success)
         juce::Logger::writeToLog("Save complete!");
 
-        messageBox.setMessage("Save Complete!");
-        // must call resized so message box width is updated to fit text
-        resized();
-        messageBox.setVisible(true);
-        startTimer(1000);
+    if (showSaveMessage || editSaver == nullptr) {
+        showSaveMessage = false;
+        showMessage(success ? "Save Complete!" : "Save Failed!");
     }
 }
 
 void EditTabBarView::renderButtonReleased() {
     if (isShowing()) {
+        if (renderJob != nullptr && renderJob->isRendering())
+            return;
+
         juce::Logger::writeToLog("Rendering edit ...");
         auto userAppDataDirectory = juce::File::getSpecialLocation(
             juce::File::userApplicationDataDirectory);
 
         auto renderFileName = std::to_string(juce::Time::currentTimeMillis());
 
-        auto renderFile = userAppDataDirectory.getChildFile(applicationName)
-                              .getChildFile("renders")
-                              .getNonexistentChildFile(renderFileName, ".wav");
+        auto rendersDirectory =
+            userAppDataDirectory.getChildFile(applicationName)
+                .getChildFile("renders");
+
+        // Exports are written at the rate the edit is being played at
+        app_services::EditRenderJob::Options options;
+        options.sampleRate = edit.engine.getDeviceManager().getSampleRate();
+
+        // Holding control exports each track to its own file as well as the
+        // master mix
+        if (midiCommandManager.isControlDown) {
+            auto stemsDirectory =
+                rendersDirectory.getNonexistentChildFile(renderFileName, "");
+            renderJob = std::make_unique<app_services::EditRenderJob>(
+                edit,
+                app_services::EditRenderJob::getStemRenders(edit,
+                                                            stemsDirectory),
+                options);
+        } else {
+            auto renderFile = rendersDirectory.getNonexistentChildFile(
+                renderFileName, ".wav");
 
-        auto timeRange = tracktion::TimeRange(
-            tracktion::TimePosition::fromSeconds(0.0), edit.getLength());
-        juce::BigInteger tracksToDo{0};
-        for (auto i = 0; i < tracktion::getAllTracks(edit).size(); i++)
-            tracksToDo.setBit(i);
+            juce::BigInteger tracksToDo{0};
+            for (auto i = 0; i < tracktion::getAllTracks(edit).size(); i++)
+                tracksToDo.setBit(i);
+
+            renderJob = std::make_unique<app_services::EditRenderJob>(
+                edit, renderFile, tracksToDo, options);
+        }
+
+        // The render runs in the background, renderFinished is called once
+        // the files have been written
+        renderJob->addListener(this);
+        renderJob->start();
+
+        if (auto app = findParentComponentOfClass<App>()) {
+            app->showProgressView();
+            app->setProgress(0.0f);
+        }
+    }
+}
+
+void EditTabBarView::stopButtonReleased() {
+    if (renderJob != nullptr && renderJob->isRendering()) {
+        juce::Logger::writeToLog("Cancelling render ...");
+        renderJob->cancel();
+    }
+}
+
+void EditTabBarView::renderProgressChanged(float progress) {
+    if (auto app = findParentComponentOfClass<App>())
+        app->setProgress(progress);
+}
+
+void EditTabBarView::renderFinished(
+    app_services::EditRenderJob::Result result) {
+    if (auto app = findParentComponentOfClass<App>())
+        app->hideProgressView();
+
+    switch (result) {
+    case app_services::EditRenderJob::Result::SUCCEEDED:
+        for (const auto &file : renderJob->getDestinationFiles())
+            juce::Logger::writeToLog("Rendered " + file.getFullPathName());
 
-        tracktion::Renderer::renderToFile("Render", renderFile, edit, timeRange,
-                                          tracksToDo, true, {}, true);
         juce::Logger::writeToLog("Render complete!");
-        messageBox.setMessage("Render Complete!");
-        // must call resized so message box width is updated to fit text
-        resized();
-        messageBox.setVisible(true);
-        startTimer(1000);
+        showMessage("Render Complete!");
+        break;
+    case app_services::EditRenderJob::Result::CANCELLED:
+        juce::Logger::writeToLog("Render cancelled");
+        showMessage("Render Cancelled");
+        break;
+    case app_services::EditRenderJob::Result::FAILED:
+        showMessage("Render Failed!");
+        break;
     }
 }
 
+void EditTabBarView::showMessage(const juce::String &message) {
+    messageBox.setMessage(message);
+    // must call resized so message box width is updated to fit text
+    resized();
+    messageBox.setVisible(true);
+    startTimer(1000);
+}
+
 void EditTabBarView::mixerButtonReleased() {
     if (isShowing()) {
+        createDeferredTab(mixerTabName);
         juce::StringArray tabNames = getTabNames();
         int index = tabNames.indexOf(mixerTabName);
         if (index != getCurrentTabIndex()) {
@@ -174,6 +290,7 @@ void EditTabBarView::mixerButtonReleased() {
 
 void EditTabBarView::settingsButtonReleased() {
     if (isShowing()) {
+        createDeferredTab(settingsTabName);
         juce::StringArray tabNames = getTabNames();
         int index = tabNames.indexOf(settingsTabName);
         if (index != getCurrentTabIndex()) {
@@ -289,22 +406,10 @@ void EditTabBarView::selectedIndexChanged(int newIndex) {
 }
 
 void EditTabBarView::resetModifiersTab() {
-    juce::StringArray tabNames = getTabNames();
-    int tracksIndex = tabNames.indexOf(tracksTabName);
-    if (auto tracksView =
-            dynamic_cast<TracksView *>(getTabContentComponent(tracksIndex))) {
-        if (auto track = dynamic_cast<tracktion::AudioTrack *>(
-                tracksView->getViewModel().listViewModel.getSelectedItem())) {
-            tabNames = getTabNames();
-            int modifiersIndex = tabNames.indexOf(modifiersTabName);
-            removeTab(modifiersIndex);
-
-            addTab(modifiersTabName, juce::Colours::transparentBlack,
+    if (auto track = getSelectedTrack())
+        replaceTab(modifiersTabName, getTrackTabViews(track).modifiers,
                    new app_navigation::StackNavigationController(
-                       new TrackModifiersListView(track, midiCommandManager)),
-                   true);
-        }
-    }
+                       new TrackModifiersListView(track, midiCommandManager)));
 }
 
 void EditTabBarView::octaveChanged(int newOctave) {
@@ -329,61 +434,133 @@ void EditTabBarView::currentTabChanged(int newCurrentTabIndex,
     // detect when the sequencer tab is shown and run some init method or
     // something
     if (newCurrentTabName != sequencersTabName) {
-        juce::StringArray tabNames = getTabNames();
-        int tracksIndex = tabNames.indexOf(tracksTabName);
-        if (auto tracksView = dynamic_cast<TracksView *>(
-                getTabContentComponent(tracksIndex))) {
-            if (auto track = dynamic_cast<tracktion::AudioTrack *>(
-                    tracksView->getViewModel()
-                        .listViewModel.getSelectedItem())) {
-                tabNames = getTabNames();
-                int sequencersIndex = tabNames.indexOf(sequencersTabName);
-                removeTab(sequencersIndex);
-
-                addTab(sequencersTabName, juce::Colours::transparentBlack,
+        if (auto track = getSelectedTrack())
+            replaceTab(sequencersTabName, getTrackTabViews(track).sequencers,
                        new app_navigation::StackNavigationController(
-                           new AvailableSequencersListView(track,
-                                                           midiCommandManager)),
-                       true);
-            }
-        }
+                           new AvailableSequencersListView(
+                               track, midiCommandManager)));
     }
 }
 
-void EditTabBarView::trackDeleted() { resetTrackRelatedTabs(); }
+void EditTabBarView::trackDeleted() {
+    resetTrackRelatedTabs();
+    removeDeletedTracksFromCache();
+}
 
 void EditTabBarView::resetTrackRelatedTabs() {
+    if (auto track = getSelectedTrack()) {
+        removeTrackRelatedTabs();
+
+        auto &views = getTrackTabViews(track);
+        shownTrackID = track->itemID.getRawID();
+
+        // Cached views may have had something pushed on to them while they
+        // were last shown, a newly created view would start at its root
+        views.plugins->popToRoot();
+        views.modifiers->popToRoot();
+        views.sequencers->popToRoot();
+
+        addTab(pluginsTabName, juce::Colours::transparentBlack,
+               views.plugins.get(), false);
+        addTab(modifiersTabName, juce::Colours::transparentBlack,
+               views.modifiers.get(), false);
+        addTab(sequencersTabName, juce::Colours::transparentBlack,
+               views.sequencers.get(), false);
+    }
+}
+
+tracktion::AudioTrack *EditTabBarView::getSelectedTrack() {
     juce::StringArray tabNames = getTabNames();
     int tracksIndex = tabNames.indexOf(tracksTabName);
     if (auto tracksView =
-            dynamic_cast<TracksView *>(getTabContentComponent(tracksIndex))) {
-        if (auto track = dynamic_cast<tracktion::AudioTrack *>(
-                tracksView->getViewModel().listViewModel.getSelectedItem())) {
-            tabNames = getTabNames();
-            int sequencersIndex = tabNames.indexOf(sequencersTabName);
-            removeTab(sequencersIndex);
-
-            tabNames = getTabNames();
-            int modifiersIndex = tabNames.indexOf(modifiersTabName);
-            removeTab(modifiersIndex);
+            dynamic_cast<TracksView *>(getTabContentComponent(tracksIndex)))
+        return dynamic_cast<tracktion::AudioTrack *>(
+            tracksView->getViewModel().listViewModel.getSelectedItem());
 
-            tabNames = getTabNames();
-            int pluginsIndex = tabNames.indexOf(pluginsTabName);
-            removeTab(pluginsIndex);
+    return nullptr;
+}
 
-            addTab(pluginsTabName, juce::Colours::transparentBlack,
-                   new app_navigation::StackNavigationController(
-                       new TrackPluginsListView(track, midiCommandManager)),
-                   true);
-            addTab(modifiersTabName, juce::Colours::transparentBlack,
-                   new app_navigation::StackNavigationController(
-                       new TrackModifiersListView(track, midiCommandManager)),
-                   true);
-            addTab(
-                sequencersTabName, juce::Colours::transparentBlack,
-                new app_navigation::StackNavigationController(
-                    new AvailableSequencersListView(track, midiCommandManager)),
-                true);
-        }
+void EditTabBarView::removeTrackRelatedTabs() {
+    for (const auto &tabName :
+         {sequencersTabName, modifiersTabName, pluginsTabName}) {
+        int index = getTabNames().indexOf(tabName);
+        if (index != -1)
+            removeTab(index);
     }
 }
+
+void EditTabBarView::removeDeletedTracksFromCache() {
+    juce::Array<juce::uint64> trackIDs;
+    for (auto track : tracktion::getAudioTracks(edit))
+        trackIDs.add(track->itemID.getRawID());
+
+    // The shown track's views are still in use by the tabs
+    trackTabViews.removeIf([this, &trackIDs](juce::uint64 trackID) {
+        return trackID != shownTrackID && !trackIDs.contains(trackID);
+    });
+}
+
+EditTabBarView::TrackTabViews &
+EditTabBarView::getTrackTabViews(tracktion::AudioTrack::Ptr track) {
+    const auto trackID = track->itemID.getRawID();
+    if (auto views = trackTabViews.find(trackID))
+        return *views;
+
+    auto views = std::make_unique<TrackTabViews>();
+    views->plugins =
+        std::make_unique<app_navigation::StackNavigationController>(
+            new TrackPluginsListView(track, midiCommandManager));
+    views->modifiers =
+        std::make_unique<app_navigation::StackNavigationController>(
+            new TrackModifiersListView(track, midiCommandManager));
+    views->sequencers =
+        std::make_unique<app_navigation::StackNavigationController>(
+            new AvailableSequencersListView(track, midiCommandManager));
+    return trackTabViews.insert(trackID, std::move(views));
+}
+
+void EditTabBarView::replaceTab(
+    const juce::String &tabName,
+    std::unique_ptr<app_navigation::StackNavigationController>
+        &cachedController,
+    app_navigation::StackNavigationController *newController) {
+    int index = getTabNames().indexOf(tabName);
+    if (index != -1)
+        removeTab(index);
+
+    cachedController.reset(newController);
+    addTab(tabName, juce::Colours::transparentBlack, cachedController.get(),
+           false);
+}
+
+void EditTabBarView::addDeferredTab(
+    const juce::String &tabName, std::function<juce::Component *()> createTab) {
+    deferredTabs[tabName] = std::move(createTab);
+
+    if (deferredTaskQueue != nullptr)
+        deferredTaskQueue->addTask(getDeferredTabTaskName(tabName),
+                                   [this, tabName]() {
+                                       createDeferredTab(tabName);
+                                   });
+    else
+        createDeferredTab(tabName);
+}
+
+void EditTabBarView::createDeferredTab(const juce::String &tabName) {
+    auto it = deferredTabs.find(tabName);
+    if (it == deferredTabs.end())
+        return;
+
+    auto createTab = std::move(it->second);
+    deferredTabs.erase(it);
+
+    if (deferredTaskQueue != nullptr)
+        deferredTaskQueue->cancelTask(getDeferredTabTaskName(tabName));
+
+    addTab(tabName, juce::Colours::transparentBlack, createTab(), true);
+}
+
+juce::String EditTabBarView::getDeferredTabTaskName(
+    const juce::String &tabName) {
+    return "Create " + tabName + " tab";
+}
@@ -11,6 +11,8 @@ class EditTabBarView : public juce::TabbedComponent,
                        public app_services::MidiCommandManager::Listener,
                        public app_view_models::ItemListState::Listener,
                        public app_view_models::EditViewModel::Listener,
+                       public app_services::EditRenderJob::Listener,
+                       public app_services::EditSaver::Listener,
                        juce::Timer {
   public:
     EditTabBarView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
@@ -22,6 +24,7 @@ class EditTabBarView : public juce::TabbedComponent,
     void tempoSettingsButtonReleased() override;
     void saveButtonReleased() override;
     void renderButtonReleased() override;
+    void stopButtonReleased() override;
     void mixerButtonReleased() override;
     void settingsButtonReleased() override;
     void pluginsButtonReleased() override;
@@ -42,6 +45,13 @@ class EditTabBarView : public juce::TabbedComponent,
     // ViewModel listener
     void trackDeleted() override;
 
+    // EditRenderJob listener
+    void renderProgressChanged(float progress) override;
+    void renderFinished(app_services::EditRenderJob::Result result) override;
+
+    // EditSaver listener
+    void editSaved(bool success) override;
+
   private:
     tracktion::Edit &edit;
     app_services::MidiCommandManager &midiCommandManager;
@@ -57,9 +67,42 @@ class EditTabBarView : public juce::TabbedComponent,
 
     OctaveDisplayComponent octaveDisplayComponent;
     MessageBox messageBox;
+    std::unique_ptr<app_services::EditRenderJob> renderJob;
+    app_services::EditSaver *editSaver = nullptr;
+    app_services::DeferredTaskQueue *deferredTaskQueue = nullptr;
+    // Tabs that haven't been created yet, by name
+    std::map<juce::String, std::function<juce::Component *()>> deferredTabs;
+    // Only saves from the save button show a message when they finish
+    bool showSaveMessage = false;
+
+    // The per-track tabs are kept alive for the most recently selected tracks
+    // so scrolling through the tracks doesn't rebuild them every time
+    struct TrackTabViews {
+        std::unique_ptr<app_navigation::StackNavigationController> plugins;
+        std::unique_ptr<app_navigation::StackNavigationController> modifiers;
+        std::unique_ptr<app_navigation::StackNavigationController> sequencers;
+    };
+
+    static constexpr size_t maxCachedTracks = 16;
+    app_services::LruCache<juce::uint64, TrackTabViews> trackTabViews{
+        maxCachedTracks};
+    juce::uint64 shownTrackID = 0;
 
     void timerCallback() override;
+    void showMessage(const juce::String &message);
+    void addDeferredTab(const juce::String &tabName,
+                        std::function<juce::Component *()> createTab);
+    void createDeferredTab(const juce::String &tabName);
+    static juce::String getDeferredTabTaskName(const juce::String &tabName);
     void resetTrackRelatedTabs();
+    tracktion::AudioTrack *getSelectedTrack();
+    void removeTrackRelatedTabs();
+    void removeDeletedTracksFromCache();
+    TrackTabViews &getTrackTabViews(tracktion::AudioTrack::Ptr track);
+    void replaceTab(const juce::String &tabName,
+                    std::unique_ptr<app_navigation::StackNavigationController>
+                        &cachedController,
+                    app_navigation::StackNavigationController *newController);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditTabBarView)
 };
@@ -6,10 +6,12 @@ LevelMeterComponent::LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan)
     currentLeveldB = levelClient.getAndClearAudioLevel(channel).dB;
     setOpaque(true);
     levelMeasurer.addClient(levelClient);
-    startTimerHz(120);
+    startTimerHz(AppConfig::getCurrent()->meterRefreshRate);
+    AppConfig::addListener(this);
 }
 
 LevelMeterComponent::~LevelMeterComponent() {
+    AppConfig::removeListener(this);
     levelMeasurer.removeClient(levelClient);
     stopTimer();
 }
@@ -59,4 +61,10 @@ void LevelMeterComponent::timerCallback() {
     if (currentLeveldB != prevLeveldB) {
         repaint();
     }
-}
\ No newline at end of file
+}
+
+void LevelMeterComponent::appConfigChanged(const AppConfig &oldConfig,
+                                           const AppConfig &newConfig) {
+    if (newConfig.meterRefreshRate != oldConfig.meterRefreshRate)
+        startTimerHz(newConfig.meterRefreshRate);
+}
@@ -1,9 +1,12 @@
 #pragma once
 #include "AppLookAndFeel.h"
+#include <app_configuration/app_configuration.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
 
-class LevelMeterComponent : public juce::Component, public juce::Timer {
+class LevelMeterComponent : public juce::Component,
+                            public juce::Timer,
+                            private AppConfig::Listener {
   public:
     explicit LevelMeterComponent(tracktion::LevelMeasurer &lm, int chan);
     ~LevelMeterComponent() override;
@@ -13,6 +16,9 @@ class LevelMeterComponent : public juce::Component, public juce::Timer {
     void timerCallback() override;
 
   private:
+    void appConfigChanged(const AppConfig &oldConfig,
+                          const AppConfig &newConfig) override;
+
     int channel = 0;
 
     // set the range of the meter in dB
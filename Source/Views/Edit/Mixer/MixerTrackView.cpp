@@ -1,6 +1,6 @@
 #include "MixerTrackView.h"
 MixerTrackView::MixerTrackView(tracktion::Track::Ptr t)
-    : track(t), viewModel(track),
+    : track(t), viewModel(track), dspLoadViewModel(track),
       levelMeter0(
           (track->isMasterTrack())
               ? std::make_unique<LevelMeterComponent>(
@@ -84,10 +84,19 @@ MixerTrackView::MixerTrackView(tracktion::Track::Ptr t)
     muteLabel.setAlwaysOnTop(true);
     addAndMakeVisible(muteLabel);
 
+    dspLoadLabel.setJustificationType(juce::Justification::centred);
+    dspLoadLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour3);
+    dspLoadLabel.setAlwaysOnTop(true);
+    addAndMakeVisible(dspLoadLabel);
+
     viewModel.addListener(this);
+    dspLoadViewModel.addListener(this);
 }
 
-MixerTrackView::~MixerTrackView() { viewModel.removeListener(this); }
+MixerTrackView::~MixerTrackView() {
+    viewModel.removeListener(this);
+    dspLoadViewModel.removeListener(this);
+}
 
 void MixerTrackView::paint(juce::Graphics &g) {
     if (isSelected) {
@@ -109,6 +118,12 @@ void MixerTrackView::resized() {
     muteLabel.setFont(fontAwesomeFont);
     soloLabel.setBounds(soloX, iconY, iconWidth, iconHeight);
     muteLabel.setBounds(muteX, iconY, iconWidth, iconHeight);
+
+    int loadHeight = getHeight() / 8;
+    dspLoadLabel.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(),
+                                    loadHeight * .8f, juce::Font::plain));
+    dspLoadLabel.setBounds(panKnob.getX(), panKnob.getBottom() - loadHeight,
+                           panKnob.getWidth(), loadHeight);
 }
 
 void MixerTrackView::setSelected(bool selected) {
@@ -138,3 +153,26 @@ void MixerTrackView::muteStateChanged(bool mute) {
     muteLabel.setVisible(mute);
     resized();
 }
+
+void MixerTrackView::dspLoadChanged() {
+    // Show the current load and the peak, in red if the peak is close to
+    // using up the whole block
+    if (auto audioTrack = dynamic_cast<tracktion::AudioTrack *>(track.get())) {
+        if (app_services::TrackFreezer::isFrozen(*audioTrack)) {
+            dspLoadLabel.setText("Frozen", juce::dontSendNotification);
+            dspLoadLabel.setColour(juce::Label::textColourId,
+                                   appLookAndFeel.blueColour);
+            return;
+        }
+    }
+
+    const auto peak = dspLoadViewModel.getTrackPeakLoad();
+    dspLoadLabel.setText(
+        app_view_models::DspLoadViewModel::formatLoad(
+            dspLoadViewModel.getTrackLoad()) +
+            " (" + app_view_models::DspLoadViewModel::formatLoad(peak) + ")",
+        juce::dontSendNotification);
+    dspLoadLabel.setColour(juce::Label::textColourId,
+                           peak > .8 ? appLookAndFeel.redColour
+                                     : appLookAndFeel.colour3);
+}
@@ -4,13 +4,15 @@
 #include "LevelMeterComponent.h"
 #include "SelectedTrackMarker.h"
 #include <FontData.h>
+#include <app_services/app_services.h>
 #include <app_view_models/app_view_models.h>
 #include <juce_graphics/juce_graphics.h>
 #include <juce_gui_extra/juce_gui_extra.h>
 #include <tracktion_engine/tracktion_engine.h>
 
 class MixerTrackView : public juce::Component,
-                       public app_view_models::MixerTrackViewModel::Listener {
+                       public app_view_models::MixerTrackViewModel::Listener,
+                       public app_view_models::DspLoadViewModel::Listener {
   public:
     MixerTrackView(tracktion::Track::Ptr t);
     ~MixerTrackView();
@@ -25,9 +27,12 @@ class MixerTrackView : public juce::Component,
     void soloStateChanged(bool solo) override;
     void muteStateChanged(bool mute) override;
 
+    void dspLoadChanged() override;
+
   private:
     tracktion::Track::Ptr track;
     app_view_models::MixerTrackViewModel viewModel;
+    app_view_models::DspLoadViewModel dspLoadViewModel;
     bool isSelected = false;
     LabeledKnob panKnob;
     juce::Slider volumeSlider;
@@ -41,6 +46,7 @@ class MixerTrackView : public juce::Component,
     juce::Font fontAwesomeFont = juce::Font(faTypeface);
     juce::Label soloLabel;
     juce::Label muteLabel;
+    juce::Label dspLoadLabel;
 
     AppLookAndFeel appLookAndFeel;
 
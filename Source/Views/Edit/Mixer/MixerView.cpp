@@ -3,7 +3,8 @@
 MixerView::MixerView(tracktion::Edit &e, app_services::MidiCommandManager &mcm)
     : edit(e), viewModel(edit), midiCommandManager(mcm),
       tableListModel(
-          std::make_unique<MixerTableListBoxModel>(viewModel.listViewModel)) {
+          std::make_unique<MixerTableListBoxModel>(viewModel.listViewModel)),
+      trackFreezer(edit) {
     tableListBox.setModel(tableListModel.get());
     tableListBox.setHeaderHeight(0);
     tableListBox.getHeader().setStretchToFitActive(true);
@@ -53,7 +54,18 @@ void MixerView::encoder1Decreased() {
                 1);
 }
 
-void MixerView::encoder1ButtonReleased() {}
+void MixerView::encoder1ButtonReleased() {
+    // Toggles whether the selected track is frozen
+    if (isShowing())
+        if (midiCommandManager.getFocusedComponent() == this)
+            if (auto track = dynamic_cast<tracktion::AudioTrack *>(
+                    viewModel.listViewModel.getSelectedItem())) {
+                if (app_services::TrackFreezer::isFrozen(*track))
+                    trackFreezer.unfreeze(track);
+                else
+                    trackFreezer.freeze(track);
+            }
+}
 
 void MixerView::encoder3Increased() { viewModel.incrementPan(); }
 
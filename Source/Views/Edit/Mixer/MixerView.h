@@ -40,6 +40,7 @@ class MixerView : public juce::Component,
     app_view_models::MixerViewModel viewModel;
     std::unique_ptr<MixerTableListBoxModel> tableListModel;
     juce::TableListBox tableListBox;
+    app_services::TrackFreezer trackFreezer;
 
     AppLookAndFeel appLookAndFeel;
 
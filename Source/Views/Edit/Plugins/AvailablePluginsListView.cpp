@@ -1,10 +1,21 @@
 #include "AvailablePluginsListView.h"
+#include "ExtendedUIBehaviour.h"
 #include "FourOscView.h"
 #include "PluginView.h"
 #include <app_navigation/app_navigation.h>
+
+static app_services::PluginWarmPool *
+getPluginWarmPool(tracktion::AudioTrack::Ptr track) {
+    if (auto uiBehaviour = dynamic_cast<ExtendedUIBehaviour *>(
+            &track->edit.engine.getUIBehaviour()))
+        return uiBehaviour->getPluginWarmPool();
+
+    return nullptr;
+}
+
 AvailablePluginsListView::AvailablePluginsListView(
     tracktion::AudioTrack::Ptr t, app_services::MidiCommandManager &mcm)
-    : track(t), viewModel(t), midiCommandManager(mcm),
+    : track(t), viewModel(t, getPluginWarmPool(t)), midiCommandManager(mcm),
       titledSplitList(viewModel.getCategoryNames(), viewModel.getPluginNames(),
                       "Select Plugin", ListTitle::IconType::FONT_AWESOME,
                       juce::String::charToString(0xf1e6)) {
@@ -46,9 +46,16 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
                     return drumSamplerView;
 
                 } else {
+                    // The sample library index is made after startup, so
+                    // make it now if that hasn't happened yet
+                    if (sampleLibraryIndex == nullptr &&
+                        onSampleLibraryIndexNeeded)
+                        onSampleLibraryIndexNeeded();
+
                     std::unique_ptr<SamplerView> synthSamplerView =
                         std::make_unique<SamplerView>(samplerPlugin,
-                                                      *midiCommandManager);
+                                                      *midiCommandManager,
+                                                      *sampleLibraryIndex);
                     return synthSamplerView;
                 }
             }
@@ -134,6 +141,44 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
         midiCommandManager = mcm;
     }
 
+    void setSampleLibraryIndex(app_services::SampleLibraryIndex *index) {
+        sampleLibraryIndex = index;
+    }
+
+    void setPluginWarmPool(app_services::PluginWarmPool *pool) {
+        pluginWarmPool = pool;
+    }
+
+    app_services::PluginWarmPool *getPluginWarmPool() { return pluginWarmPool; }
+
+    void setEditSaver(app_services::EditSaver *saver) { editSaver = saver; }
+
+    app_services::EditSaver *getEditSaver() { return editSaver; }
+
+    void setDeferredTaskQueue(app_services::DeferredTaskQueue *queue) {
+        deferredTaskQueue = queue;
+    }
+
+    app_services::DeferredTaskQueue *getDeferredTaskQueue() {
+        return deferredTaskQueue;
+    }
+
+    void setAudioCallbackMonitor(app_services::AudioCallbackMonitor *monitor) {
+        audioCallbackMonitor = monitor;
+    }
+
+    app_services::AudioCallbackMonitor *getAudioCallbackMonitor() {
+        return audioCallbackMonitor;
+    }
+
+    static inline const juce::String sampleLibraryTaskName =
+        "Index sample library";
+
+    // Called when a view needs the sample library index before it has been
+    // set, this should set it before returning. The index may still be
+    // scanning the samples in the background
+    std::function<void()> onSampleLibraryIndexNeeded;
+
     void setApp(App *a) { app = a; }
 
     tracktion::Edit *getCurrentlyFocusedEdit() override { return edit; }
@@ -161,12 +206,18 @@ class ExtendedUIBehaviour : public tracktion::UIBehaviour {
   private:
     tracktion::Edit *edit;
     app_services::MidiCommandManager *midiCommandManager;
+    app_services::SampleLibraryIndex *sampleLibraryIndex = nullptr;
+    app_services::PluginWarmPool *pluginWarmPool = nullptr;
+    app_services::EditSaver *editSaver = nullptr;
+    app_services::DeferredTaskQueue *deferredTaskQueue = nullptr;
+    app_services::AudioCallbackMonitor *audioCallbackMonitor = nullptr;
     App *app;
 
     struct TaskRunner : public juce::Thread {
         explicit TaskRunner(tracktion::ThreadPoolJobWithProgress &t)
             : Thread(t.getJobName()), task(t) {
-            startThread();
+            app_services::ThreadPlacement::runOnAnyCore(
+                [this] { startThread(); });
         }
 
         ~TaskRunner() override {
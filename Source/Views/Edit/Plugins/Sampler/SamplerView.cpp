@@ -2,10 +2,12 @@
 #include <internal_plugins/internal_plugins.h>
 
 SamplerView::SamplerView(tracktion::SamplerPlugin *sampler,
-                         app_services::MidiCommandManager &mcm)
+                         app_services::MidiCommandManager &mcm,
+                         app_services::SampleLibraryIndex &sampleLibraryIndex)
     : samplerPlugin(sampler), midiCommandManager(mcm),
       viewModel(std::unique_ptr<app_view_models::SamplerViewModel>(
-          std::make_unique<app_view_models::SynthSamplerViewModel>(sampler))),
+          std::make_unique<app_view_models::SynthSamplerViewModel>(
+              sampler, sampleLibraryIndex))),
       fullSampleThumbnail(viewModel->getFullSampleThumbnail(),
                           appLookAndFeel.colour1.withAlpha(.3f)),
       sampleExcerptThumbnail(viewModel->getFullSampleThumbnail(),
@@ -59,18 +61,16 @@ void SamplerView::init() {
 
     addChildComponent(titledList);
 
-    if (viewModel->getItemNames().size() <= 0) {
-        emptyLabel.setFont(
-            juce::Font(juce::Font::getDefaultMonospacedFontName(),
-                       getHeight() * .1, juce::Font::plain));
-        emptyLabel.setJustificationType(juce::Justification::centred);
-        emptyLabel.setAlwaysOnTop(true);
-        emptyLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour1);
-        emptyLabel.setText(
-            "See the README for instructions on adding samples and drum kits!",
-            juce::dontSendNotification);
-        addAndMakeVisible(emptyLabel);
-    }
+    emptyLabel.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(),
+                                  getHeight() * .1, juce::Font::plain));
+    emptyLabel.setJustificationType(juce::Justification::centred);
+    emptyLabel.setAlwaysOnTop(true);
+    emptyLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour1);
+    emptyLabel.setText(
+        "See the README for instructions on adding samples and drum kits!",
+        juce::dontSendNotification);
+    addChildComponent(emptyLabel);
+    emptyLabel.setVisible(viewModel->getItemNames().size() <= 0);
 
     viewModel->addListener(this);
     midiCommandManager.addListener(this);
@@ -154,6 +154,12 @@ void SamplerView::sampleChanged() {
     resized();
 }
 
+void SamplerView::itemNamesChanged() {
+    auto itemNames = viewModel->getItemNames();
+    titledList.setListItems(itemNames);
+    emptyLabel.setVisible(itemNames.size() <= 0);
+}
+
 void SamplerView::sampleExcerptTimesChanged() {
     repaint();
     resized();
@@ -20,7 +20,8 @@ class SamplerView : public juce::Component,
     };
 
     SamplerView(tracktion::SamplerPlugin *sampler,
-                app_services::MidiCommandManager &mcm);
+                app_services::MidiCommandManager &mcm,
+                app_services::SampleLibraryIndex &sampleLibraryIndex);
     SamplerView(internal_plugins::DrumSamplerPlugin *drumSampler,
                 app_services::MidiCommandManager &mcm);
     ~SamplerView() override;
@@ -33,6 +34,7 @@ class SamplerView : public juce::Component,
     void fullSampleThumbnailChanged() override;
     void sampleExcerptThumbnailChanged() override;
     void gainChanged() override;
+    void itemNamesChanged() override;
 
     void encoder1Increased() override;
     void encoder1Decreased() override;
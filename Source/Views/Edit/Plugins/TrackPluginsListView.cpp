@@ -6,12 +6,13 @@
 #include <app_navigation/app_navigation.h>
 TrackPluginsListView::TrackPluginsListView(
     tracktion::AudioTrack::Ptr t, app_services::MidiCommandManager &mcm)
-    : track(t), midiCommandManager(mcm), viewModel(t),
-      titledList(viewModel.listViewModel.getItemNames(), "Plugins",
-                 ListTitle::IconType::FONT_AWESOME,
+    : track(t), midiCommandManager(mcm), viewModel(t), dspLoadViewModel(t),
+      listItems(getListItems()),
+      titledList(listItems, "Plugins", ListTitle::IconType::FONT_AWESOME,
                  juce::String::charToString(0xf1e6)) {
     viewModel.listViewModel.addListener(this);
     viewModel.listViewModel.itemListState.addListener(this);
+    dspLoadViewModel.addListener(this);
     midiCommandManager.addListener(this);
 
     emptyListLabel.setFont(
@@ -31,6 +32,7 @@ TrackPluginsListView::~TrackPluginsListView() {
     midiCommandManager.removeListener(this);
     viewModel.listViewModel.removeListener(this);
     viewModel.listViewModel.itemListState.removeListener(this);
+    dspLoadViewModel.removeListener(this);
     emptyListLabel.setLookAndFeel(nullptr);
 }
 
@@ -137,7 +139,7 @@ void TrackPluginsListView::itemsChanged() {
     else
         emptyListLabel.setVisible(false);
 
-    titledList.setListItems(viewModel.listViewModel.getItemNames());
+    updateListItems();
     titledList.getListView().getListBox().scrollToEnsureRowIsOnscreen(
         titledList.getListView().getListBox().getSelectedRow());
     sendLookAndFeelChange();
@@ -145,6 +147,37 @@ void TrackPluginsListView::itemsChanged() {
     repaint();
 }
 
+void TrackPluginsListView::dspLoadChanged() {
+    // Only touch the list when the text has changed, most of the time it won't
+    if (getListItems() != listItems) {
+        updateListItems();
+        sendLookAndFeelChange();
+    }
+}
+
+juce::StringArray TrackPluginsListView::getListItems() {
+    auto names = viewModel.listViewModel.getItemNames();
+    auto *adapter = viewModel.listViewModel.getAdapter();
+    for (int i = 0; i < names.size(); i++) {
+        if (auto plugin =
+                dynamic_cast<tracktion::Plugin *>(adapter->getItemAtIndex(i)))
+            names.set(i, names[i] + " " +
+                             app_view_models::DspLoadViewModel::formatLoad(
+                                 dspLoadViewModel.getPluginLoad(plugin)) +
+                             " (" +
+                             app_view_models::DspLoadViewModel::formatLoad(
+                                 dspLoadViewModel.getPluginPeakLoad(plugin)) +
+                             ")");
+    }
+
+    return names;
+}
+
+void TrackPluginsListView::updateListItems() {
+    listItems = getListItems();
+    titledList.setListItems(listItems);
+}
+
 void TrackPluginsListView::encoder3Increased() {
     viewModel.moveSelectedPluginDown();
 }
@@ -10,6 +10,7 @@ class TrackPluginsListView
     : public juce::Component,
       public app_view_models::EditItemListViewModel::Listener,
       public app_view_models::ItemListState::Listener,
+      public app_view_models::DspLoadViewModel::Listener,
       public app_services::MidiCommandManager::Listener {
   public:
     TrackPluginsListView(tracktion::AudioTrack::Ptr t,
@@ -33,13 +34,21 @@ class TrackPluginsListView
     void selectedIndexChanged(int newIndex) override;
     void itemsChanged() override;
 
+    void dspLoadChanged() override;
+
   private:
     tracktion::AudioTrack::Ptr track;
     app_services::MidiCommandManager &midiCommandManager;
     app_view_models::TrackPluginsListViewModel viewModel;
+    app_view_models::DspLoadViewModel dspLoadViewModel;
+    juce::StringArray listItems;
     TitledListView titledList;
     juce::Label emptyListLabel;
     LabelColour1LookAndFeel labelColour1LookAndFeel;
 
+    // The plugin names with their current and peak DSP load
+    juce::StringArray getListItems();
+    void updateListItems();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackPluginsListView)
 };
@@ -0,0 +1,66 @@
+#include "AudioThreadsListView.h"
+#include <app_navigation/app_navigation.h>
+
+AudioThreadsListView::AudioThreadsListView(
+    tracktion::Edit &e, app_services::MidiCommandManager &mcm)
+    : midiCommandManager(mcm), viewModel(e),
+      titledList(viewModel.getItemNames(), "Audio Threads",
+                 ListTitle::IconType::FONT_AWESOME,
+                 juce::String::charToString(0xf2db)) {
+    viewModel.itemListState.addListener(this);
+    midiCommandManager.addListener(this);
+
+    addAndMakeVisible(titledList);
+}
+
+AudioThreadsListView::~AudioThreadsListView() {
+    midiCommandManager.removeListener(this);
+    viewModel.itemListState.removeListener(this);
+}
+
+void AudioThreadsListView::paint(juce::Graphics &g) {
+    g.fillAll(
+        getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+}
+
+void AudioThreadsListView::resized() {
+    titledList.setBounds(getLocalBounds());
+    titledList.getListView().getListBox().scrollToEnsureRowIsOnscreen(
+        viewModel.itemListState.getSelectedItemIndex());
+}
+
+void AudioThreadsListView::encoder1Increased() {
+    if (isShowing()) {
+        if (midiCommandManager.getFocusedComponent() == this) {
+            viewModel.itemListState.setSelectedItemIndex(
+                viewModel.itemListState.getSelectedItemIndex() + 1);
+        }
+    }
+}
+
+void AudioThreadsListView::encoder1Decreased() {
+    if (isShowing()) {
+        if (midiCommandManager.getFocusedComponent() == this) {
+            viewModel.itemListState.setSelectedItemIndex(
+                viewModel.itemListState.getSelectedItemIndex() - 1);
+        }
+    }
+}
+
+void AudioThreadsListView::encoder1ButtonReleased() {
+    if (isShowing()) {
+        if (midiCommandManager.getFocusedComponent() == this) {
+            if (auto stackNavigationController = findParentComponentOfClass<
+                    app_navigation::StackNavigationController>()) {
+                stackNavigationController->popToRoot();
+                midiCommandManager.setFocusedComponent(
+                    stackNavigationController->getTopComponent());
+            }
+        }
+    }
+}
+
+void AudioThreadsListView::selectedIndexChanged(int newIndex) {
+    titledList.getListView().getListBox().selectRow(newIndex);
+    sendLookAndFeelChange();
+}
@@ -1,5 +1,6 @@
 #include "SettingsListView.h"
 #include "AudioBufferSizeListView.h"
+#include "AudioThreadsListView.h"
 #include "DeviceTypeListView.h"
 #include "MidiInputListView.h"
 #include "OutputListView.h"
@@ -68,6 +69,10 @@ void SettingsListView::encoder1ButtonReleased() {
                 } else if (selectedItem == viewModel.sampleRateSettingName) {
                     stackNavigationController->push(new SampleRateListView(
                         edit, deviceManager, midiCommandManager));
+                } else if (selectedItem ==
+                           viewModel.audioThreadsSettingName) {
+                    stackNavigationController->push(
+                        new AudioThreadsListView(edit, midiCommandManager));
                 } else if (selectedItem == viewModel.midiInputSettingName) {
                     stackNavigationController->push(new MidiInputListView(
                         edit, deviceManager, midiCommandManager));
@@ -41,6 +41,14 @@ InformationPanelComponent::InformationPanelComponent() {
     muteLabel.setColour(juce::Label::textColourId, appLookAndFeel.colour4);
     muteLabel.setAlwaysOnTop(true);
     addAndMakeVisible(muteLabel);
+
+    audioLoadLabel.setFont(
+        juce::Font(juce::Font::getDefaultMonospacedFontName(), getHeight() * .7,
+                   juce::Font::plain));
+    audioLoadLabel.setText("0%", juce::dontSendNotification);
+    audioLoadLabel.setJustificationType(juce::Justification::centredRight);
+    audioLoadLabel.setAlwaysOnTop(true);
+    addAndMakeVisible(audioLoadLabel);
 }
 
 InformationPanelComponent::~InformationPanelComponent() {
@@ -79,6 +87,16 @@ void InformationPanelComponent::resized() {
 
     int loopLabelX = getWidth() - 2 * height;
     loopingLabel.setBounds(loopLabelX, 0, getHeight(), getHeight());
+
+    // The load sits to the left of the loop icon, smaller than the timecode
+    // so it doesn't compete with it
+    audioLoadLabel.setFont(juce::Font(
+        juce::Font::getDefaultMonospacedFontName(), iconHeight * .6f,
+        juce::Font::plain));
+    int audioLoadLabelWidth =
+        int(audioLoadLabel.getFont().getStringWidthFloat("100%")) + 10;
+    audioLoadLabel.setBounds(loopLabelX - audioLoadLabelWidth, 0,
+                             audioLoadLabelWidth, getHeight());
     // recordingLabel.setBounds(playingStatusLabelX, 0, getHeight(),
     // getHeight());
 
@@ -127,4 +145,12 @@ void InformationPanelComponent::setIsSoloed(bool solo) {
 void InformationPanelComponent::setIsMuted(bool muted) {
     muteLabel.setVisible(muted);
     resized();
-}
\ No newline at end of file
+}
+
+void InformationPanelComponent::setAudioLoad(double load, bool recentDropout) {
+    audioLoadLabel.setText(juce::String(juce::roundToInt(load * 100.0)) + "%",
+                           juce::dontSendNotification);
+    audioLoadLabel.setColour(juce::Label::textColourId,
+                             recentDropout ? appLookAndFeel.redColour
+                                           : appLookAndFeel.textColour);
+}
@@ -20,6 +20,8 @@ class InformationPanelComponent : public juce::Component {
     void setIsLooping(bool isLooping);
     void setIsSoloed(bool solo);
     void setIsMuted(bool muted);
+    // Shows the audio callback load, in red if audio recently dropped out
+    void setAudioLoad(double load, bool recentDropout);
 
   private:
     juce::Typeface::Ptr faTypeface = juce::Typeface::createSystemTypefaceFor(
@@ -32,6 +34,7 @@ class InformationPanelComponent : public juce::Component {
     juce::Label loopingLabel;
     juce::Label soloLabel;
     juce::Label muteLabel;
+    juce::Label audioLoadLabel;
     LabelColour1LookAndFeel labelColour1LookAndFeel;
     AppLookAndFeel appLookAndFeel;
 };
@@ -1,11 +1,31 @@
 #include "TracksView.h"
 #include "AppLookAndFeel.h"
+#include "ExtendedUIBehaviour.h"
 #include "MixerView.h"
 #include <app_navigation/app_navigation.h>
 
+static app_services::EditSaver *getEditSaver(tracktion::Edit &edit) {
+    if (auto uiBehaviour = dynamic_cast<ExtendedUIBehaviour *>(
+            &edit.engine.getUIBehaviour()))
+        return uiBehaviour->getEditSaver();
+
+    return nullptr;
+}
+
+static app_services::AudioCallbackMonitor *
+getAudioCallbackMonitor(tracktion::Edit &edit) {
+    if (auto uiBehaviour = dynamic_cast<ExtendedUIBehaviour *>(
+            &edit.engine.getUIBehaviour()))
+        return uiBehaviour->getAudioCallbackMonitor();
+
+    return nullptr;
+}
+
 TracksView::TracksView(tracktion::Edit &e,
                        app_services::MidiCommandManager &mcm)
-    : edit(e), midiCommandManager(mcm), camera(7), viewModel(e, camera),
+    : edit(e), midiCommandManager(mcm), camera(7),
+      viewModel(e, camera, getEditSaver(e)),
+      audioCallbackMonitor(getAudioCallbackMonitor(e)),
       listModel(std::make_unique<TracksListBoxModel>(viewModel.listViewModel,
                                                      camera)),
       singleTrackView(std::make_unique<TrackView>(
@@ -39,6 +59,9 @@ TracksView::TracksView(tracktion::Edit &e,
     viewModel.listViewModel.addListener(this);
     viewModel.listViewModel.itemListState.addListener(this);
 
+    if (audioCallbackMonitor != nullptr)
+        audioCallbackMonitor->addListener(this);
+
     startTimerHz(60);
 }
 
@@ -47,6 +70,8 @@ TracksView::~TracksView() {
     viewModel.removeListener(this);
     viewModel.listViewModel.removeListener(this);
     viewModel.listViewModel.itemListState.removeListener(this);
+    if (audioCallbackMonitor != nullptr)
+        audioCallbackMonitor->removeListener(this);
     stopTimer();
 }
 
@@ -451,3 +476,11 @@ void TracksView::undoButtonReleased() {
         if (midiCommandManager.getFocusedComponent() == this)
             viewModel.undo();
 }
+
+void TracksView::audioCallbackStatsChanged(
+    const app_services::AudioCallbackMonitor::Stats &stats) {
+    // Stays red for a couple of seconds so a dropout is noticeable
+    informationPanel.setAudioLoad(
+        stats.load,
+        stats.hadDropoutWithin(juce::Time::getMillisecondCounter(), 2000));
+}
@@ -16,6 +16,7 @@ class TracksView : public juce::Component,
                    public app_view_models::TracksListViewModel::Listener,
                    public app_view_models::EditItemListViewModel::Listener,
                    public app_view_models::ItemListState::Listener,
+                   private app_services::AudioCallbackMonitor::Listener,
                    private juce::Timer {
   public:
     TracksView(tracktion::Edit &e, app_services::MidiCommandManager &mcm);
@@ -78,6 +79,7 @@ class TracksView : public juce::Component,
     app_services::MidiCommandManager &midiCommandManager;
     app_services::TimelineCamera camera;
     app_view_models::TracksListViewModel viewModel;
+    app_services::AudioCallbackMonitor *audioCallbackMonitor;
 
     InformationPanelComponent informationPanel;
     juce::ListBox singleTrackListBox;
@@ -97,6 +99,9 @@ class TracksView : public juce::Component,
 
     void buildBeats();
 
+    void audioCallbackStatsChanged(
+        const app_services::AudioCallbackMonitor::Stats &stats) override;
+
     void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TracksView)
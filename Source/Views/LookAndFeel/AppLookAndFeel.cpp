@@ -1,6 +1,6 @@
 #include "AppLookAndFeel.h"
 #include "SimpleListItemView.h"
-#include <yaml-cpp/yaml.h>
+#include <app_configuration/app_configuration.h>
 
 AppLookAndFeel::AppLookAndFeel() {
     readColoursFromConfig();
@@ -24,73 +24,25 @@ AppLookAndFeel::AppLookAndFeel() {
 }
 
 void AppLookAndFeel::readColoursFromConfig() {
-    // Read the config file and overwrite the default colours (if
-    // appropriate config is found)
-    auto userAppDataDirectory = juce::File::getSpecialLocation(
-        juce::File::userApplicationDataDirectory);
-    auto configFile =
-        userAppDataDirectory.getChildFile(JUCE_APPLICATION_NAME_STRING)
-            .getChildFile("config.yaml");
-    if (configFile.existsAsFile()) {
-        YAML::Node rootNode =
-            YAML::LoadFile(configFile.getFullPathName().toStdString());
-
-        if (rootNode) {
-            auto configNode = rootNode["config"];
-            if (configNode) {
-                auto coloursNode = configNode["colours"];
-                if (coloursNode) {
-                    if (coloursNode["backgroundColour"]) {
-                        backgroundColour = juce::Colour::fromString(
-                            coloursNode["backgroundColour"].as<std::string>());
-                    }
-
-                    if (coloursNode["textColour"]) {
-                        textColour = juce::Colour::fromString(
-                            coloursNode["textColour"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour1"]) {
-                        colour1 = juce::Colour::fromString(
-                            coloursNode["colour1"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour2"]) {
-                        colour2 = juce::Colour::fromString(
-                            coloursNode["colour2"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour3"]) {
-                        colour3 = juce::Colour::fromString(
-                            coloursNode["colour3"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour4"]) {
-                        colour4 = juce::Colour::fromString(
-                            coloursNode["colour4"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour5"]) {
-                        colour5 = juce::Colour::fromString(
-                            coloursNode["colour5"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour6"]) {
-                        colour6 = juce::Colour::fromString(
-                            coloursNode["colour6"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour7"]) {
-                        colour7 = juce::Colour::fromString(
-                            coloursNode["colour7"].as<std::string>());
-                    }
-
-                    if (coloursNode["colour8"]) {
-                        colour8 = juce::Colour::fromString(
-                            coloursNode["colour8"].as<std::string>());
-                    }
-                }
-            }
-        }
-    }
-}
\ No newline at end of file
+    // Overwrite the default colours with any set in the config. Every view
+    // has its own look and feel, so this uses the shared config rather than
+    // reading the file each time.
+    auto appConfig = AppConfig::getCurrent();
+    auto readColour = [&appConfig](const juce::String &name,
+                                   juce::Colour &colour) {
+        auto it = appConfig->colours.find(name);
+        if (it != appConfig->colours.end())
+            colour = it->second;
+    };
+
+    readColour("backgroundColour", backgroundColour);
+    readColour("textColour", textColour);
+    readColour("colour1", colour1);
+    readColour("colour2", colour2);
+    readColour("colour3", colour3);
+    readColour("colour4", colour4);
+    readColour("colour5", colour5);
+    readColour("colour6", colour6);
+    readColour("colour7", colour7);
+    readColour("colour8", colour8);
+}
@@ -0,0 +1,81 @@
+#include <app_configuration/app_configuration.h>
+#include <gtest/gtest.h>
+namespace AppConfigurationTests {
+
+TEST(AppConfigTest, missingSettingsUseDefaults) {
+    auto config = AppConfig::parse("config:\n  show-title-bar: false\n");
+    ASSERT_NE(config, nullptr);
+
+    EXPECT_FALSE(config->showTitleBar);
+    EXPECT_EQ(config->width, 800);
+    EXPECT_EQ(config->height, 480);
+    EXPECT_EQ(config->sampleBitDepth, 32);
+    EXPECT_EQ(config->bufferSize, 0);
+    EXPECT_FALSE(config->adaptiveBufferSize);
+    EXPECT_TRUE(config->audioCores.isEmpty());
+    EXPECT_TRUE(config->realtimeAudio);
+    EXPECT_TRUE(config->loggingEnabled);
+}
+
+TEST(AppConfigTest, settingsAreParsed) {
+    auto config = AppConfig::parse("config:\n"
+                                   "  size:\n"
+                                   "    width: 1024\n"
+                                   "    height: 600\n"
+                                   "  buffer-size: 256\n"
+                                   "  adaptive-buffer-size: true\n"
+                                   "  audio-threads: 2\n"
+                                   "  audio-cores: [2, 3]\n"
+                                   "  gui-cores: [0]\n"
+                                   "  realtime-audio: false\n"
+                                   "  meter-refresh-rate: 30\n"
+                                   "  log-level: off\n"
+                                   "  colours:\n"
+                                   "    colour1: \"ff112233\"\n");
+    ASSERT_NE(config, nullptr);
+
+    EXPECT_EQ(config->width, 1024);
+    EXPECT_EQ(config->height, 600);
+    EXPECT_EQ(config->bufferSize, 256);
+    EXPECT_TRUE(config->adaptiveBufferSize);
+    EXPECT_EQ(config->audioThreads, 2);
+    EXPECT_EQ(config->audioCores, juce::Array<int>({2, 3}));
+    EXPECT_EQ(config->guiCores, juce::Array<int>({0}));
+    EXPECT_FALSE(config->realtimeAudio);
+    EXPECT_EQ(config->meterRefreshRate, 30);
+    EXPECT_FALSE(config->loggingEnabled);
+    EXPECT_EQ(config->colours.at("colour1"), juce::Colour(0xff112233));
+}
+
+TEST(AppConfigTest, invalidConfigIsRejected) {
+    EXPECT_EQ(AppConfig::parse("config: [\n"), nullptr);
+}
+
+class ConfigListener : public AppConfig::Listener {
+  public:
+    void appConfigChanged(const AppConfig &oldConfig,
+                          const AppConfig &newConfig) override {
+        oldBufferSize = oldConfig.bufferSize;
+        newBufferSize = newConfig.bufferSize;
+    }
+
+    int oldBufferSize = -1;
+    int newBufferSize = -1;
+};
+
+TEST(AppConfigTest, listenersAreToldAboutNewConfig) {
+    auto previous = AppConfig::getCurrent();
+    ConfigListener listener;
+    AppConfig::addListener(&listener);
+
+    auto config = AppConfig::parse("config:\n  buffer-size: 128\n");
+    AppConfig::setCurrent(config);
+    EXPECT_EQ(AppConfig::getCurrent(), config);
+    EXPECT_EQ(listener.oldBufferSize, previous->bufferSize);
+    EXPECT_EQ(listener.newBufferSize, 128);
+
+    AppConfig::removeListener(&listener);
+    AppConfig::setCurrent(previous);
+}
+
+} // namespace AppConfigurationTests
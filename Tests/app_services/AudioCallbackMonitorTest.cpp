@@ -0,0 +1,74 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+namespace {
+class StatsListener : public app_services::AudioCallbackMonitor::Listener {
+  public:
+    void audioCallbackStatsChanged(
+        const app_services::AudioCallbackMonitor::Stats &) override {
+        numChanges++;
+    }
+
+    int numChanges = 0;
+};
+} // namespace
+
+TEST(AudioCallbackMonitorTest, updateAveragesLoad) {
+    juce::AudioDeviceManager deviceManager;
+    app_services::AudioCallbackMonitor monitor(deviceManager);
+
+    monitor.recordCallback(5.0, 5.0, 0.2);
+    monitor.recordCallback(5.0, 5.0, 0.4);
+    monitor.update();
+
+    const auto &stats = monitor.getStats();
+    EXPECT_NEAR(stats.load, 0.3, 0.0001);
+    EXPECT_NEAR(stats.peakLoad, 0.4, 0.0001);
+    EXPECT_DOUBLE_EQ(stats.deadlineMs, 5.0);
+    EXPECT_EQ(stats.numCallbacks, 2);
+    EXPECT_EQ(stats.numLateCallbacks, 0);
+    EXPECT_EQ(stats.loadHistogram[2], 1);
+    EXPECT_EQ(stats.loadHistogram[4], 1);
+    EXPECT_TRUE(monitor.getRecentDropouts().isEmpty());
+}
+
+TEST(AudioCallbackMonitorTest, lateCallbacksAreLogged) {
+    juce::AudioDeviceManager deviceManager;
+    app_services::AudioCallbackMonitor monitor(deviceManager);
+
+    monitor.recordCallback(5.0, 5.0, 0.5);
+    monitor.recordCallback(12.0, 5.0, 1.2);
+    monitor.update();
+
+    const auto &stats = monitor.getStats();
+    EXPECT_EQ(stats.numLateCallbacks, 1);
+    EXPECT_DOUBLE_EQ(stats.worstIntervalMs, 12.0);
+    // Overloaded callbacks land in the last bin
+    EXPECT_EQ(stats.loadHistogram.back(), 1);
+    EXPECT_EQ(monitor.getRecentDropouts().size(), 1);
+    EXPECT_TRUE(
+        stats.hadDropoutWithin(juce::Time::getMillisecondCounter(), 1000));
+}
+
+TEST(AudioCallbackMonitorTest, eachUpdateOnlyCountsNewCallbacks) {
+    juce::AudioDeviceManager deviceManager;
+    app_services::AudioCallbackMonitor monitor(deviceManager);
+    StatsListener listener;
+    monitor.addListener(&listener);
+
+    monitor.recordCallback(5.0, 5.0, 0.9);
+    monitor.update();
+    monitor.recordCallback(5.0, 5.0, 0.1);
+    monitor.update();
+
+    const auto &stats = monitor.getStats();
+    EXPECT_NEAR(stats.load, 0.1, 0.0001);
+    EXPECT_NEAR(stats.peakLoad, 0.1, 0.0001);
+    EXPECT_EQ(stats.numCallbacks, 2);
+    EXPECT_EQ(listener.numChanges, 2);
+
+    monitor.removeListener(&listener);
+}
+
+} // namespace AppServicesTests
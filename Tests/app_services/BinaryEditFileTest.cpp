@@ -0,0 +1,108 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class BinaryEditFileTest : public ::testing::Test {
+  protected:
+    BinaryEditFileTest()
+        : binaryFile(juce::File::createTempFile("edit")),
+          xmlFile(juce::File::createTempFile("xml")),
+          edit(tracktion::Edit::createSingleTrackEdit(engine)) {
+        // Enough notes to put the sequence in its own section
+        auto track = tracktion::getAudioTracks(*edit)[0];
+        auto clip = dynamic_cast<tracktion::MidiClip *>(track->insertNewClip(
+            tracktion::TrackItem::Type::midi, "clip",
+            tracktion::TimeRange(tracktion::TimePosition(),
+                                 tracktion::TimePosition::fromSeconds(8.0)),
+            nullptr));
+        for (int i = 0; i < 128; i++)
+            clip->getSequence().addNote(
+                i, tracktion::BeatPosition::fromBeats(i * 0.125),
+                tracktion::BeatDuration::fromBeats(0.125), 100, 0, nullptr);
+    }
+
+    ~BinaryEditFileTest() override {
+        binaryFile.deleteFile();
+        xmlFile.deleteFile();
+    }
+
+    void writeBinaryFile() {
+        binaryFile.deleteFile();
+        juce::FileOutputStream stream(binaryFile);
+        ASSERT_TRUE(app_services::BinaryEditFile::write(edit->state, stream));
+    }
+
+    juce::File binaryFile;
+    juce::File xmlFile;
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+};
+
+TEST_F(BinaryEditFileTest, roundTripsState) {
+    writeBinaryFile();
+
+    EXPECT_TRUE(app_services::BinaryEditFile::isBinaryEditFile(binaryFile));
+    app_services::BinaryEditFile file(binaryFile);
+    ASSERT_TRUE(file.openedOk());
+    EXPECT_TRUE(file.getState().isEquivalentTo(edit->state));
+}
+
+TEST_F(BinaryEditFileTest, sectionsAreMaterialisedOnDemand) {
+    writeBinaryFile();
+
+    app_services::BinaryEditFile file(binaryFile);
+    ASSERT_TRUE(file.openedOk());
+    ASSERT_GT(file.getNumSections(), 0);
+
+    auto sequence = file.getSkeleton().getChildWithName(tracktion::IDs::TRACK)
+                        .getChildWithName(tracktion::IDs::MIDICLIP)
+                        .getChildWithName(tracktion::IDs::SEQUENCE);
+    ASSERT_TRUE(app_services::BinaryEditFile::isPlaceholder(sequence));
+    EXPECT_EQ(sequence.getNumChildren(), 0);
+
+    auto materialised = file.materialise(sequence);
+    EXPECT_FALSE(app_services::BinaryEditFile::isPlaceholder(materialised));
+    EXPECT_EQ(materialised.getNumChildren(), 128);
+    EXPECT_EQ(materialised.getParent().getChildWithName(
+                  tracktion::IDs::SEQUENCE),
+              materialised);
+}
+
+TEST_F(BinaryEditFileTest, convertsBetweenFormats) {
+    auto xml = edit->state.createXml();
+    ASSERT_NE(xml, nullptr);
+    ASSERT_TRUE(xml->writeTo(xmlFile));
+    EXPECT_FALSE(app_services::BinaryEditFile::isBinaryEditFile(xmlFile));
+
+    ASSERT_TRUE(
+        app_services::BinaryEditFile::convertToBinary(xmlFile, binaryFile));
+    EXPECT_TRUE(app_services::BinaryEditFile::isBinaryEditFile(binaryFile));
+
+    xmlFile.deleteFile();
+    ASSERT_TRUE(
+        app_services::BinaryEditFile::convertToXml(binaryFile, xmlFile));
+    EXPECT_TRUE(app_services::BinaryEditFile::readEditState(xmlFile)
+                    .isEquivalentTo(edit->state));
+}
+
+TEST_F(BinaryEditFileTest, editSaverWritesBinaryFormat) {
+    EXPECT_TRUE(app_services::EditSaver::writeEditState(
+        edit->state, binaryFile, app_services::EditSaver::Format::BINARY));
+    EXPECT_TRUE(app_services::BinaryEditFile::isBinaryEditFile(binaryFile));
+    EXPECT_TRUE(app_services::BinaryEditFile::readEditState(binaryFile)
+                    .isEquivalentTo(edit->state));
+}
+
+TEST_F(BinaryEditFileTest, invalidFileIsRejected) {
+    {
+        juce::FileOutputStream stream(binaryFile);
+        stream.writeInt(0x424e4d4c);
+        stream.writeInt(1);
+        stream.writeInt64(1000000);
+    }
+
+    app_services::BinaryEditFile file(binaryFile);
+    EXPECT_FALSE(file.openedOk());
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,108 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+namespace {
+const juce::Array<int> availableSizes = {64, 128, 256, 512};
+
+app_services::BufferSizeGovernor::Settings getSettings() {
+    app_services::BufferSizeGovernor::Settings settings;
+    settings.updatesBeforeStepDown = 4;
+    settings.liveUpdatesBeforeStepDown = 2;
+    settings.updatesAfterDropout = 6;
+    settings.liveUpdatesAfterDropout = 3;
+    return settings;
+}
+
+// Adds an update's worth of callbacks with the given load
+app_services::AudioCallbackMonitor::Stats &
+nextUpdate(app_services::AudioCallbackMonitor::Stats &stats, double load,
+           int newDropouts = 0) {
+    stats.numCallbacks += 10;
+    stats.load = load;
+    stats.peakLoad = load;
+    stats.numLateCallbacks += newDropouts;
+    return stats;
+}
+} // namespace
+
+TEST(BufferSizeGovernorTest, dropoutStepsUp) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+
+    EXPECT_EQ(policy.getNextBufferSize(nextUpdate(stats, 0.5, 1), 128,
+                                       availableSizes, false),
+              256);
+}
+
+TEST(BufferSizeGovernorTest, highLoadStepsUp) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+
+    EXPECT_EQ(policy.getNextBufferSize(nextUpdate(stats, 0.9), 128,
+                                       availableSizes, false),
+              256);
+    EXPECT_EQ(policy.getNextBufferSize(nextUpdate(stats, 0.9), 512,
+                                       availableSizes, false),
+              512);
+}
+
+TEST(BufferSizeGovernorTest, lowLoadStepsDownAfterAWhile) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+
+    int size = 256;
+    int numUpdates = 0;
+    while (size == 256 && numUpdates < 20) {
+        size = policy.getNextBufferSize(nextUpdate(stats, 0.1), size,
+                                        availableSizes, false);
+        numUpdates++;
+    }
+
+    EXPECT_EQ(size, 128);
+    EXPECT_EQ(numUpdates, 9);
+}
+
+TEST(BufferSizeGovernorTest, moderateLoadKeepsSize) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+
+    // Between the two loads nothing changes
+    for (int i = 0; i < 20; i++)
+        EXPECT_EQ(policy.getNextBufferSize(nextUpdate(stats, 0.6), 256,
+                                           availableSizes, false),
+                  256);
+}
+
+TEST(BufferSizeGovernorTest, liveMonitoringStepsDownSooner) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+
+    int size = 256;
+    int numUpdates = 0;
+    while (size == 256 && numUpdates < 20) {
+        size = policy.getNextBufferSize(nextUpdate(stats, 0.5), size,
+                                        availableSizes, true);
+        numUpdates++;
+    }
+
+    EXPECT_EQ(size, 128);
+    EXPECT_EQ(numUpdates, 4);
+}
+
+TEST(BufferSizeGovernorTest, noCallbacksKeepsSize) {
+    app_services::BufferSizeGovernor::Policy policy(getSettings());
+    app_services::AudioCallbackMonitor::Stats stats;
+    stats.load = 1.0;
+
+    EXPECT_EQ(policy.getNextBufferSize(stats, 128, availableSizes, false), 128);
+}
+
+TEST(BufferSizeGovernorTest, midiInputIsNotArmedInNewEdit) {
+    tracktion::Engine engine{"ENGINE"};
+    auto edit = tracktion::Edit::createSingleTrackEdit(engine);
+
+    EXPECT_FALSE(app_services::BufferSizeGovernor::isLiveMonitoring(*edit));
+}
+
+} // namespace AppServicesTests
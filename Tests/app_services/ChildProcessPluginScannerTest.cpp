@@ -0,0 +1,112 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+
+namespace AppServicesTests {
+
+#if JUCE_LINUX
+
+class ChildProcessPluginScannerTest : public ::testing::Test {
+  protected:
+    struct Outcome {
+        int numResults = 0;
+        int numTypes = 0;
+        bool timedOut = false;
+        bool crashed = false;
+        bool succeeded = false;
+    };
+
+    // Writes a shell script that stands in for the scanner. It writes the
+    // descriptions of numPlugins plugins and then runs the given commands.
+    void writeScanner(int numPlugins, const juce::String &commands) {
+        juce::String descriptions;
+        for (int i = 0; i < numPlugins; i++) {
+            juce::PluginDescription description;
+            description.name = "Plugin " + juce::String(i);
+            description.pluginFormatName = "VST3";
+            description.fileOrIdentifier = pluginFile;
+            descriptions << description.createXml()->toString(
+                                juce::XmlElement::TextFormat()
+                                    .singleLine()
+                                    .withoutHeader())
+                         << "\n";
+        }
+
+        outputFile.getFile().replaceWithText(descriptions);
+        scannerFile.getFile().replaceWithText(
+            "#!/bin/sh\ncat '" + outputFile.getFile().getFullPathName() +
+            "'\n" + commands + "\n");
+        scannerFile.getFile().setExecutePermission(true);
+    }
+
+    Outcome scan(int timeoutMs) {
+        app_services::ChildProcessPluginScanner scanner(scannerFile.getFile(),
+                                                        1, timeoutMs);
+        Outcome outcome;
+        scanner.scan(
+            "VST3", {pluginFile},
+            [&outcome](const auto &result) {
+                outcome.numResults++;
+                outcome.numTypes = result.types.size();
+                outcome.timedOut = result.timedOut;
+                outcome.crashed = result.crashed;
+                outcome.succeeded = result.succeeded();
+            },
+            [] { return false; });
+
+        return outcome;
+    }
+
+    const juce::String pluginFile = "/plugins/Test.vst3";
+    juce::TemporaryFile scannerFile{".sh"};
+    juce::TemporaryFile outputFile{".txt"};
+};
+
+TEST_F(ChildProcessPluginScannerTest, finishedScanSucceeds) {
+    writeScanner(2, "echo finished");
+
+    const auto outcome = scan(10000);
+    EXPECT_EQ(outcome.numResults, 1);
+    EXPECT_EQ(outcome.numTypes, 2);
+    EXPECT_TRUE(outcome.succeeded);
+}
+
+TEST_F(ChildProcessPluginScannerTest, outputLargerThanThePipeIsRead) {
+    // Far more than the pipe holds, so the scanner blocks unless its output
+    // is read while it is running
+    writeScanner(2000, "echo finished");
+
+    const auto startTime = juce::Time::getMillisecondCounter();
+    const auto outcome = scan(10000);
+    EXPECT_LT(juce::Time::getMillisecondCounter() - startTime, 5000u);
+    EXPECT_EQ(outcome.numTypes, 2000);
+    EXPECT_TRUE(outcome.succeeded);
+}
+
+TEST_F(ChildProcessPluginScannerTest, crashedScanKeepsThePluginsFoundFirst) {
+    writeScanner(2, "kill -KILL $$");
+
+    const auto outcome = scan(10000);
+    EXPECT_EQ(outcome.numResults, 1);
+    EXPECT_EQ(outcome.numTypes, 2);
+    EXPECT_TRUE(outcome.crashed);
+    EXPECT_FALSE(outcome.timedOut);
+    EXPECT_FALSE(outcome.succeeded);
+}
+
+TEST_F(ChildProcessPluginScannerTest, scanThatTakesTooLongIsKilled) {
+    // exec so the process that is killed is the one holding the pipe open
+    writeScanner(1, "exec sleep 30");
+
+    const auto startTime = juce::Time::getMillisecondCounter();
+    const auto outcome = scan(500);
+    EXPECT_LT(juce::Time::getMillisecondCounter() - startTime, 10000u);
+    EXPECT_EQ(outcome.numResults, 1);
+    EXPECT_EQ(outcome.numTypes, 1);
+    EXPECT_TRUE(outcome.timedOut);
+    EXPECT_FALSE(outcome.crashed);
+    EXPECT_FALSE(outcome.succeeded);
+}
+
+#endif
+
+} // namespace AppServicesTests
@@ -0,0 +1,71 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+namespace {
+void runUntilFinished(app_services::DeferredTaskQueue &queue) {
+    for (int i = 0; i < 100 && queue.getNumPendingTasks() > 0; i++)
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+}
+} // namespace
+
+TEST(DeferredTaskQueueTest, tasksRunInOrder) {
+    app_services::DeferredTaskQueue queue;
+    juce::StringArray order;
+    bool finished = false;
+    queue.onAllTasksFinished = [&finished]() { finished = true; };
+
+    queue.addTask("a", [&order]() { order.add("a"); });
+    queue.addTask("b", [&order]() { order.add("b"); });
+    EXPECT_TRUE(order.isEmpty());
+
+    runUntilFinished(queue);
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(20);
+
+    EXPECT_EQ(order, juce::StringArray({"a", "b"}));
+    EXPECT_TRUE(finished);
+}
+
+TEST(DeferredTaskQueueTest, runNowRunsTaskOnce) {
+    app_services::DeferredTaskQueue queue;
+    int numRuns = 0;
+    queue.addTask("task", [&numRuns]() { numRuns++; });
+
+    EXPECT_TRUE(queue.runNow("task"));
+    EXPECT_EQ(numRuns, 1);
+    EXPECT_FALSE(queue.isPending("task"));
+    EXPECT_FALSE(queue.runNow("task"));
+
+    runUntilFinished(queue);
+    EXPECT_EQ(numRuns, 1);
+}
+
+TEST(DeferredTaskQueueTest, cancelledTaskDoesNotRun) {
+    app_services::DeferredTaskQueue queue;
+    bool ran = false;
+    queue.addTask("task", [&ran]() { ran = true; });
+    queue.cancelTask("task");
+
+    EXPECT_EQ(queue.getNumPendingTasks(), 0);
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(20);
+    EXPECT_FALSE(ran);
+}
+
+TEST(DeferredTaskQueueTest, tasksAreProfiled) {
+    app_services::StartupProfiler profiler;
+    app_services::DeferredTaskQueue queue(&profiler);
+    profiler.startPhase("startup");
+    queue.addTask("task", []() { juce::Thread::sleep(5); });
+    queue.runNow("task");
+    profiler.mark("done");
+
+    const auto &phases = profiler.getPhases();
+    ASSERT_EQ(phases.size(), 3);
+    EXPECT_EQ(phases[0].name, "startup");
+    EXPECT_EQ(phases[1].name, "task");
+    EXPECT_GE(phases[1].durationMs, 5.0);
+    EXPECT_GE(phases[2].startMs, phases[1].startMs + phases[1].durationMs);
+    EXPECT_TRUE(profiler.createReport().contains("task"));
+}
+
+} // namespace AppServicesTests
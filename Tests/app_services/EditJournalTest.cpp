@@ -0,0 +1,130 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class EditJournalTest : public ::testing::Test {
+  protected:
+    EditJournalTest()
+        : editFile(juce::File::createTempFile("edit")),
+          journalDirectory(juce::File::createTempFile("journal")),
+          edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          saver(*edit, editFile) {}
+
+    ~EditJournalTest() override {
+        editFile.deleteFile();
+        journalDirectory.deleteRecursively();
+    }
+
+    void makeChanges() {
+        auto track = tracktion::getAudioTracks(*edit)[0];
+        track->setName("Journaled");
+        edit->insertNewAudioTrack(tracktion::TrackInsertPoint(nullptr, track),
+                                  nullptr);
+        track->state.removeProperty(tracktion::IDs::colour, nullptr);
+    }
+
+    static int getNumAudioTracks(const juce::ValueTree &state) {
+        int count = 0;
+        for (const auto &child : state)
+            if (child.hasType(tracktion::IDs::AUDIOTRACK))
+                count++;
+
+        return count;
+    }
+
+    juce::File editFile;
+    juce::File journalDirectory;
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    app_services::EditSaver saver;
+};
+
+TEST_F(EditJournalTest, replayRecreatesChanges) {
+    auto savedState = edit->state.createCopy();
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        makeChanges();
+    }
+
+    EXPECT_GT(app_services::EditJournal::replay(savedState, journalDirectory),
+              0);
+    EXPECT_TRUE(savedState.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, partialChangeAtEndIsIgnored) {
+    auto savedState = edit->state.createCopy();
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        makeChanges();
+    }
+
+    // Simulate the power going while a change was being written
+    {
+        juce::FileOutputStream stream(
+            app_services::EditJournal::getJournalFile(journalDirectory, 0));
+        stream.writeInt(100);
+        stream.writeByte(1);
+    }
+
+    EXPECT_GT(app_services::EditJournal::replay(savedState, journalDirectory),
+              0);
+    EXPECT_TRUE(savedState.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, savedChangesAreNotReplayed) {
+    juce::ValueTree savedState;
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        tracktion::getAudioTracks(*edit)[0]->setName("Saved");
+        journal.compact();
+        ASSERT_TRUE(saver.waitUntilSaved(5000));
+        EXPECT_EQ(journal.getGeneration(), 1);
+
+        auto xml = juce::parseXML(editFile);
+        ASSERT_NE(xml, nullptr);
+        savedState = juce::ValueTree::fromXml(*xml);
+
+        tracktion::getAudioTracks(*edit)[0]->setName("Unsaved");
+    }
+
+    EXPECT_GE(app_services::EditJournal::replay(savedState, journalDirectory),
+              1);
+    EXPECT_TRUE(savedState.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, changesMadeBeforeASaveAreNotAppliedTwice) {
+    juce::ValueTree savedState;
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        auto track = tracktion::getAudioTracks(*edit)[0];
+        edit->insertNewAudioTrack(tracktion::TrackInsertPoint(nullptr, track),
+                                  nullptr);
+        saver.save();
+        ASSERT_TRUE(saver.waitUntilSaved(5000));
+
+        auto xml = juce::parseXML(editFile);
+        ASSERT_NE(xml, nullptr);
+        savedState = juce::ValueTree::fromXml(*xml);
+    }
+
+    // The old journal is still there, as it would be after a crash straight
+    // after the save, but the track it added is already in the saved edit
+    ASSERT_TRUE(app_services::EditJournal::getJournalFile(journalDirectory, 0)
+                    .existsAsFile());
+    app_services::EditJournal::replay(savedState, journalDirectory);
+    EXPECT_EQ(getNumAudioTracks(savedState), 2);
+    EXPECT_TRUE(savedState.isEquivalentTo(edit->state));
+}
+
+TEST_F(EditJournalTest, closeRemovesOldJournals) {
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        makeChanges();
+        journal.close();
+    }
+
+    EXPECT_FALSE(app_services::EditJournal::getJournalFile(journalDirectory, 0)
+                     .existsAsFile());
+}
+
+} // namespace AppServicesTests
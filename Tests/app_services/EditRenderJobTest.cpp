@@ -0,0 +1,137 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class EditRenderJobTest : public ::testing::Test,
+                          public app_services::EditRenderJob::Listener {
+  protected:
+    EditRenderJobTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          renderDirectory(juce::File::createTempFile("renders")) {
+        // Give the edit something to render
+        tracktion::getAudioTracks(*edit)[0]->insertNewClip(
+            tracktion::TrackItem::Type::midi,
+            {tracktion::TimePosition::fromSeconds(0),
+             tracktion::TimePosition::fromSeconds(1)},
+            nullptr);
+        tracksToDo.setBit(0);
+    }
+
+    ~EditRenderJobTest() override { renderDirectory.deleteRecursively(); }
+
+    void renderFinished(app_services::EditRenderJob::Result r) override {
+        result = r;
+        finished = true;
+    }
+
+    void waitForRender() {
+        for (int i = 0; i < 1000 && !finished; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::File renderDirectory;
+    juce::BigInteger tracksToDo;
+    bool finished = false;
+    app_services::EditRenderJob::Result result =
+        app_services::EditRenderJob::Result::FAILED;
+};
+
+TEST_F(EditRenderJobTest, fileOnlyExistsOnceRenderHasFinished) {
+    auto renderFile = renderDirectory.getChildFile("render.wav");
+    app_services::EditRenderJob job(*edit, renderFile, tracksToDo);
+    job.addListener(this);
+    job.start();
+
+    EXPECT_TRUE(job.isRendering());
+    EXPECT_FALSE(renderFile.existsAsFile());
+
+    waitForRender();
+    ASSERT_TRUE(finished);
+    EXPECT_EQ(result, app_services::EditRenderJob::Result::SUCCEEDED);
+    EXPECT_FALSE(job.isRendering());
+    EXPECT_TRUE(renderFile.existsAsFile());
+}
+
+TEST_F(EditRenderJobTest, cancelledRenderLeavesNoFile) {
+    auto renderFile = renderDirectory.getChildFile("render.wav");
+    app_services::EditRenderJob job(*edit, renderFile, tracksToDo);
+    job.addListener(this);
+    job.start();
+    job.cancel();
+
+    waitForRender();
+    ASSERT_TRUE(finished);
+    EXPECT_EQ(result, app_services::EditRenderJob::Result::CANCELLED);
+    EXPECT_FALSE(renderFile.existsAsFile());
+    EXPECT_EQ(renderDirectory.getNumberOfChildFiles(
+                  juce::File::findFilesAndDirectories),
+              0);
+}
+
+TEST_F(EditRenderJobTest, renderUsesTheOptionsSampleRate) {
+    auto renderFile = renderDirectory.getChildFile("render.wav");
+    app_services::EditRenderJob::Options options;
+    options.sampleRate = 22050.0;
+    options.blockSize = 256;
+    app_services::EditRenderJob job(*edit, renderFile, tracksToDo, options);
+    job.addListener(this);
+    job.start();
+
+    waitForRender();
+    ASSERT_EQ(result, app_services::EditRenderJob::Result::SUCCEEDED);
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatReader> reader(format.createReaderFor(
+        renderFile.createInputStream().release(), true));
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->sampleRate, 22050.0);
+}
+
+TEST_F(EditRenderJobTest, editCanChangeWhileRendering) {
+    auto renderFile = renderDirectory.getChildFile("render.wav");
+    app_services::EditRenderJob job(*edit, renderFile, tracksToDo);
+    job.addListener(this);
+    job.start();
+
+    // The render has its own copy of the edit, so it isn't affected
+    edit->deleteTrack(tracktion::getAudioTracks(*edit)[0]);
+
+    waitForRender();
+    ASSERT_TRUE(finished);
+    EXPECT_EQ(result, app_services::EditRenderJob::Result::SUCCEEDED);
+    EXPECT_TRUE(renderFile.existsAsFile());
+}
+
+TEST_F(EditRenderJobTest, stemRendersAreOnePerAudioTrackPlusMaster) {
+    edit->ensureNumberOfAudioTracks(3);
+    auto renders = app_services::EditRenderJob::getStemRenders(
+        *edit, renderDirectory);
+
+    ASSERT_EQ(renders.size(), 4);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(renders[i].tracksToDo.countNumberOfSetBits(), 1);
+        EXPECT_FALSE(renders[i].useMasterPlugins);
+    }
+
+    EXPECT_EQ(renders[3].tracksToDo.countNumberOfSetBits(), 3);
+    EXPECT_TRUE(renders[3].useMasterPlugins);
+}
+
+TEST_F(EditRenderJobTest, stemsAreRenderedToSeparateFiles) {
+    edit->ensureNumberOfAudioTracks(2);
+    app_services::EditRenderJob job(
+        *edit,
+        app_services::EditRenderJob::getStemRenders(*edit, renderDirectory));
+    job.addListener(this);
+    job.start();
+
+    waitForRender();
+    ASSERT_TRUE(finished);
+    EXPECT_EQ(result, app_services::EditRenderJob::Result::SUCCEEDED);
+    for (const auto &file : job.getDestinationFiles())
+        EXPECT_TRUE(file.existsAsFile());
+}
+
+} // namespace AppServicesTests
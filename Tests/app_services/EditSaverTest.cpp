@@ -0,0 +1,124 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class EditSaverTest : public ::testing::Test,
+                      public app_services::EditSaver::Listener {
+  protected:
+    EditSaverTest()
+        : editFile(juce::File::createTempFile("edit")),
+          edit(tracktion::Edit::createSingleTrackEdit(engine)) {}
+
+    ~EditSaverTest() override { editFile.deleteFile(); }
+
+    void editSaved(bool success) override {
+        numSaves++;
+        lastSaveSucceeded = success;
+    }
+
+    void waitForSaves(app_services::EditSaver &saver) {
+        for (int i = 0; i < 500 && (saver.isSaving() || numSaves == 0); i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    }
+
+    juce::File editFile;
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    int numSaves = 0;
+    bool lastSaveSucceeded = false;
+};
+
+TEST_F(EditSaverTest, savesEditState) {
+    app_services::EditSaver saver(*edit, editFile);
+    saver.addListener(this);
+    saver.save();
+    waitForSaves(saver);
+
+    EXPECT_TRUE(lastSaveSucceeded);
+    auto xml = juce::parseXML(editFile);
+    ASSERT_NE(xml, nullptr);
+    EXPECT_TRUE(juce::ValueTree::fromXml(*xml).isEquivalentTo(edit->state));
+}
+
+TEST_F(EditSaverTest, latestStateIsWritten) {
+    app_services::EditSaver saver(*edit, editFile);
+    saver.addListener(this);
+
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    for (int i = 0; i < 10; i++) {
+        track->setName("Track " + juce::String(i));
+        saver.save();
+    }
+
+    waitForSaves(saver);
+    EXPECT_FALSE(saver.isSaving());
+
+    // Saves requested while one is being written are collapsed, but the
+    // last one always ends up in the file
+    auto xml = juce::parseXML(editFile);
+    ASSERT_NE(xml, nullptr);
+    EXPECT_TRUE(juce::ValueTree::fromXml(*xml).isEquivalentTo(edit->state));
+}
+
+TEST_F(EditSaverTest, pendingSaveIsWrittenOnDestruction) {
+    {
+        app_services::EditSaver saver(*edit, editFile);
+        saver.save();
+    }
+
+    EXPECT_NE(juce::parseXML(editFile), nullptr);
+}
+
+TEST_F(EditSaverTest, savesQueuedWhileWritingAreWrittenOnDestruction) {
+    auto track = tracktion::getAudioTracks(*edit)[0];
+    {
+        app_services::EditSaver saver(*edit, editFile);
+        for (int i = 0; i < 10; i++) {
+            track->setName("Track " + juce::String(i));
+            saver.save();
+        }
+    }
+
+    auto xml = juce::parseXML(editFile);
+    ASSERT_NE(xml, nullptr);
+    EXPECT_TRUE(juce::ValueTree::fromXml(*xml).isEquivalentTo(edit->state));
+}
+
+TEST_F(EditSaverTest, editIsUnchangedOnceSaved) {
+    app_services::EditSaver saver(*edit, editFile);
+    saver.addListener(this);
+    tracktion::getAudioTracks(*edit)[0]->setName("Renamed");
+    ASSERT_TRUE(edit->hasChangedSinceSaved());
+
+    saver.save();
+    waitForSaves(saver);
+
+    EXPECT_TRUE(lastSaveSucceeded);
+    EXPECT_FALSE(edit->hasChangedSinceSaved());
+}
+
+TEST_F(EditSaverTest, failedSaveLeavesEditChanged) {
+    // The edit can't be written into a directory that doesn't exist
+    const auto missingDirectory = juce::File::createTempFile("missing");
+    app_services::EditSaver saver(*edit, missingDirectory.getChildFile("edit"));
+    saver.addListener(this);
+    tracktion::getAudioTracks(*edit)[0]->setName("Renamed");
+
+    saver.save();
+    waitForSaves(saver);
+
+    EXPECT_FALSE(lastSaveSucceeded);
+    EXPECT_TRUE(edit->hasChangedSinceSaved());
+}
+
+TEST_F(EditSaverTest, noTemporaryFilesAreLeftBehind) {
+    auto directory = juce::File::createTempFile("saves");
+    directory.createDirectory();
+    auto file = directory.getChildFile("edit");
+
+    EXPECT_TRUE(app_services::EditSaver::writeEditState(edit->state, file));
+    EXPECT_EQ(directory.getNumberOfChildFiles(juce::File::findFiles), 1);
+    directory.deleteRecursively();
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,62 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+using IntCache = app_services::LruCache<int, int>;
+
+TEST(LruCacheTest, findReturnsInsertedValue) {
+    IntCache cache(2);
+    cache.insert(1, std::make_unique<int>(10));
+
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), 10);
+    EXPECT_EQ(cache.find(2), nullptr);
+}
+
+TEST(LruCacheTest, insertReplacesExistingValue) {
+    IntCache cache(2);
+    cache.insert(1, std::make_unique<int>(10));
+    cache.insert(1, std::make_unique<int>(11));
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(*cache.find(1), 11);
+}
+
+TEST(LruCacheTest, leastRecentlyUsedValueIsEvicted) {
+    IntCache cache(2);
+    cache.insert(1, std::make_unique<int>(10));
+    cache.insert(2, std::make_unique<int>(20));
+
+    // using 1 makes 2 the least recently used
+    cache.find(1);
+    cache.insert(3, std::make_unique<int>(30));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(LruCacheTest, removeIf) {
+    IntCache cache(4);
+    for (int i = 0; i < 4; i++)
+        cache.insert(i, std::make_unique<int>(i));
+
+    cache.removeIf([](int key) { return key % 2 == 0; });
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(cache.contains(0));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(3));
+}
+
+TEST(LruCacheTest, capacityIsAtLeastOne) {
+    IntCache cache(0);
+    cache.insert(1, std::make_unique<int>(10));
+
+    EXPECT_EQ(cache.getCapacity(), 1u);
+    EXPECT_TRUE(cache.contains(1));
+}
+
+} // namespace AppServicesTests
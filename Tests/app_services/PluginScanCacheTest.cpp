@@ -0,0 +1,268 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class PluginScanCacheTest : public ::testing::Test {
+  protected:
+    PluginScanCacheTest() {
+        engine.getPluginManager().knownPluginList.clear();
+    }
+
+    void writeCache(const juce::PluginDescription &description) {
+        juce::KnownPluginList list;
+        list.addType(description);
+
+        juce::XmlElement xml("PLUGIN_SCAN_CACHE");
+        xml.addChildElement(list.createXml().release());
+        ASSERT_TRUE(xml.writeTo(cacheFile.getFile()));
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    juce::TemporaryFile cacheFile{".xml"};
+};
+
+TEST_F(PluginScanCacheTest, loadsCachedPluginsWithoutScanning) {
+    juce::PluginDescription description;
+    description.name = "Cached Synth";
+    description.pluginFormatName = "VST3";
+    description.fileOrIdentifier = "/plugins/CachedSynth.vst3";
+    description.isInstrument = true;
+    writeCache(description);
+
+    app_services::PluginScanCache cache(engine, cacheFile.getFile(), {});
+
+    auto &list = engine.getPluginManager().knownPluginList;
+    ASSERT_EQ(list.getNumTypes(), 1);
+    EXPECT_EQ(list.getTypes()[0].name, "Cached Synth");
+    EXPECT_FALSE(cache.isScanning());
+}
+
+TEST_F(PluginScanCacheTest, missingCacheLeavesListEmpty) {
+    app_services::PluginScanCache cache(engine, cacheFile.getFile(), {});
+    EXPECT_EQ(engine.getPluginManager().knownPluginList.getNumTypes(), 0);
+}
+
+#if JUCE_LINUX
+
+// Stands in for the format the cache scans when the build doesn't host VST3
+// plugins. It lists the .vst3 files in the search path and leaves deciding
+// which ones need scanning again to the cache.
+class FakeVST3Format : public juce::AudioPluginFormat {
+  public:
+    juce::String getName() const override { return "VST3"; }
+
+    void findAllTypesForFile(juce::OwnedArray<juce::PluginDescription> &,
+                             const juce::String &) override {}
+
+    bool fileMightContainThisPluginType(const juce::String &file) override {
+        return file.endsWith(".vst3");
+    }
+
+    juce::String
+    getNameOfPluginFromIdentifier(const juce::String &file) override {
+        return juce::File(file).getFileNameWithoutExtension();
+    }
+
+    bool pluginNeedsRescanning(const juce::PluginDescription &) override {
+        return false;
+    }
+
+    bool doesPluginStillExist(const juce::PluginDescription &d) override {
+        return juce::File(d.fileOrIdentifier).exists();
+    }
+
+    bool canScanForPlugins() const override { return true; }
+    bool isTrivialToScan() const override { return false; }
+
+    juce::StringArray searchPathsForPlugins(const juce::FileSearchPath &paths,
+                                            bool, bool) override {
+        juce::StringArray files;
+        for (int i = 0; i < paths.getNumPaths(); i++)
+            for (const auto &file : paths[i].findChildFiles(
+                     juce::File::findFiles, false, "*.vst3"))
+                files.add(file.getFullPathName());
+
+        return files;
+    }
+
+    juce::FileSearchPath getDefaultLocationsToSearch() override { return {}; }
+
+    bool requiresUnblockedMessageThreadDuringCreation(
+        const juce::PluginDescription &) const override {
+        return false;
+    }
+
+  private:
+    void createPluginInstance(const juce::PluginDescription &, double, int,
+                              PluginCreationCallback callback) override {
+        callback(nullptr, "Not supported");
+    }
+};
+
+class PluginRescanTest : public PluginScanCacheTest {
+  protected:
+    PluginRescanTest()
+        : pluginDirectory(juce::File::createTempFile("PluginRescanTest")) {
+        pluginDirectory.createDirectory();
+        auto &formatManager = engine.getPluginManager().pluginFormatManager;
+        auto hasVST3Format = false;
+        for (auto *format : formatManager.getFormats())
+            hasVST3Format = hasVST3Format || format->getName() == "VST3";
+
+        if (!hasVST3Format)
+            formatManager.addFormat(new FakeVST3Format());
+
+        // Stands in for the scanner. A plugin file holds the output the
+        // scanner should give for it, and each file scanned is logged.
+        scannerFile.getFile().replaceWithText(
+            "#!/bin/sh\necho \"$2\" >> '" +
+            scanLogFile.getFile().getFullPathName() + "'\ncat \"$2\"\n");
+        scannerFile.getFile().setExecutePermission(true);
+    }
+
+    ~PluginRescanTest() override { pluginDirectory.deleteRecursively(); }
+
+    // Writes a plugin that the scanner finds a type with the given name in
+    juce::File writePlugin(const juce::String &fileName,
+                           const juce::String &name) {
+        auto file = pluginDirectory.getChildFile(fileName);
+        juce::PluginDescription description;
+        description.name = name;
+        description.pluginFormatName = "VST3";
+        description.fileOrIdentifier = file.getFullPathName();
+        description.lastFileModTime = modificationTime;
+        file.replaceWithText(
+            description.createXml()->toString(
+                juce::XmlElement::TextFormat().singleLine().withoutHeader()) +
+            "\n" + app_services::ChildProcessPluginScanner::finishedLine +
+            "\n");
+
+        // A real VST3 format rescans plugins whose time doesn't match their
+        // description, so the files all keep the same one
+        file.setLastModificationTime(modificationTime);
+        return file;
+    }
+
+    // Writes a plugin that the scanner crashes on
+    juce::File writeBrokenPlugin(const juce::String &fileName) {
+        auto file = pluginDirectory.getChildFile(fileName);
+        file.replaceWithText("not a plugin\n");
+        file.setLastModificationTime(modificationTime);
+        return file;
+    }
+
+    // Scans as the app would on starting up, loading the cache left by the
+    // previous scan
+    void scan() {
+        engine.getPluginManager().knownPluginList.clear();
+        engine.getPluginManager().knownPluginList.clearBlacklistedFiles();
+
+        app_services::PluginScanCache cache(
+            engine, cacheFile.getFile(),
+            juce::FileSearchPath(pluginDirectory.getFullPathName()),
+            scannerFile.getFile());
+        cache.startScan();
+        for (int i = 0; i < 1000 && cache.isScanning(); i++)
+            juce::Thread::sleep(10);
+
+        ASSERT_FALSE(cache.isScanning());
+    }
+
+    int getNumScans(const juce::File &plugin) {
+        int count = 0;
+        for (const auto &line : juce::StringArray::fromLines(
+                 scanLogFile.getFile().loadFileAsString()))
+            if (line == plugin.getFullPathName())
+                count++;
+
+        return count;
+    }
+
+    juce::StringArray getTypeNames() {
+        juce::StringArray names;
+        for (const auto &type :
+             engine.getPluginManager().knownPluginList.getTypes())
+            names.add(type.name);
+
+        return names;
+    }
+
+    bool isBlacklisted(const juce::File &plugin) {
+        return engine.getPluginManager()
+            .knownPluginList.getBlacklistedFiles()
+            .contains(plugin.getFullPathName());
+    }
+
+    const juce::Time modificationTime{2020, 0, 1, 12, 0};
+    juce::File pluginDirectory;
+    juce::TemporaryFile scannerFile{".sh"};
+    juce::TemporaryFile scanLogFile{".txt"};
+};
+
+TEST_F(PluginRescanTest, unchangedPluginsAreNotScannedAgain) {
+    const auto plugin = writePlugin("Synth.vst3", "Synth");
+    scan();
+    scan();
+
+    EXPECT_EQ(getNumScans(plugin), 1);
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Synth"}));
+}
+
+TEST_F(PluginRescanTest, pluginWhoseSizeChangedIsScannedAgain) {
+    const auto plugin = writePlugin("Synth.vst3", "Synth");
+    scan();
+
+    // The modification time is kept, so only the size differs
+    writePlugin("Synth.vst3", "Updated Synth");
+    scan();
+
+    EXPECT_EQ(getNumScans(plugin), 2);
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Updated Synth"}));
+}
+
+TEST_F(PluginRescanTest, pluginWhoseModificationTimeChangedIsScannedAgain) {
+    const auto plugin = writePlugin("Synth.vst3", "Synth");
+    scan();
+
+    plugin.setLastModificationTime(plugin.getLastModificationTime() +
+                                   juce::RelativeTime::hours(1));
+    scan();
+
+    EXPECT_EQ(getNumScans(plugin), 2);
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Synth"}));
+}
+
+TEST_F(PluginRescanTest, deletedPluginsAreRemoved) {
+    const auto plugin = writePlugin("Synth.vst3", "Synth");
+    writePlugin("Reverb.vst3", "Reverb");
+    scan();
+    ASSERT_EQ(getTypeNames().size(), 2);
+
+    plugin.deleteFile();
+    scan();
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Reverb"}));
+
+    // The deleted plugin is gone from the cache too
+    app_services::PluginScanCache cache(engine, cacheFile.getFile(), {});
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Reverb"}));
+}
+
+TEST_F(PluginRescanTest, failedPluginIsBlacklistedUntilItChanges) {
+    const auto plugin = writeBrokenPlugin("Broken.vst3");
+    scan();
+    EXPECT_TRUE(isBlacklisted(plugin));
+
+    scan();
+    EXPECT_EQ(getNumScans(plugin), 1);
+    EXPECT_TRUE(isBlacklisted(plugin));
+
+    writePlugin("Broken.vst3", "Fixed");
+    scan();
+    EXPECT_EQ(getNumScans(plugin), 2);
+    EXPECT_FALSE(isBlacklisted(plugin));
+    EXPECT_EQ(getTypeNames(), juce::StringArray({"Fixed"}));
+}
+
+#endif
+
+} // namespace AppServicesTests
@@ -0,0 +1,98 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class PluginWarmPoolTest : public ::testing::Test {
+  protected:
+    PluginWarmPoolTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)) {
+        description.name = "Missing Synth";
+        description.pluginFormatName = "VST3";
+        description.fileOrIdentifier = "/plugins/MissingSynth.vst3";
+    }
+
+    // Runs the message loop until the pool has the given number of warm
+    // plugins, or gives up after a few seconds
+    static bool waitForWarmPlugins(app_services::PluginWarmPool &pool,
+                                   int numPlugins) {
+        for (int i = 0; i < 100 && pool.getNumWarmPlugins() != numPlugins; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+
+        return pool.getNumWarmPlugins() == numPlugins;
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::PluginDescription description;
+    const juce::String externalType = tracktion::ExternalPlugin::xmlTypeName;
+};
+
+TEST_F(PluginWarmPoolTest, onlyExternalPluginsAreWorthWarming) {
+    EXPECT_TRUE(app_services::PluginWarmPool::isWorthWarming(
+        tracktion::ExternalPlugin::xmlTypeName));
+    EXPECT_FALSE(app_services::PluginWarmPool::isWorthWarming(
+        tracktion::FourOscPlugin::xmlTypeName));
+}
+
+TEST_F(PluginWarmPoolTest, zeroBudgetDisablesPool) {
+    app_services::PluginWarmPool pool(*edit, 0);
+    EXPECT_FALSE(pool.isEnabled());
+
+    pool.request(tracktion::ExternalPlugin::xmlTypeName, description);
+    EXPECT_EQ(pool.take(tracktion::ExternalPlugin::xmlTypeName, description),
+              nullptr);
+    EXPECT_EQ(pool.getNumWarmPlugins(), 0);
+}
+
+TEST_F(PluginWarmPoolTest, takeReturnsNullptrBeforePluginIsWarm) {
+    app_services::PluginWarmPool pool(*edit, 64 * 1024 * 1024);
+    EXPECT_TRUE(pool.isEnabled());
+
+    // Plugins are only warmed once the message thread is idle
+    pool.request(tracktion::ExternalPlugin::xmlTypeName, description);
+    EXPECT_EQ(pool.take(tracktion::ExternalPlugin::xmlTypeName, description),
+              nullptr);
+    EXPECT_EQ(pool.getMemoryUsage(), size_t(0));
+}
+
+TEST_F(PluginWarmPoolTest, warmPluginIsReused) {
+    app_services::PluginWarmPool pool(*edit, 256 * 1024 * 1024);
+
+    // The plugin's binary is missing, but tracktion still creates a plugin
+    // that stands in for it
+    pool.request(externalType, description);
+    ASSERT_TRUE(waitForWarmPlugins(pool, 1));
+    EXPECT_GT(pool.getMemoryUsage(), size_t(0));
+
+    auto plugin = pool.take(externalType, description);
+    ASSERT_NE(plugin, nullptr);
+    EXPECT_EQ(plugin->getPluginType(), externalType);
+    EXPECT_EQ(pool.getNumWarmPlugins(), 0);
+
+    // Another one is warmed in case the plugin is used again
+    ASSERT_TRUE(waitForWarmPlugins(pool, 1));
+    auto nextPlugin = pool.take(externalType, description);
+    ASSERT_NE(nextPlugin, nullptr);
+    EXPECT_NE(nextPlugin, plugin);
+}
+
+TEST_F(PluginWarmPoolTest, onlyTheLatestRequestIsWarmed) {
+    app_services::PluginWarmPool pool(*edit, 256 * 1024 * 1024);
+
+    auto otherDescription = description;
+    otherDescription.name = "Other Missing Synth";
+    otherDescription.fileOrIdentifier = "/plugins/OtherMissingSynth.vst3";
+
+    // Scrolling past the first plugin to the second
+    pool.request(externalType, description);
+    pool.request(externalType, otherDescription);
+    ASSERT_TRUE(waitForWarmPlugins(pool, 1));
+
+    // Leave time for the first plugin to be warmed if it was going to be
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(500);
+    EXPECT_EQ(pool.getNumWarmPlugins(), 1);
+    EXPECT_EQ(pool.take(externalType, description), nullptr);
+    EXPECT_NE(pool.take(externalType, otherDescription), nullptr);
+}
+
+} // namespace AppServicesTests
@@ -0,0 +1,164 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class SampleLibraryIndexTest : public ::testing::Test {
+  protected:
+    SampleLibraryIndexTest()
+        : directory(juce::File::createTempFile("SampleLibraryIndexTest")) {
+        directory.createDirectory();
+    }
+
+    ~SampleLibraryIndexTest() override { directory.deleteRecursively(); }
+
+    void writeSample(const juce::String &fileName, int numChannels,
+                     double sampleRate, int numSamples) {
+        auto file = directory.getChildFile(fileName);
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+            new juce::FileOutputStream(file), sampleRate,
+            juce::uint32(numChannels), 16, {}, 0));
+        ASSERT_NE(writer, nullptr);
+
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        buffer.clear();
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+    }
+
+    // Runs the message loop until the index has the given number of entries,
+    // or gives up after a few seconds
+    static bool waitForSize(app_services::SampleLibraryIndex &index,
+                            int size) {
+        for (int i = 0; i < 100 && index.size() != size; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+
+        return index.size() == size;
+    }
+
+    static bool waitForScan(app_services::SampleLibraryIndex &index) {
+        for (int i = 0; i < 100 && index.isScanning(); i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+
+        return !index.isScanning();
+    }
+
+    juce::File directory;
+};
+
+class CountingListener : public app_services::SampleLibraryIndex::Listener {
+  public:
+    void sampleLibraryChanged() override { numChanges++; }
+
+    int numChanges = 0;
+};
+
+TEST_F(SampleLibraryIndexTest, entriesAreSortedNaturally) {
+    writeSample("snare 10.wav", 1, 44100, 100);
+    writeSample("kick.wav", 1, 44100, 100);
+    writeSample("snare 2.wav", 1, 44100, 100);
+
+    app_services::SampleLibraryIndex index(directory);
+
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_EQ(index.getNames(),
+              juce::StringArray({"kick", "snare 2", "snare 10"}));
+    EXPECT_EQ(index.indexOf(directory.getChildFile("snare 2.wav")), 1);
+}
+
+TEST_F(SampleLibraryIndexTest, readsMetadata) {
+    writeSample("stereo.wav", 2, 48000, 24000);
+
+    app_services::SampleLibraryIndex index(directory);
+
+    const auto &entry = index.getEntry(0);
+    EXPECT_EQ(entry.numChannels, 2);
+    EXPECT_EQ(entry.sampleRate, 48000);
+    EXPECT_DOUBLE_EQ(entry.lengthInSeconds, 0.5);
+    EXPECT_EQ(entry.rootNote, 60);
+}
+
+TEST_F(SampleLibraryIndexTest, skipsUnreadableFiles) {
+    writeSample("kick.wav", 1, 44100, 100);
+    directory.getChildFile("notes.txt").replaceWithText("not audio");
+
+    app_services::SampleLibraryIndex index(directory);
+
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.getFile(0), directory.getChildFile("kick.wav"));
+    EXPECT_EQ(index.getFile(1), juce::File());
+}
+
+TEST_F(SampleLibraryIndexTest, scansInTheBackground) {
+    writeSample("kick.wav", 1, 44100, 100);
+    writeSample("snare.wav", 1, 44100, 100);
+
+    app_services::SampleLibraryIndex index(directory, juce::File(), true);
+    CountingListener listener;
+    index.addListener(&listener);
+    EXPECT_TRUE(index.isScanning());
+    EXPECT_EQ(index.size(), 0);
+
+    ASSERT_TRUE(waitForScan(index));
+    EXPECT_EQ(index.getNames(), juce::StringArray({"kick", "snare"}));
+    EXPECT_EQ(listener.numChanges, 1);
+
+    index.removeListener(&listener);
+}
+
+#if JUCE_LINUX
+
+TEST_F(SampleLibraryIndexTest, createdAndDeletedFilesUpdateTheIndex) {
+    writeSample("kick.wav", 1, 44100, 100);
+    app_services::SampleLibraryIndex index(directory);
+    CountingListener listener;
+    index.addListener(&listener);
+
+    writeSample("snare.wav", 1, 44100, 100);
+    ASSERT_TRUE(waitForSize(index, 2));
+    EXPECT_EQ(index.getNames(), juce::StringArray({"kick", "snare"}));
+    EXPECT_EQ(listener.numChanges, 1);
+
+    directory.getChildFile("kick.wav").deleteFile();
+    ASSERT_TRUE(waitForSize(index, 1));
+    EXPECT_EQ(index.getNames(), juce::StringArray({"snare"}));
+    EXPECT_EQ(listener.numChanges, 2);
+
+    index.removeListener(&listener);
+}
+
+TEST_F(SampleLibraryIndexTest, changesAreMirrored) {
+    const auto mirror = directory.getSiblingFile(
+        directory.getFileName() + "_mirror");
+    mirror.createDirectory();
+    app_services::SampleLibraryIndex index(directory, mirror);
+
+    writeSample("kick.wav", 1, 44100, 100);
+    ASSERT_TRUE(waitForSize(index, 1));
+    EXPECT_EQ(index.getFile(0), mirror.getChildFile("kick.wav"));
+    EXPECT_TRUE(mirror.getChildFile("kick.wav").existsAsFile());
+
+    directory.getChildFile("kick.wav").deleteFile();
+    ASSERT_TRUE(waitForSize(index, 0));
+    EXPECT_FALSE(mirror.getChildFile("kick.wav").existsAsFile());
+
+    mirror.deleteRecursively();
+}
+
+TEST_F(SampleLibraryIndexTest, changesDuringABackgroundScanAreKept) {
+    writeSample("kick.wav", 1, 44100, 100);
+    writeSample("snare.wav", 1, 44100, 100);
+    app_services::SampleLibraryIndex index(directory, juce::File(), true);
+
+    // Whether or not the scan sees these, the index ends up the same
+    writeSample("hat.wav", 1, 44100, 100);
+    directory.getChildFile("kick.wav").deleteFile();
+
+    ASSERT_TRUE(waitForScan(index));
+    ASSERT_TRUE(waitForSize(index, 2));
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(200);
+    EXPECT_EQ(index.getNames(), juce::StringArray({"hat", "snare"}));
+}
+
+#endif
+
+} // namespace AppServicesTests
@@ -0,0 +1,61 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+#if JUCE_LINUX
+#include <sched.h>
+#endif
+
+namespace AppServicesTests {
+
+TEST(ThreadPlacementTest, coreMaskIgnoresMissingCores) {
+    using app_services::ThreadPlacement;
+    EXPECT_EQ(ThreadPlacement::getCoreMask({}), 0u);
+    EXPECT_EQ(ThreadPlacement::getCoreMask({0}), 1u);
+    EXPECT_EQ(ThreadPlacement::getCoreMask(
+                  {-1, juce::SystemStats::getNumCpus()}),
+              0u);
+}
+
+TEST(ThreadPlacementTest, coreMaskIsDescribed) {
+    using app_services::ThreadPlacement;
+    EXPECT_EQ(ThreadPlacement::describeCoreMask(0), "any");
+    EXPECT_EQ(ThreadPlacement::describeCoreMask(0b1101), "0,2,3");
+}
+
+TEST(ThreadPlacementTest, functionRunsWithAudioPlacement) {
+    juce::AudioDeviceManager deviceManager;
+    app_services::ThreadPlacement placement(deviceManager);
+    placement.setAudioCores(app_services::ThreadPlacement::getCoreMask({0}));
+
+    bool ran = false;
+    placement.runWithAudioPlacement([&ran]() { ran = true; });
+    EXPECT_TRUE(ran);
+}
+
+#if JUCE_LINUX
+TEST(ThreadPlacementTest, threadsStartedOnAnyCoreAreNotPinned) {
+    using app_services::ThreadPlacement;
+    auto getNumCores = []() {
+        cpu_set_t cores;
+        sched_getaffinity(0, sizeof(cores), &cores);
+        return CPU_COUNT(&cores);
+    };
+
+    // Pinned like the message thread is to the GUI cores
+    ASSERT_TRUE(ThreadPlacement::setCurrentThreadCores(
+        ThreadPlacement::getCoreMask({0})));
+
+    int childCores = 0;
+    ThreadPlacement::runOnAnyCore([&]() {
+        std::thread thread([&]() { childCores = getNumCores(); });
+        thread.join();
+    });
+
+    EXPECT_EQ(childCores, juce::SystemStats::getNumCpus());
+    EXPECT_EQ(getNumCores(), 1);
+    ThreadPlacement::setCurrentThreadCores(0);
+}
+#endif
+
+} // namespace AppServicesTests
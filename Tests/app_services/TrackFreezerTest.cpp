@@ -0,0 +1,168 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+namespace AppServicesTests {
+
+class TrackFreezerTest : public ::testing::Test,
+                         public app_services::TrackFreezer::Listener {
+  protected:
+    TrackFreezerTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          track(tracktion::getAudioTracks(*edit)[0]), freezer(*edit) {
+        track->insertNewClip(tracktion::TrackItem::Type::midi,
+                             {tracktion::TimePosition::fromSeconds(0),
+                              tracktion::TimePosition::fromSeconds(1)},
+                             nullptr);
+        track->pluginList.insertPlugin(
+            edit->getPluginCache().createNewPlugin(
+                tracktion::FourOscPlugin::xmlTypeName, {}),
+            0, nullptr);
+        freezer.addListener(this);
+    }
+
+    ~TrackFreezerTest() override { freezer.removeListener(this); }
+
+    void freezeFinished(tracktion::AudioTrack *, bool success) override {
+        finished = true;
+        succeeded = success;
+    }
+
+    void freezeAndWait() {
+        freezer.freeze(track);
+        for (int i = 0; i < 1000 && !finished; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    }
+
+    static int getNumFourOscs(tracktion::AudioTrack &audioTrack) {
+        int count = 0;
+        for (auto plugin : audioTrack.pluginList.getPlugins())
+            if (dynamic_cast<tracktion::FourOscPlugin *>(plugin))
+                count++;
+
+        return count;
+    }
+
+    int getNumFourOscs() { return getNumFourOscs(*track); }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    tracktion::AudioTrack::Ptr track;
+    app_services::TrackFreezer freezer;
+    bool finished = false;
+    bool succeeded = false;
+};
+
+TEST_F(TrackFreezerTest, freezeUnloadsPluginsAndPlaysFile) {
+    EXPECT_FALSE(app_services::TrackFreezer::isFrozen(*track));
+    EXPECT_EQ(getNumFourOscs(), 1);
+
+    freezeAndWait();
+    ASSERT_TRUE(finished);
+    EXPECT_TRUE(succeeded);
+    EXPECT_TRUE(app_services::TrackFreezer::isFrozen(*track));
+    EXPECT_FALSE(freezer.isFreezing());
+    EXPECT_EQ(getNumFourOscs(), 0);
+    EXPECT_TRUE(freezer.getFreezeFile(*track).existsAsFile());
+
+    // The midi clip is muted and the frozen audio is played instead
+    ASSERT_EQ(track->getClips().size(), 2);
+    for (auto clip : track->getClips()) {
+        if (dynamic_cast<tracktion::WaveAudioClip *>(clip))
+            EXPECT_FALSE(clip->isMuted());
+        else
+            EXPECT_TRUE(clip->isMuted());
+    }
+}
+
+TEST_F(TrackFreezerTest, mixerPluginsStayEnabledWhileFreezing) {
+    freezer.freeze(track);
+    ASSERT_TRUE(freezer.isFreezing());
+
+    // Only the copy of the edit being rendered has them turned off
+    auto volume = track->getVolumePlugin();
+    ASSERT_NE(volume, nullptr);
+    EXPECT_TRUE(volume->isEnabled());
+
+    for (int i = 0; i < 1000 && !finished; i++)
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    EXPECT_TRUE(succeeded);
+    EXPECT_TRUE(volume->isEnabled());
+}
+
+TEST_F(TrackFreezerTest, freezeClipIncludesTheTail) {
+    const auto editLength = edit->getLength();
+    freezeAndWait();
+    ASSERT_TRUE(succeeded);
+
+    for (auto clip : track->getClips())
+        if (dynamic_cast<tracktion::WaveAudioClip *>(clip))
+            EXPECT_GT(clip->getPosition().getLength(), editLength);
+}
+
+TEST_F(TrackFreezerTest, unfreezeRestoresTrack) {
+    freezeAndWait();
+    ASSERT_TRUE(succeeded);
+
+    auto freezeFile = freezer.getFreezeFile(*track);
+    freezer.unfreeze(track);
+
+    EXPECT_FALSE(app_services::TrackFreezer::isFrozen(*track));
+    EXPECT_EQ(getNumFourOscs(), 1);
+    EXPECT_FALSE(freezeFile.existsAsFile());
+    ASSERT_EQ(track->getClips().size(), 1);
+    EXPECT_FALSE(track->getClips()[0]->isMuted());
+}
+
+TEST_F(TrackFreezerTest, frozenTrackStaysFrozenAfterReloading) {
+    freezeAndWait();
+    ASSERT_TRUE(succeeded);
+
+    auto editFile = juce::File::createTempFile("edit");
+    {
+        app_services::EditSaver saver(*edit, editFile);
+        saver.save();
+        ASSERT_TRUE(saver.waitUntilSaved(5000));
+    }
+
+    auto reloadedEdit =
+        app_services::BinaryEditFile::loadEdit(engine, editFile);
+    ASSERT_NE(reloadedEdit, nullptr);
+    auto reloadedTrack = tracktion::getAudioTracks(*reloadedEdit)[0];
+    EXPECT_TRUE(app_services::TrackFreezer::isFrozen(*reloadedTrack));
+    EXPECT_EQ(getNumFourOscs(*reloadedTrack), 0);
+    ASSERT_EQ(reloadedTrack->getClips().size(), 2);
+    for (auto clip : reloadedTrack->getClips()) {
+        if (dynamic_cast<tracktion::WaveAudioClip *>(clip))
+            EXPECT_FALSE(clip->isMuted());
+        else
+            EXPECT_TRUE(clip->isMuted());
+    }
+
+    // The plugins kept in the saved edit can still be put back
+    app_services::TrackFreezer reloadedFreezer(*reloadedEdit);
+    reloadedFreezer.unfreeze(reloadedTrack);
+    EXPECT_FALSE(app_services::TrackFreezer::isFrozen(*reloadedTrack));
+    EXPECT_EQ(getNumFourOscs(*reloadedTrack), 1);
+    ASSERT_EQ(reloadedTrack->getClips().size(), 1);
+    EXPECT_FALSE(reloadedTrack->getClips()[0]->isMuted());
+
+    reloadedEdit = nullptr;
+    editFile.deleteFile();
+}
+
+TEST_F(TrackFreezerTest, trackDeletedWhileFreezingIsLeftAlone) {
+    auto freezeFile = freezer.getFreezeFile(*track);
+    freezer.freeze(track);
+    ASSERT_TRUE(freezer.isFreezing());
+    edit->deleteTrack(track.get());
+
+    for (int i = 0; i < 1000 && !finished; i++)
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+    ASSERT_TRUE(finished);
+    EXPECT_FALSE(succeeded);
+    EXPECT_FALSE(freezer.isFreezing());
+    EXPECT_FALSE(app_services::TrackFreezer::isFrozen(*track));
+    EXPECT_EQ(getNumFourOscs(), 1);
+    EXPECT_FALSE(freezeFile.existsAsFile());
+}
+
+} // namespace AppServicesTests
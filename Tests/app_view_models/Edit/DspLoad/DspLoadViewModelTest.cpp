@@ -0,0 +1,63 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class DspLoadViewModelTest : public ::testing::Test {
+  protected:
+    DspLoadViewModelTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          viewModel(tracktion::getAudioTracks(*edit)[0]) {}
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    app_view_models::DspLoadViewModel viewModel;
+};
+
+TEST_F(DspLoadViewModelTest, initialLoadIsZero) {
+    EXPECT_EQ(viewModel.getTrackLoad(), 0.0);
+    EXPECT_EQ(viewModel.getTrackPeakLoad(), 0.0);
+
+    for (auto plugin :
+         tracktion::getAudioTracks(*edit)[0]->pluginList.getPlugins()) {
+        EXPECT_EQ(viewModel.getPluginLoad(plugin), 0.0);
+        EXPECT_EQ(viewModel.getPluginPeakLoad(plugin), 0.0);
+    }
+}
+
+TEST_F(DspLoadViewModelTest, unknownPluginHasNoLoad) {
+    EXPECT_EQ(viewModel.getPluginLoad(nullptr), 0.0);
+    EXPECT_EQ(viewModel.getPluginPeakLoad(nullptr), 0.0);
+}
+
+TEST_F(DspLoadViewModelTest, formatLoad) {
+    using app_view_models::DspLoadViewModel;
+    EXPECT_EQ(DspLoadViewModel::formatLoad(0.0), "0%");
+    EXPECT_EQ(DspLoadViewModel::formatLoad(.254), "25%");
+    EXPECT_EQ(DspLoadViewModel::formatLoad(1.2), "120%");
+}
+
+TEST(DspLoadPeakHoldTest, peakIsHeld) {
+    app_view_models::DspLoadViewModel::PeakHoldValue value;
+    value.update(.5, 1000);
+    value.update(.1, 1500);
+    EXPECT_EQ(value.current, .1);
+    EXPECT_EQ(value.peak, .5);
+
+    // a higher value replaces the peak straight away
+    value.update(.7, 1600);
+    EXPECT_EQ(value.peak, .7);
+}
+
+TEST(DspLoadPeakHoldTest, peakIsReleasedAfterHoldTime) {
+    using PeakHoldValue = app_view_models::DspLoadViewModel::PeakHoldValue;
+    PeakHoldValue value;
+    value.update(.5, 1000);
+    value.update(.1, 1000 + PeakHoldValue::holdTimeMs);
+    EXPECT_EQ(value.peak, .5);
+
+    value.update(.1, 1001 + PeakHoldValue::holdTimeMs);
+    EXPECT_EQ(value.peak, .1);
+}
+
+} // namespace AppViewModelsTests
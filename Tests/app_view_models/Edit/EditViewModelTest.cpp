@@ -0,0 +1,59 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+class EditViewModelTest : public ::testing::Test {
+  protected:
+    EditViewModelTest()
+        : editFile(juce::File::createTempFile("edit")),
+          journalDirectory(juce::File::createTempFile("journal")),
+          edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          saver(*edit, editFile) {}
+
+    ~EditViewModelTest() override {
+        editFile.deleteFile();
+        journalDirectory.deleteRecursively();
+    }
+
+    juce::File editFile;
+    juce::File journalDirectory;
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    app_services::EditSaver saver;
+};
+
+TEST_F(EditViewModelTest, octaveIsConstrained) {
+    app_view_models::EditViewModel viewModel(*edit, &saver);
+    viewModel.setCurrentOctave(10);
+    EXPECT_EQ(viewModel.getCurrentOctave(), 4);
+
+    viewModel.setCurrentOctave(-10);
+    EXPECT_EQ(viewModel.getCurrentOctave(), -4);
+}
+
+TEST_F(EditViewModelTest, octaveChangeIsSavedWithTheJournalGeneration) {
+    juce::ValueTree savedState;
+    {
+        app_services::EditJournal journal(*edit, saver, journalDirectory);
+        app_view_models::EditViewModel viewModel(*edit, &saver);
+
+        auto track = tracktion::getAudioTracks(*edit)[0];
+        edit->insertNewAudioTrack(tracktion::TrackInsertPoint(nullptr, track),
+                                  nullptr);
+        viewModel.setCurrentOctave(2);
+        ASSERT_TRUE(saver.waitUntilSaved(5000));
+        EXPECT_EQ(journal.getGeneration(), 1);
+
+        auto xml = juce::parseXML(editFile);
+        ASSERT_NE(xml, nullptr);
+        savedState = juce::ValueTree::fromXml(*xml);
+    }
+
+    // Recovering from the saved edit doesn't add the track a second time
+    app_services::EditJournal::replay(savedState, journalDirectory);
+    EXPECT_TRUE(savedState.isEquivalentTo(edit->state));
+    EXPECT_EQ(tracktion::getAudioTracks(*edit).size(), 2);
+}
+
+} // namespace AppViewModelsTests
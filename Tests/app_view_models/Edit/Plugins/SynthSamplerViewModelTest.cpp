@@ -0,0 +1,124 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+
+namespace AppViewModelsTests {
+
+#if JUCE_LINUX
+
+class SynthSamplerViewModelTest : public ::testing::Test {
+  protected:
+    SynthSamplerViewModelTest()
+        : edit(tracktion::Edit::createSingleTrackEdit(engine)),
+          directory(juce::File::createTempFile("SynthSamplerViewModelTest")) {
+        directory.createDirectory();
+        for (auto name : {"a.wav", "b.wav", "c.wav"})
+            writeSample(directory.getChildFile(name));
+
+        index = std::make_unique<app_services::SampleLibraryIndex>(directory);
+
+        auto plugin = edit->getPluginCache().createNewPlugin(
+            tracktion::SamplerPlugin::xmlTypeName, {});
+        tracktion::getAudioTracks(*edit)[0]->pluginList.insertPlugin(
+            plugin, 0, nullptr);
+        sampler = dynamic_cast<tracktion::SamplerPlugin *>(plugin.get());
+
+        viewModel = std::make_unique<app_view_models::SynthSamplerViewModel>(
+            sampler, *index);
+        app_view_models::ChangeBus::getInstance()->deliverChanges();
+    }
+
+    ~SynthSamplerViewModelTest() override {
+        viewModel = nullptr;
+        index = nullptr;
+        directory.deleteRecursively();
+    }
+
+    static void writeSample(const juce::File &file) {
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+            new juce::FileOutputStream(file), 44100, 1, 16, {}, 0));
+
+        juce::AudioBuffer<float> buffer(1, 100);
+        buffer.clear();
+        writer->writeFromAudioSampleBuffer(buffer, 0, 100);
+    }
+
+    void select(int newIndex) {
+        viewModel->itemListState.setSelectedItemIndex(newIndex);
+        app_view_models::ChangeBus::getInstance()->deliverChanges();
+    }
+
+    // Deletes a sample and runs the message loop until the index has
+    // picked up the change, then lets the view model react to it
+    void deleteSample(const juce::String &name) {
+        const auto size = index->size();
+        directory.getChildFile(name).deleteFile();
+        for (int i = 0; i < 100 && index->size() == size; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+
+        ASSERT_EQ(index->size(), size - 1);
+        app_view_models::ChangeBus::getInstance()->deliverChanges();
+    }
+
+    juce::File getLoadedFile() {
+        return juce::File(sampler->getSoundMedia(0));
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    std::unique_ptr<tracktion::Edit> edit;
+    juce::File directory;
+    std::unique_ptr<app_services::SampleLibraryIndex> index;
+    tracktion::SamplerPlugin *sampler = nullptr;
+    std::unique_ptr<app_view_models::SynthSamplerViewModel> viewModel;
+};
+
+TEST_F(SynthSamplerViewModelTest, deletingTheLastSampleLoadsTheOneBefore) {
+    select(2);
+    ASSERT_EQ(getLoadedFile(), directory.getChildFile("c.wav"));
+
+    deleteSample("c.wav");
+
+    EXPECT_EQ(viewModel->itemListState.getSelectedItemIndex(), 1);
+    EXPECT_EQ(getLoadedFile(), directory.getChildFile("b.wav"));
+}
+
+TEST_F(SynthSamplerViewModelTest, deletingASampleLoadsTheOneThatTookItsPlace) {
+    ASSERT_EQ(viewModel->itemListState.getSelectedItemIndex(), 0);
+    ASSERT_EQ(getLoadedFile(), directory.getChildFile("a.wav"));
+
+    deleteSample("a.wav");
+
+    EXPECT_EQ(viewModel->itemListState.getSelectedItemIndex(), 0);
+    EXPECT_EQ(getLoadedFile(), directory.getChildFile("b.wav"));
+}
+
+TEST_F(SynthSamplerViewModelTest, selectionFollowsTheLoadedSample) {
+    select(1);
+    deleteSample("a.wav");
+
+    EXPECT_EQ(viewModel->itemListState.getSelectedItemIndex(), 0);
+    EXPECT_EQ(getLoadedFile(), directory.getChildFile("b.wav"));
+}
+
+TEST_F(SynthSamplerViewModelTest, firstSampleIsLoadedOnceTheScanFinishes) {
+    viewModel = nullptr;
+    sampler->removeSound(0);
+    index = std::make_unique<app_services::SampleLibraryIndex>(
+        directory, juce::File(), true);
+    viewModel = std::make_unique<app_view_models::SynthSamplerViewModel>(
+        sampler, *index);
+    EXPECT_EQ(viewModel->getSelectedItemName(), "Indexing samples...");
+    EXPECT_EQ(sampler->getNumSounds(), 0);
+
+    for (int i = 0; i < 100 && index->isScanning(); i++)
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+    ASSERT_FALSE(index->isScanning());
+    app_view_models::ChangeBus::getInstance()->deliverChanges();
+
+    EXPECT_EQ(viewModel->getSelectedItemName(), "a");
+    EXPECT_EQ(getLoadedFile(), directory.getChildFile("a.wav"));
+}
+
+#endif
+
+} // namespace AppViewModelsTests
@@ -0,0 +1,146 @@
+#include <app_view_models/app_view_models.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace AppViewModelsTests {
+
+// Records the order the clients are updated in
+class TestClient : public app_view_models::FlaggedAsyncUpdater {
+  public:
+    TestClient(int clientID, juce::Array<int> &updateOrder)
+        : id(clientID), order(updateOrder) {}
+
+    void handleAsyncUpdate() override {
+        order.add(id);
+        if (compareAndReset(shouldUpdateValue))
+            numValueUpdates++;
+
+        if (onUpdate)
+            onUpdate();
+    }
+
+    int id;
+    juce::Array<int> &order;
+    std::atomic<bool> shouldUpdateValue{false};
+    int numValueUpdates = 0;
+    std::function<void()> onUpdate;
+};
+
+class ChangeBusTest : public ::testing::Test {
+  protected:
+    ChangeBusTest() : bus(*app_view_models::ChangeBus::getInstance()) {
+        bus.deliverChanges();
+        bus.resetMetrics();
+    }
+
+    app_view_models::ChangeBus &bus;
+    juce::Array<int> order;
+};
+
+TEST_F(ChangeBusTest, repeatedMarksAreDeliveredOnce) {
+    TestClient client(1, order);
+    for (int i = 0; i < 5; i++)
+        client.markAndUpdate(client.shouldUpdateValue);
+
+    bus.deliverChanges();
+
+    EXPECT_EQ(order, juce::Array<int>({1}));
+    EXPECT_EQ(client.numValueUpdates, 1);
+    EXPECT_FALSE(client.isUpdatePending());
+
+    const auto metrics = bus.getMetrics();
+    EXPECT_EQ(metrics.numMarks, 5);
+    EXPECT_EQ(metrics.numPasses, 1);
+    EXPECT_EQ(metrics.lastFanOut, 1);
+}
+
+TEST_F(ChangeBusTest, clientsAreUpdatedInTheOrderTheyWereCreated) {
+    TestClient first(1, order);
+    TestClient second(2, order);
+    TestClient third(3, order);
+
+    third.triggerAsyncUpdate();
+    first.triggerAsyncUpdate();
+    second.triggerAsyncUpdate();
+    bus.deliverChanges();
+
+    EXPECT_EQ(order, juce::Array<int>({1, 2, 3}));
+    EXPECT_EQ(bus.getMetrics().lastFanOut, 3);
+    EXPECT_EQ(bus.getMetrics().maxFanOut, 3);
+}
+
+TEST_F(ChangeBusTest, onlyMarkedClientsAreUpdated) {
+    TestClient first(1, order);
+    TestClient second(2, order);
+
+    second.triggerAsyncUpdate();
+    bus.deliverChanges();
+
+    EXPECT_EQ(order, juce::Array<int>({2}));
+}
+
+TEST_F(ChangeBusTest, marksFromOtherThreadsAreDelivered) {
+    TestClient client(1, order);
+    std::thread thread(
+        [&client] { client.markAndUpdate(client.shouldUpdateValue); });
+    thread.join();
+
+    EXPECT_TRUE(client.isUpdatePending());
+    bus.deliverChanges();
+    EXPECT_EQ(client.numValueUpdates, 1);
+}
+
+TEST_F(ChangeBusTest, passIsDeliveredByTheMessageLoop) {
+    TestClient client(1, order);
+    client.triggerAsyncUpdate();
+
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(50);
+    EXPECT_EQ(order, juce::Array<int>({1}));
+}
+
+TEST_F(ChangeBusTest, clientsDeletedDuringAPassAreSkipped) {
+    TestClient first(1, order);
+    auto second = std::make_unique<TestClient>(2, order);
+    TestClient third(3, order);
+    first.onUpdate = [&second] { second = nullptr; };
+
+    first.triggerAsyncUpdate();
+    second->triggerAsyncUpdate();
+    third.triggerAsyncUpdate();
+    bus.deliverChanges();
+
+    EXPECT_EQ(order, juce::Array<int>({1, 3}));
+}
+
+TEST_F(ChangeBusTest, clientsMarkedDuringAPassAreUpdatedOnce) {
+    TestClient first(1, order);
+    TestClient second(2, order);
+    first.onUpdate = [&] {
+        first.triggerAsyncUpdate();
+        second.triggerAsyncUpdate();
+    };
+
+    first.triggerAsyncUpdate();
+    bus.deliverChanges();
+    EXPECT_EQ(order, juce::Array<int>({1, 2}));
+
+    // The first client has already been passed, so it waits for the next one
+    first.onUpdate = nullptr;
+    bus.deliverChanges();
+    EXPECT_EQ(order, juce::Array<int>({1, 2, 1}));
+}
+
+TEST_F(ChangeBusTest, handleUpdateNowIfNeededOnlyUpdatesThatClient) {
+    TestClient first(1, order);
+    TestClient second(2, order);
+
+    first.triggerAsyncUpdate();
+    second.triggerAsyncUpdate();
+    second.handleUpdateNowIfNeeded();
+
+    EXPECT_EQ(order, juce::Array<int>({2}));
+    EXPECT_TRUE(first.isUpdatePending());
+    EXPECT_FALSE(second.isUpdatePending());
+}
+
+} // namespace AppViewModelsTests
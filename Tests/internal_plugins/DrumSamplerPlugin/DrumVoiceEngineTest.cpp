@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <internal_plugins/internal_plugins.h>
+namespace InternalPluginsTests {
+
+class DrumVoiceEngineTest : public ::testing::Test {
+  protected:
+    static constexpr int blockSize = 512;
+
+    DrumVoiceEngineTest() : buffer(2, blockSize) { buffer.clear(); }
+
+    // Adds a mono sound that outputs a constant value when the note is played
+    void addSound(int noteNumber, float value, int length,
+                  int chokeGroup = 0) {
+        addSound(soundSet, noteNumber, value, length, chokeGroup);
+    }
+
+    static void addSound(internal_plugins::DrumSoundSet &set, int noteNumber,
+                         float value, int length, int chokeGroup = 0) {
+        auto sound = std::make_unique<internal_plugins::DrumSound>();
+        std::vector<float> samples(size_t(length), value);
+        sound->head.setSize(1, length);
+        sound->head.write(0, 0, samples.data(), length);
+        sound->lengthInSamples = length;
+        sound->numChannels = 1;
+        sound->keyNote = noteNumber;
+        sound->minNote = noteNumber;
+        sound->maxNote = noteNumber;
+        sound->chokeGroup = chokeGroup;
+        set.sounds.add(sound.release());
+    }
+
+    internal_plugins::DrumSoundSet soundSet{1};
+    juce::AudioBuffer<float> buffer;
+};
+
+TEST_F(DrumVoiceEngineTest, rendersSoundIntoBothChannels) {
+    internal_plugins::DrumVoiceEngine engine(4);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.5f, 44100);
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.render(buffer, 0, blockSize);
+
+    EXPECT_NEAR(buffer.getSample(0, 100), 0.5f, 1.0e-5f);
+    EXPECT_NEAR(buffer.getSample(1, 100), 0.5f, 1.0e-5f);
+    EXPECT_EQ(engine.getNumActiveVoices(), 1);
+}
+
+TEST_F(DrumVoiceEngineTest, voicesStopAtTheEndOfTheSound) {
+    internal_plugins::DrumVoiceEngine engine(4);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.5f, 100);
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.render(buffer, 0, blockSize);
+
+    EXPECT_EQ(engine.getNumActiveVoices(), 0);
+    EXPECT_NEAR(buffer.getSample(0, 50), 0.5f, 1.0e-5f);
+    EXPECT_NEAR(buffer.getSample(0, 200), 0.0f, 1.0e-5f);
+}
+
+TEST_F(DrumVoiceEngineTest, chokeGroupCutsOffOtherSounds) {
+    internal_plugins::DrumVoiceEngine engine(4);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.5f, 44100, 1);
+    addSound(61, 0.25f, 44100, 1);
+    addSound(62, 0.125f, 44100);
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.noteOn(soundSet, 62, 1.0f);
+    engine.render(buffer, 0, blockSize);
+    EXPECT_EQ(engine.getNumActiveVoices(), 2);
+
+    // The first sound fades out within a block
+    engine.noteOn(soundSet, 61, 1.0f);
+    engine.render(buffer, 0, blockSize);
+    EXPECT_EQ(engine.getNumActiveVoices(), 2);
+
+    buffer.clear();
+    engine.render(buffer, 0, blockSize);
+    EXPECT_NEAR(buffer.getSample(0, 100), 0.375f, 1.0e-5f);
+}
+
+TEST_F(DrumVoiceEngineTest, stealsTheOldestVoiceWhenFull) {
+    internal_plugins::DrumVoiceEngine engine(2);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.125f, 44100);
+    addSound(61, 0.25f, 44100);
+    addSound(62, 0.5f, 44100);
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.noteOn(soundSet, 61, 1.0f);
+    engine.noteOn(soundSet, 62, 1.0f);
+    engine.render(buffer, 0, blockSize);
+
+    EXPECT_EQ(engine.getNumActiveVoices(), 2);
+    EXPECT_NEAR(buffer.getSample(0, 100), 0.75f, 1.0e-5f);
+}
+
+TEST_F(DrumVoiceEngineTest, noteOffReleasesVoicesThatAreNotOpenEnded) {
+    internal_plugins::DrumVoiceEngine engine(4);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.5f, 44100);
+    addSound(61, 0.5f, 44100);
+    soundSet.sounds[1]->openEnded = true;
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.noteOn(soundSet, 61, 1.0f);
+    engine.noteOff(60);
+    engine.noteOff(61);
+    engine.render(buffer, 0, blockSize);
+
+    EXPECT_EQ(engine.getNumActiveVoices(), 1);
+}
+
+TEST_F(DrumVoiceEngineTest, stoppingASetOnlyStopsItsVoices) {
+    internal_plugins::DrumVoiceEngine engine(4);
+    engine.prepare(44100.0, blockSize);
+    addSound(60, 0.5f, 44100);
+
+    // The sounds were reloaded while the first voice was playing
+    internal_plugins::DrumSoundSet reloadedSet{2};
+    addSound(reloadedSet, 60, 0.25f, 44100);
+
+    engine.noteOn(soundSet, 60, 1.0f);
+    engine.noteOn(reloadedSet, 60, 1.0f);
+    engine.stopVoicesFromSet(soundSet.version);
+    engine.render(buffer, 0, blockSize);
+
+    EXPECT_EQ(engine.getNumActiveVoices(), 1);
+    EXPECT_NEAR(buffer.getSample(0, 100), 0.25f, 1.0e-5f);
+}
+
+} // namespace InternalPluginsTests
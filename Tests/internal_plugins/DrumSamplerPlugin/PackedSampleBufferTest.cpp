@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <internal_plugins/internal_plugins.h>
+namespace InternalPluginsTests {
+
+using Format = internal_plugins::PackedSampleBuffer::Format;
+
+class PackedSampleBufferTest : public ::testing::TestWithParam<Format> {
+  protected:
+    static constexpr int length = 44100;
+    static constexpr int blockSize = 512;
+
+    PackedSampleBufferTest() : source(2, length) {
+        juce::Random random(1234);
+        for (int channel = 0; channel < 2; channel++)
+            for (int i = 0; i < length; i++)
+                source.setSample(
+                    channel, i,
+                    0.8f * std::sin(0.05f * float(i + channel)) +
+                        0.1f * (random.nextFloat() * 2.0f - 1.0f));
+    }
+
+    // The largest error a sample can have after being stored
+    static float getMaxError(Format format) {
+        switch (format) {
+        case Format::int16:
+            return 1.0f / 32768.0f;
+        case Format::int24:
+            return 1.0f / 8388608.0f;
+        case Format::float32:
+        default:
+            return 0.0f;
+        }
+    }
+
+    std::unique_ptr<internal_plugins::DrumSound> createSound(Format format) {
+        auto sound = std::make_unique<internal_plugins::DrumSound>();
+        sound->head.setSize(2, length, format);
+        for (int channel = 0; channel < 2; channel++)
+            sound->head.write(channel, 0, source.getReadPointer(channel),
+                              length);
+
+        sound->lengthInSamples = length;
+        sound->numChannels = 2;
+        return sound;
+    }
+
+    juce::AudioBuffer<float> render(Format format) {
+        internal_plugins::DrumSoundSet soundSet(1);
+        soundSet.sounds.add(createSound(format).release());
+
+        internal_plugins::DrumVoiceEngine engine(4);
+        engine.prepare(44100.0, blockSize);
+        engine.noteOn(soundSet, 60, 1.0f);
+
+        juce::AudioBuffer<float> output(2, length);
+        output.clear();
+        for (int position = 0; position < length; position += blockSize)
+            engine.render(output, position,
+                          juce::jmin(blockSize, length - position));
+
+        return output;
+    }
+
+    juce::AudioBuffer<float> source;
+};
+
+TEST_P(PackedSampleBufferTest, readReturnsWrittenSamples) {
+    internal_plugins::PackedSampleBuffer buffer;
+    buffer.setSize(2, length, GetParam());
+    for (int channel = 0; channel < 2; channel++)
+        buffer.write(channel, 0, source.getReadPointer(channel), length);
+
+    std::vector<float> samples(length);
+    for (int channel = 0; channel < 2; channel++) {
+        buffer.read(channel, 0, samples.data(), length);
+        for (int i = 0; i < length; i++)
+            ASSERT_NEAR(samples[size_t(i)], source.getSample(channel, i),
+                        getMaxError(GetParam()));
+    }
+}
+
+TEST_P(PackedSampleBufferTest, usesLessMemoryForLowerBitDepths) {
+    internal_plugins::PackedSampleBuffer buffer;
+    buffer.setSize(2, length, GetParam());
+    const auto bytesPerSample =
+        internal_plugins::PackedSampleBuffer::getBytesPerSample(GetParam());
+    EXPECT_EQ(buffer.getSizeInBytes(),
+              size_t(2 * length) * size_t(bytesPerSample));
+}
+
+// Renders the sound stored as floats and in the test's format, then checks
+// that the difference between them is no more than the quantisation error
+TEST_P(PackedSampleBufferTest, nullTestAgainstFloatStorage) {
+    auto reference = render(Format::float32);
+    auto packed = render(GetParam());
+
+    for (int channel = 0; channel < 2; channel++) {
+        juce::FloatVectorOperations::subtract(
+            packed.getWritePointer(channel), reference.getReadPointer(channel),
+            length);
+        EXPECT_LE(packed.getMagnitude(channel, 0, length),
+                  getMaxError(GetParam()));
+    }
+
+    // The sound must actually have been rendered for the test to mean anything
+    EXPECT_GT(reference.getMagnitude(0, 0, length), 0.5f);
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, PackedSampleBufferTest,
+                         ::testing::Values(Format::float32, Format::int24,
+                                           Format::int16));
+
+} // namespace InternalPluginsTests
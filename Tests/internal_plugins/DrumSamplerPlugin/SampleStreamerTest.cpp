@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <internal_plugins/internal_plugins.h>
+namespace InternalPluginsTests {
+
+class SampleStreamerTest : public ::testing::Test {
+  protected:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int soundLength = 44100;
+
+    SampleStreamerTest() : streamer(1) {
+        formatManager.registerBasicFormats();
+        streamer.startThread();
+    }
+
+    ~SampleStreamerTest() override { streamer.stopThread(); }
+
+    // Writes a mono sound where each sample is worked out from its position,
+    // so a read can be checked against the part of the sound it came from
+    static void writeSound(const juce::File &file,
+                           const std::function<float(int)> &getSample) {
+        juce::AudioBuffer<float> buffer(1, soundLength);
+        for (int i = 0; i < soundLength; i++)
+            buffer.setSample(0, i, getSample(i));
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(new juce::FileOutputStream(file),
+                                      sampleRate, 1, 32, {}, 0));
+        writer->writeFromAudioSampleBuffer(buffer, 0, soundLength);
+    }
+
+    static float getRampSample(int position) {
+        return float(position % 1000) / 1000.0f;
+    }
+
+    internal_plugins::DrumSoundSet::Ptr loadSet(const juce::File &file,
+                                                int version) {
+        internal_plugins::DrumSoundSet::Ptr set(
+            new internal_plugins::DrumSoundSet(version));
+        auto sound = internal_plugins::DrumSoundSet::loadSound(
+            formatManager, file, 0.0, 0.0, true, sampleRate);
+        if (sound != nullptr)
+            set->sounds.add(sound.release());
+
+        return set;
+    }
+
+    // Reads from the stream until numSamples have been read or the disk
+    // thread has had plenty of time to provide them
+    int readFully(juce::AudioBuffer<float> &dest, int numSamples) {
+        int numRead = 0;
+        for (int i = 0; i < 200 && numRead < numSamples; i++) {
+            numRead += streamer.read(0, dest, numRead, numSamples - numRead);
+            if (numRead < numSamples)
+                juce::Thread::sleep(10);
+        }
+
+        return numRead;
+    }
+
+    juce::AudioFormatManager formatManager;
+    juce::TemporaryFile soundFile{".wav"};
+    internal_plugins::SampleStreamer streamer;
+};
+
+TEST_F(SampleStreamerTest, streamContinuesFromTheEndOfTheHead) {
+    writeSound(soundFile.getFile(), getRampSample);
+    auto set = loadSet(soundFile.getFile(), 1);
+    ASSERT_EQ(set->sounds.size(), 1);
+    ASSERT_TRUE(set->sounds[0]->isStreamed());
+    streamer.setSoundSet(set);
+
+    streamer.start(0, 0, set->version);
+    EXPECT_EQ(streamer.getNumActiveStreams(), 1);
+
+    // Longer than the ring, so the disk thread has to refill it
+    const int numSamples = internal_plugins::SampleStreamer::ringLength * 2;
+    juce::AudioBuffer<float> dest(2, numSamples);
+    dest.clear();
+    ASSERT_EQ(readFully(dest, numSamples), numSamples);
+
+    const auto headLength = set->sounds[0]->getHeadLength();
+    for (int i = 0; i < numSamples; i += 97)
+        EXPECT_NEAR(dest.getSample(0, i), getRampSample(headLength + i),
+                    1.0e-6f);
+
+    streamer.stop(0);
+    EXPECT_EQ(streamer.getNumActiveStreams(), 0);
+}
+
+TEST_F(SampleStreamerTest, readingAStreamThatIsntStreamingIsAnUnderrun) {
+    juce::AudioBuffer<float> dest(2, 256);
+    EXPECT_EQ(streamer.read(0, dest, 0, 256), 0);
+    EXPECT_EQ(streamer.getNumUnderruns(), 1);
+}
+
+TEST_F(SampleStreamerTest, readingPastTheEndOfTheSoundIsAnUnderrun) {
+    writeSound(soundFile.getFile(), getRampSample);
+    auto set = loadSet(soundFile.getFile(), 1);
+    ASSERT_EQ(set->sounds.size(), 1);
+    streamer.setSoundSet(set);
+    streamer.start(0, 0, set->version);
+
+    // Everything after the head, plus a block more than the sound has
+    const auto numStreamed = int(set->sounds[0]->lengthInSamples -
+                                 set->sounds[0]->getHeadLength());
+    juce::AudioBuffer<float> dest(2, numStreamed + 512);
+    EXPECT_EQ(readFully(dest, numStreamed + 512), numStreamed);
+    EXPECT_GT(streamer.getNumUnderruns(), 0);
+}
+
+TEST_F(SampleStreamerTest, reloadedSetIsStreamedOnceRestarted) {
+    writeSound(soundFile.getFile(), getRampSample);
+    auto firstSet = loadSet(soundFile.getFile(), 1);
+    streamer.setSoundSet(firstSet);
+    streamer.start(0, 0, firstSet->version);
+
+    // Reloading the sounds replaces the set, and a voice restarted with the
+    // new set streams from it
+    juce::TemporaryFile otherFile(".wav");
+    writeSound(otherFile.getFile(), [](int) { return 0.25f; });
+    auto secondSet = loadSet(otherFile.getFile(), 2);
+    ASSERT_EQ(secondSet->sounds.size(), 1);
+    streamer.setSoundSet(secondSet, firstSet);
+    streamer.stop(0);
+    streamer.start(0, 0, secondSet->version);
+
+    const int numSamples = 4096;
+    juce::AudioBuffer<float> dest(2, numSamples);
+    dest.clear();
+    ASSERT_EQ(readFully(dest, numSamples), numSamples);
+    for (int i = 0; i < numSamples; i += 97)
+        EXPECT_NEAR(dest.getSample(0, i), 0.25f, 1.0e-6f);
+}
+
+TEST_F(SampleStreamerTest, streamsFromThePreviousSetCarryOn) {
+    writeSound(soundFile.getFile(), getRampSample);
+    auto firstSet = loadSet(soundFile.getFile(), 1);
+    ASSERT_EQ(firstSet->sounds.size(), 1);
+    streamer.setSoundSet(firstSet);
+    streamer.start(0, 0, firstSet->version);
+
+    // The sounds are reloaded while the voice is playing the first set
+    juce::TemporaryFile otherFile(".wav");
+    writeSound(otherFile.getFile(), [](int) { return 0.25f; });
+    streamer.setSoundSet(loadSet(otherFile.getFile(), 2), firstSet);
+
+    const int numSamples = 4096;
+    juce::AudioBuffer<float> dest(2, numSamples);
+    dest.clear();
+    ASSERT_EQ(readFully(dest, numSamples), numSamples);
+
+    const auto headLength = firstSet->sounds[0]->getHeadLength();
+    for (int i = 0; i < numSamples; i += 97)
+        EXPECT_NEAR(dest.getSample(0, i), getRampSample(headLength + i),
+                    1.0e-6f);
+}
+
+} // namespace InternalPluginsTests
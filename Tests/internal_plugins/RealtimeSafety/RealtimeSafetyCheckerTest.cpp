@@ -0,0 +1,343 @@
+#include <app_services/app_services.h>
+#include <gtest/gtest.h>
+#include <internal_plugins/internal_plugins.h>
+namespace InternalPluginsTests {
+
+using ViolationType = internal_plugins::RealtimeSafetyChecker::ViolationType;
+
+// Stored to so the compiler can't remove the allocations
+void *volatile allocation = nullptr;
+
+class RealtimeSafetyCheckerTest : public ::testing::Test {
+  protected:
+    static bool hasViolation(ViolationType type,
+                             const internal_plugins::RealtimeSafetyChecker
+                                 &checker) {
+        for (const auto &violation : checker.getViolations())
+            if (violation.type == type)
+                return true;
+
+        return false;
+    }
+};
+
+TEST_F(RealtimeSafetyCheckerTest, allocationsInRealtimeSectionsAreRecorded) {
+    if (!internal_plugins::RealtimeSafetyChecker::canInterceptAllocations())
+        GTEST_SKIP();
+
+    internal_plugins::RealtimeSafetyChecker checker;
+    {
+        const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+            section;
+        allocation = std::malloc(64);
+        std::free(allocation);
+    }
+
+    EXPECT_TRUE(hasViolation(ViolationType::ALLOCATION, checker));
+    EXPECT_TRUE(hasViolation(ViolationType::DEALLOCATION, checker));
+    ASSERT_FALSE(checker.getViolations().isEmpty());
+    EXPECT_TRUE(checker.getViolations()[0].stackTrace.isNotEmpty());
+}
+
+TEST_F(RealtimeSafetyCheckerTest, allocationsOutsideRealtimeSectionsAreFine) {
+    internal_plugins::RealtimeSafetyChecker checker;
+    allocation = std::malloc(64);
+    std::free(allocation);
+
+    EXPECT_FALSE(
+        internal_plugins::RealtimeSafetyChecker::isInRealtimeSection());
+    EXPECT_TRUE(checker.getViolations().isEmpty());
+}
+
+TEST_F(RealtimeSafetyCheckerTest, locksInRealtimeSectionsAreRecorded) {
+    if (!internal_plugins::RealtimeSafetyChecker::canInterceptAllocations())
+        GTEST_SKIP();
+
+    juce::CriticalSection lock;
+    internal_plugins::RealtimeSafetyChecker checker;
+    {
+        const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+            section;
+        const juce::ScopedLock sl(lock);
+    }
+
+    EXPECT_TRUE(hasViolation(ViolationType::LOCK, checker));
+}
+
+TEST_F(RealtimeSafetyCheckerTest, loggingInRealtimeSectionsIsRecorded) {
+    internal_plugins::RealtimeSafetyChecker checker;
+    {
+        const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+            section;
+        juce::Logger::writeToLog("From the audio thread");
+    }
+
+    EXPECT_TRUE(hasViolation(ViolationType::LOGGING, checker));
+}
+
+TEST_F(RealtimeSafetyCheckerTest, nothingIsRecordedWithoutAChecker) {
+    {
+        const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+            section;
+        allocation = std::malloc(64);
+        std::free(allocation);
+    }
+
+    internal_plugins::RealtimeSafetyChecker checker;
+    EXPECT_TRUE(checker.getViolations().isEmpty());
+}
+
+// One of the engine's built in plugins with its applyToBuffer marked as
+// real-time, so it is checked while the edit is rendered. Each one is
+// registered under its own type so it doesn't replace the engine's.
+template <typename PluginType> class CheckedPlugin : public PluginType {
+  public:
+    static const char *xmlTypeName;
+
+    explicit CheckedPlugin(tracktion::PluginCreationInfo info)
+        : PluginType(info) {}
+
+    juce::String getPluginType() override { return xmlTypeName; }
+
+    void applyToBuffer(const tracktion::PluginRenderContext &fc) override {
+        const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+            section;
+        PluginType::applyToBuffer(fc);
+    }
+};
+
+template <>
+const char *CheckedPlugin<tracktion::ReverbPlugin>::xmlTypeName =
+    "checkedReverb";
+template <>
+const char *CheckedPlugin<tracktion::DelayPlugin>::xmlTypeName =
+    "checkedDelay";
+template <>
+const char *CheckedPlugin<tracktion::CompressorPlugin>::xmlTypeName =
+    "checkedCompressor";
+
+// Renders an edit with a drum sampler on every track playing dense chords,
+// which is the busiest the drum sampler gets, and checks its audio thread
+// code, and that of any effects after it, doesn't allocate, lock or log
+class RealtimeSafetyRenderTest : public ::testing::Test,
+                                 public app_services::EditRenderJob::Listener {
+  protected:
+    static constexpr int numTracks = 4;
+    static constexpr int numPads = 16;
+    static constexpr int firstNote = 36;
+
+    RealtimeSafetyRenderTest()
+        : sampleFile(juce::File::createTempFile(".wav")),
+          renderFile(juce::File::createTempFile(".wav")) {
+        engine.getPluginManager()
+            .createBuiltInType<internal_plugins::DrumSamplerPlugin>();
+        engine.getPluginManager()
+            .createBuiltInType<CheckedPlugin<tracktion::ReverbPlugin>>();
+        engine.getPluginManager()
+            .createBuiltInType<CheckedPlugin<tracktion::DelayPlugin>>();
+        engine.getPluginManager()
+            .createBuiltInType<CheckedPlugin<tracktion::CompressorPlugin>>();
+        writeSampleFile();
+
+        edit = tracktion::Edit::createSingleTrackEdit(engine);
+        edit->ensureNumberOfAudioTracks(numTracks);
+        for (auto track : tracktion::getAudioTracks(*edit))
+            addDrumSampler(*track);
+
+        // The sounds are loaded asynchronously
+        juce::MessageManager::getInstance()->runDispatchLoopUntil(1000);
+    }
+
+    ~RealtimeSafetyRenderTest() override {
+        edit = nullptr;
+        sampleFile.deleteFile();
+        renderFile.deleteFile();
+    }
+
+    void writeSampleFile() {
+        const auto numSamples = 44100;
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        juce::Random random;
+        for (int channel = 0; channel < 2; channel++)
+            for (int i = 0; i < numSamples; i++)
+                buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+            new juce::FileOutputStream(sampleFile), 44100.0, 2, 24, {}, 0));
+        writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+    }
+
+    void addDrumSampler(tracktion::AudioTrack &track) {
+        auto plugin = edit->getPluginCache().createNewPlugin(
+            internal_plugins::DrumSamplerPlugin::xmlTypeName, {});
+        auto *sampler =
+            dynamic_cast<internal_plugins::DrumSamplerPlugin *>(plugin.get());
+        for (int i = 0; i < numPads; i++) {
+            sampler->addSound(sampleFile.getFullPathName(), "pad", 0.0, 0.0,
+                              0.0f);
+            sampler->setSoundParams(i, firstNote + i, firstNote + i,
+                                    firstNote + i);
+            sampler->setSoundChokeGroup(i, i % 4);
+        }
+        track.pluginList.insertPlugin(plugin, 0, nullptr);
+
+        auto clip = dynamic_cast<tracktion::MidiClip *>(track.insertNewClip(
+            tracktion::TrackItem::Type::midi,
+            {tracktion::TimePosition::fromSeconds(0),
+             tracktion::TimePosition::fromSeconds(4)},
+            nullptr));
+        for (int step = 0; step < 32; step++)
+            for (int i = 0; i < 4; i++)
+                clip->getSequence().addNote(
+                    firstNote + (step + i * 3) % numPads,
+                    tracktion::BeatPosition::fromBeats(step * 0.25),
+                    tracktion::BeatDuration::fromBeats(0.25), 100, 0,
+                    nullptr);
+    }
+
+    void addBuiltInEffects(tracktion::AudioTrack &track) {
+        for (auto type : {CheckedPlugin<tracktion::ReverbPlugin>::xmlTypeName,
+                          CheckedPlugin<tracktion::DelayPlugin>::xmlTypeName,
+                          CheckedPlugin<
+                              tracktion::CompressorPlugin>::xmlTypeName}) {
+            auto plugin = edit->getPluginCache().createNewPlugin(type, {});
+            ASSERT_NE(plugin, nullptr);
+            track.pluginList.insertPlugin(plugin, -1, nullptr);
+        }
+    }
+
+    void render() {
+        // Track indexes are counted from all of the edit's tracks
+        juce::BigInteger tracksToDo;
+        auto tracks = tracktion::getAllTracks(*edit);
+        for (auto track : tracktion::getAudioTracks(*edit))
+            tracksToDo.setBit(tracks.indexOf(track));
+
+        app_services::EditRenderJob job(*edit, renderFile, tracksToDo);
+        job.addListener(this);
+        job.start();
+        for (int i = 0; i < 1000 && !finished; i++)
+            juce::MessageManager::getInstance()->runDispatchLoopUntil(10);
+        job.removeListener(this);
+
+        ASSERT_TRUE(finished);
+        EXPECT_EQ(result, app_services::EditRenderJob::Result::SUCCEEDED);
+    }
+
+    void renderFinished(app_services::EditRenderJob::Result r) override {
+        result = r;
+        finished = true;
+    }
+
+    tracktion::Engine engine{"ENGINE"};
+    juce::File sampleFile;
+    juce::File renderFile;
+    std::unique_ptr<tracktion::Edit> edit;
+    bool finished = false;
+    app_services::EditRenderJob::Result result =
+        app_services::EditRenderJob::Result::FAILED;
+};
+
+TEST_F(RealtimeSafetyRenderTest, drumSamplerRenderIsRealtimeSafe) {
+    internal_plugins::RealtimeSafetyChecker checker;
+    render();
+    EXPECT_TRUE(checker.getViolations().isEmpty())
+        << checker.describeViolations();
+}
+
+TEST_F(RealtimeSafetyRenderTest, builtInEffectsAreRealtimeSafe) {
+    for (auto track : tracktion::getAudioTracks(*edit))
+        addBuiltInEffects(*track);
+
+    internal_plugins::RealtimeSafetyChecker checker;
+    render();
+    EXPECT_TRUE(checker.getViolations().isEmpty())
+        << checker.describeViolations();
+}
+
+#if JUCE_PLUGINHOST_VST3 && defined(LMN3_EXAMPLE_SYNTH_PLUGIN) &&              \
+    defined(LMN3_EXAMPLE_FX_PLUGIN)
+
+// Hosts the example plugins that are built alongside the app. The checker
+// sees everything the process does, so a plugin doesn't have to mark its own
+// code for its processBlock to be checked.
+class ExamplePluginRealtimeSafetyTest : public ::testing::Test {
+  protected:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 512;
+    static constexpr int numBlocks = 200;
+
+    std::unique_ptr<juce::AudioPluginInstance>
+    loadPlugin(const juce::String &file) {
+        juce::OwnedArray<juce::PluginDescription> types;
+        format.findAllTypesForFile(types, file);
+        if (types.isEmpty())
+            return nullptr;
+
+        juce::String error;
+        auto instance = format.createInstanceFromDescription(
+            *types[0], sampleRate, blockSize, error);
+        if (instance != nullptr)
+            instance->prepareToPlay(sampleRate, blockSize);
+
+        return instance;
+    }
+
+    // Plays a note on and off into noise. Only processBlock is real-time, the
+    // input is made up outside of it.
+    static void processBlocks(juce::AudioPluginInstance &instance) {
+        juce::AudioBuffer<float> buffer(
+            juce::jmax(1, instance.getTotalNumInputChannels(),
+                       instance.getTotalNumOutputChannels()),
+            blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(1024);
+        juce::Random random;
+
+        for (int block = 0; block < numBlocks; block++) {
+            for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+                for (int i = 0; i < blockSize; i++)
+                    buffer.setSample(channel, i,
+                                     (random.nextFloat() - 0.5f) * 0.5f);
+
+            midi.clear();
+            if (block % 8 == 0)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 60, 0.8f), 0);
+            else if (block % 8 == 4)
+                midi.addEvent(juce::MidiMessage::noteOff(1, 60), 0);
+
+            const internal_plugins::RealtimeSafetyChecker::ScopedRealtimeSection
+                section;
+            instance.processBlock(buffer, midi);
+        }
+
+        instance.releaseResources();
+    }
+
+    juce::VST3PluginFormat format;
+};
+
+TEST_F(ExamplePluginRealtimeSafetyTest, exampleSynthPluginIsRealtimeSafe) {
+    auto instance = loadPlugin(LMN3_EXAMPLE_SYNTH_PLUGIN);
+    ASSERT_NE(instance, nullptr);
+
+    internal_plugins::RealtimeSafetyChecker checker;
+    processBlocks(*instance);
+    EXPECT_TRUE(checker.getViolations().isEmpty())
+        << checker.describeViolations();
+}
+
+TEST_F(ExamplePluginRealtimeSafetyTest, exampleFxPluginIsRealtimeSafe) {
+    auto instance = loadPlugin(LMN3_EXAMPLE_FX_PLUGIN);
+    ASSERT_NE(instance, nullptr);
+
+    internal_plugins::RealtimeSafetyChecker checker;
+    processBlocks(*instance);
+    EXPECT_TRUE(checker.getViolations().isEmpty())
+        << checker.describeViolations();
+}
+
+#endif
+
+} // namespace InternalPluginsTests
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <internal_plugins/internal_plugins.h>
+namespace InternalPluginsTests {
+
+class ResampledSampleCacheTest : public ::testing::Test {
+  protected:
+    static constexpr double sourceSampleRate = 48000.0;
+    static constexpr int sourceLength = 48000;
+
+    ResampledSampleCacheTest() {
+        formatManager.registerBasicFormats();
+
+        // One second of a 1kHz sine at full scale
+        writeSine(sourceFile.getFile(), 1000.0f);
+    }
+
+    static void writeSine(const juce::File &file, float frequency) {
+        // A FileOutputStream appends to an existing file
+        file.deleteFile();
+
+        juce::AudioBuffer<float> buffer(1, sourceLength);
+        for (int i = 0; i < sourceLength; i++)
+            buffer.setSample(0, i,
+                             std::sin(juce::MathConstants<float>::twoPi *
+                                      frequency * float(i) /
+                                      float(sourceSampleRate)));
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wavFormat.createWriterFor(new juce::FileOutputStream(file),
+                                      sourceSampleRate, 1, 32, {}, 0));
+        writer->writeFromAudioSampleBuffer(buffer, 0, sourceLength);
+    }
+
+    juce::AudioBuffer<float> readDestFile() {
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formatManager.createReaderFor(destFile.getFile()));
+        if (reader == nullptr)
+            return {};
+
+        juce::AudioBuffer<float> buffer(1, int(reader->lengthInSamples));
+        reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, false);
+        return buffer;
+    }
+
+    juce::AudioFormatManager formatManager;
+    juce::TemporaryFile sourceFile{".wav"};
+    juce::TemporaryFile destFile{".wav"};
+};
+
+TEST_F(ResampledSampleCacheTest, convertFileWritesTargetSampleRate) {
+    ASSERT_TRUE(internal_plugins::ResampledSampleCache::convertFile(
+        sourceFile.getFile(), destFile.getFile(), 44100.0));
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(destFile.getFile()));
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->sampleRate, 44100.0);
+    EXPECT_EQ(reader->lengthInSamples, 44100);
+}
+
+TEST_F(ResampledSampleCacheTest, convertFileKeepsSignalLevel) {
+    ASSERT_TRUE(internal_plugins::ResampledSampleCache::convertFile(
+        sourceFile.getFile(), destFile.getFile(), 44100.0));
+
+    const auto buffer = readDestFile();
+    ASSERT_EQ(buffer.getNumSamples(), 44100);
+
+    // Skip the edges where the sine starts and stops abruptly
+    EXPECT_NEAR(buffer.getMagnitude(0, 1000, 42000), 1.0f, 0.01f);
+    EXPECT_NEAR(buffer.getRMSLevel(0, 1000, 42000),
+                juce::MathConstants<float>::sqrt2 / 2.0f, 0.01f);
+}
+
+TEST_F(ResampledSampleCacheTest, downsamplingFiltersOutContentAboveNyquist) {
+    // 23kHz is above the 22.05kHz Nyquist frequency of the copy, so it would
+    // alias down to 21.1kHz if it wasn't filtered out
+    writeSine(sourceFile.getFile(), 23000.0f);
+    ASSERT_TRUE(internal_plugins::ResampledSampleCache::convertFile(
+        sourceFile.getFile(), destFile.getFile(), 44100.0));
+
+    const auto buffer = readDestFile();
+    ASSERT_EQ(buffer.getNumSamples(), 44100);
+    EXPECT_LT(buffer.getMagnitude(0, 1000, 42000), 0.001f);
+}
+
+TEST_F(ResampledSampleCacheTest, copyIsMadeInTheBackgroundAndThenUsed) {
+    internal_plugins::ResampledSampleCache cache;
+    const auto cacheDirectory =
+        juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getNonexistentChildFile("sample_cache", "");
+    cache.setDirectory(cacheDirectory);
+
+    // The original is used until the copy has been made
+    EXPECT_EQ(cache.getFileForSampleRate(sourceFile.getFile(),
+                                         sourceSampleRate, 44100.0),
+              sourceFile.getFile());
+
+    for (int i = 0; i < 500 && cache.isConverting(); i++)
+        juce::Thread::sleep(10);
+    ASSERT_FALSE(cache.isConverting());
+
+    const auto copy = cache.getFileForSampleRate(sourceFile.getFile(),
+                                                 sourceSampleRate, 44100.0);
+    EXPECT_NE(copy, sourceFile.getFile());
+    EXPECT_TRUE(copy.existsAsFile());
+    EXPECT_TRUE(copy.isAChildOf(cacheDirectory));
+
+    cacheDirectory.deleteRecursively();
+}
+
+TEST_F(ResampledSampleCacheTest, matchingSampleRateUsesOriginalFile) {
+    internal_plugins::ResampledSampleCache cache;
+    juce::TemporaryFile cacheDirectory;
+    cache.setDirectory(cacheDirectory.getFile());
+
+    EXPECT_EQ(cache.getFileForSampleRate(sourceFile.getFile(),
+                                         sourceSampleRate, sourceSampleRate),
+              sourceFile.getFile());
+    EXPECT_FALSE(cache.isConverting());
+}
+
+} // namespace InternalPluginsTests